@@ -136,6 +136,10 @@ extern "C"
 
   /*! @brief Invoked on the main thread when the tempo of the Link
    *  session changes.
+   *
+   *  @discussion Tempo, peer count and start/stop changes are
+   *  coalesced: changes arriving before the main thread gets to them
+   *  are delivered once, with the latest value.
    */
   void ABLLinkSetSessionTempoCallback(
     ABLLinkRef,
@@ -144,6 +148,8 @@ extern "C"
 
   /*! @brief Invoked on the main thread when the Start/stop state of
    *  the Link session changes.
+   *
+   *  @discussion Coalesced like the session tempo callback.
    */
   void ABLLinkSetStartStopCallback(
     ABLLinkRef,
@@ -174,6 +180,41 @@ extern "C"
     ABLLinkIsConnectedCallback callback,
     void* context);
 
+  /*! @brief Session events reported by ABLLinkPollEvents. */
+  typedef enum
+  {
+    ABLLinkEventTempo = 1 << 0,
+    ABLLinkEventNumPeers = 1 << 1,
+    ABLLinkEventIsPlaying = 1 << 2
+  } ABLLinkEventFlags;
+
+  /*! @brief The latest session values and which of them changed.
+   *
+   *  @discussion changes is a combination of ABLLinkEventFlags. All
+   *  values are current, whether they changed or not.
+   */
+  typedef struct
+  {
+    uint32_t changes;
+    double tempo;
+    uint64_t numPeers;
+    bool isPlaying;
+  } ABLLinkEvents;
+
+  /*! @brief Poll for changes of tempo, number of peers and start/stop
+   *  state since the previous poll.
+   *
+   *  @return Whether anything changed.
+   *
+   *  @discussion This function is lockfree and may be called from any
+   *  thread, e.g. once per render cycle or from a UI timer, but only
+   *  from one thread at a time. Events are coalesced: however often a
+   *  value changed between two polls, only its latest value is
+   *  reported. Polling is independent of the callbacks, both see every
+   *  change.
+   */
+  bool ABLLinkPollEvents(ABLLinkRef, ABLLinkEvents* events);
+
   /*! @brief A reference to a representation of Link's session state.
    *
    *  @discussion A session state represents a timeline and the start/stop
@@ -237,6 +278,36 @@ extern "C"
    */
   void ABLLinkCommitAppSessionState(ABLLinkRef, ABLLinkSessionStateRef);
 
+  /*! @brief Create a session state owned by the caller.
+   *
+   *  @discussion The captured session states returned above are owned
+   *  by the ABLLink, so each capture overwrites the previous one. When
+   *  several threads work on the same render cycle, e.g. a pool of
+   *  threads rendering one bus each, every thread needs a session state
+   *  of its own. Create one per thread up front, this allocates and must
+   *  not be called from a real-time thread. The new session state holds
+   *  the current app session state.
+   */
+  ABLLinkSessionStateRef ABLLinkSessionStateNew(ABLLinkRef);
+
+  /*! @brief Destroy a session state created by ABLLinkSessionStateNew. */
+  void ABLLinkSessionStateDelete(ABLLinkSessionStateRef);
+
+  /*! @brief Copy a session state into another one.
+   *
+   *  @discussion This function is lockfree and may be called from any
+   *  thread. Capture the audio session state once per render cycle on
+   *  the audio thread and copy it into the session state of each
+   *  thread rendering that cycle. Any number of threads may copy from
+   *  the same captured session state at once, as long as none of them
+   *  modifies it. Each thread may then query and modify its own copy
+   *  independently. Only the audio thread may commit a copy, using
+   *  ABLLinkCommitAudioSessionState.
+   */
+  void ABLLinkSessionStateCopy(
+    ABLLinkSessionStateRef destination,
+    ABLLinkSessionStateRef source);
+
 
   /*! @section ABLLinkSessionState functions
    *
@@ -314,6 +385,132 @@ extern "C"
     uint64_t hostTimeAtOutput,
     double quantum);
 
+  /*! @brief The session timeline across one audio buffer.
+   *
+   *  @discussion Built by ABLLinkBufferTimelineMake once per audio
+   *  callback. The tempo of a session state doesn't change while it is
+   *  captured, so beats, phase and host time of any frame in the buffer
+   *  follow from the values at its first frame with a multiply-add. The
+   *  fields are precomputed by ABLLinkBufferTimelineMake and shouldn't be
+   *  changed.
+   */
+  typedef struct
+  {
+    double beatsAtBufferBegin;
+    double phaseAtBufferBegin;
+    double beatsPerFrame;
+    double quantum;
+    uint64_t hostTimeAtBufferBegin;
+    double hostTicksPerFrame;
+  } ABLLinkBufferTimeline;
+
+  /*! @brief Evaluate the session timeline for an audio buffer.
+   *
+   *  @param sessionState The current Link session state.
+   *  @param hostTimeAtBufferBegin Host time at the start of the buffer.
+   *  @param sampleRate Sample rate of the buffer.
+   *  @param quantum Quantum value for beat and phase mapping.
+   *
+   *  @discussion Converts the host time and evaluates the session state
+   *  once. The timeline stays valid for the lifetime of the session state
+   *  it was made from, and must be made again after the tempo changes. This
+   *  function is lockfree and doesn't allocate.
+   */
+  ABLLinkBufferTimeline ABLLinkBufferTimelineMake(
+    ABLLinkSessionStateRef sessionState,
+    uint64_t hostTimeAtBufferBegin,
+    double sampleRate,
+    double quantum);
+
+  /*! @brief Get the beat value at a frame of the buffer.
+   *
+   *  @discussion Equal to ABLLinkBeatAtTime at the host time of the frame,
+   *  up to the microsecond resolution of Link's timeline.
+   */
+  double ABLLinkBufferTimelineBeatAtFrame(const ABLLinkBufferTimeline*, uint32_t frame);
+
+  /*! @brief Get the phase at a frame of the buffer.
+   *
+   *  @discussion The returned value is in the range [0, quantum).
+   */
+  double ABLLinkBufferTimelinePhaseAtFrame(const ABLLinkBufferTimeline*, uint32_t frame);
+
+  /*! @brief Get the host time at a frame of the buffer, rounded to the
+   *  nearest tick.
+   */
+  uint64_t ABLLinkBufferTimelineHostTimeAtFrame(const ABLLinkBufferTimeline*, uint32_t frame);
+
+  /*! @brief Get the fractional frame at which the timeline reaches a beat.
+   *
+   *  @discussion The inverse of ABLLinkBufferTimelineBeatAtFrame. The
+   *  result may lie outside the buffer.
+   */
+  double ABLLinkBufferTimelineFrameAtBeat(const ABLLinkBufferTimeline*, double beatTime);
+
+  /*! @brief Kinds of crossings reported by ABLLinkBufferTimelineGetGridEvents.
+   *
+   *  @discussion An event carries every flag that applies, so a quantum
+   *  boundary on a whole beat is also a beat and a subdivision.
+   *
+   *  @constant ABLLinkGridSubdivision A subdivision of a beat.
+   *  @constant ABLLinkGridBeat A whole beat.
+   *  @constant ABLLinkGridQuantum A multiple of the quantum, where the phase
+   *  is zero.
+   *  @constant ABLLinkGridTransportStart The transport starts playing.
+   *  @constant ABLLinkGridTransportStop The transport stops playing.
+   */
+  typedef enum
+  {
+    ABLLinkGridSubdivision = 1 << 0,
+    ABLLinkGridBeat = 1 << 1,
+    ABLLinkGridQuantum = 1 << 2,
+    ABLLinkGridTransportStart = 1 << 3,
+    ABLLinkGridTransportStop = 1 << 4
+  } ABLLinkGridEventFlags;
+
+  /*! @brief A frame at which the beat grid or the transport is crossed.
+   *
+   *  @discussion frame is the first frame at or after the crossing. flags
+   *  is a combination of ABLLinkGridEventFlags. beats is the beat value of
+   *  the grid line, or the beat at the transport change for events that are
+   *  only a transport change.
+   */
+  typedef struct
+  {
+    uint32_t frame;
+    uint32_t flags;
+    double beats;
+  } ABLLinkGridEvent;
+
+  /*! @brief Get the frames of a buffer at which beats, subdivisions,
+   *  quantum boundaries and transport changes fall.
+   *
+   *  @param timeline The timeline of the buffer.
+   *  @param sessionState The session state the timeline was made from.
+   *  @param numFrames Number of frames in the buffer.
+   *  @param subdivisionsPerBeat Number of subdivisions per beat, 1 for
+   *  whole beats only.
+   *  @param events Array receiving the events in frame order.
+   *  @param maxNumEvents Capacity of the events array. Further events are
+   *  dropped.
+   *  @return Number of events written.
+   *
+   *  @discussion Replaces evaluating the timeline for every frame to find
+   *  where the beat or phase wraps. Each crossing is reported in exactly
+   *  one of consecutive buffers, at most one event is reported per frame.
+   *  Transport changes are taken from ABLLinkIsPlaying and
+   *  ABLLinkTimeForIsPlaying. The cost depends on the number of events, not
+   *  on the number of frames. This function is lockfree and doesn't
+   *  allocate.
+   */
+  uint32_t ABLLinkBufferTimelineGetGridEvents(
+    const ABLLinkBufferTimeline *timeline,
+    ABLLinkSessionStateRef sessionState,
+    uint32_t numFrames,
+    uint32_t subdivisionsPerBeat,
+    ABLLinkGridEvent *events,
+    uint32_t maxNumEvents);
+
   /*! @brief: Attempt to map the given beat time to the given host
    *  time in the context of the given quantum.
    *
@@ -548,11 +745,399 @@ extern "C"
    *
    *  @discussion This is a convenience function for iOS/macOS to configure
    *  the audio sink with the properties from a Core Audio format description.
+   *  Supported linear PCM formats are signed and unsigned 16 and 32-bit
+   *  integers, packed and 4-byte aligned 24-bit integers, 8.24 fixed point,
+   *  32 and 64-bit floats, and big endian 16 and 32-bit integers and 32-bit
+   *  floats. Buffers in other formats are not sent. The sink grows to hold
+   *  the converted buffers, see ABLLinkAudioSinkSetMaxNumFrames.
    */
   void ABLLinkSetPropertiesFromASBD(
       ABLLinkAudioSinkRef,
       const AudioStreamBasicDescription *asbd);
 
+  /*! @brief Set the largest buffer the host renders.
+   *
+   *  @param maxNumFrames Largest number of frames per buffer committed with
+   *  ABLLinkCommitCoreAudioBufferWithBeats and
+   *  ABLLinkCommitCoreAudioBufferWithHostTime, usually the
+   *  kAudioUnitProperty_MaximumFramesPerSlice of the audio unit. The
+   *  default is 4096.
+   *
+   *  @discussion The sink requests room for twice as many samples as such a
+   *  buffer holds after the channel map and sample rate conversion, and
+   *  grows again whenever the format, channel map or sample rate changes.
+   *  This happens on the calling thread, so committing buffers never has to
+   *  grow the sink. A buffer that doesn't fit anyway is dropped, and the
+   *  sink grows for the following ones. Like ABLLinkSetPropertiesFromASBD,
+   *  this function must not be called concurrently with committing buffers.
+   */
+  void ABLLinkAudioSinkSetMaxNumFrames(
+      ABLLinkAudioSinkRef,
+      uint32_t maxNumFrames);
+
+  /*! @brief Select the input channels sent by an audio sink.
+   *
+   *  @param inputChannels Index of the input channel to send for each
+   *  output channel.
+   *  @param numOutputChannels Number of channels sent, 1 for mono or 2
+   *  for stereo.
+   *  @return False if the selection is invalid.
+   *
+   *  @discussion By default mono formats are sent as mono and formats with
+   *  two or more channels send their first two channels as stereo. The
+   *  selection is applied while converting buffers in
+   *  ABLLinkCommitCoreAudioBufferWithBeats and
+   *  ABLLinkCommitCoreAudioBufferWithHostTime. If the format configured with
+   *  ABLLinkSetPropertiesFromASBD has fewer channels than the selection
+   *  refers to, the default is used. Like ABLLinkSetPropertiesFromASBD, this
+   *  function must not be called concurrently with committing buffers.
+   */
+  bool ABLLinkAudioSinkSetChannelSelection(
+      ABLLinkAudioSinkRef,
+      const uint32_t *inputChannels,
+      uint32_t numOutputChannels);
+
+  /*! @brief Downmix the input channels sent by an audio sink.
+   *
+   *  @param gains Row-major gain matrix with numOutputChannels rows of
+   *  numInputChannels gains, i.e. the gain of input i in output o is
+   *  gains[o * numInputChannels + i].
+   *  @param numInputChannels Number of input channels, at most 64.
+   *  @param numOutputChannels Number of channels sent, 1 for mono or 2
+   *  for stereo.
+   *  @return False if the matrix dimensions are invalid.
+   *
+   *  @discussion Each sent channel is the weighted sum of the input
+   *  channels, computed in the same pass that converts the buffer to
+   *  16-bit samples. The restrictions of
+   *  ABLLinkAudioSinkSetChannelSelection apply.
+   */
+  bool ABLLinkAudioSinkSetChannelMatrix(
+      ABLLinkAudioSinkRef,
+      const float *gains,
+      uint32_t numInputChannels,
+      uint32_t numOutputChannels);
+
+  /*! @brief Restore the default channel selection of an audio sink.
+   *
+   *  @discussion Must not be called concurrently with committing buffers.
+   */
+  void ABLLinkAudioSinkResetChannelMap(ABLLinkAudioSinkRef);
+
+  /*! @brief How an audio sink reduces samples to 16 bits.
+   *
+   *  @constant ABLLinkAudioConversionTruncate Truncate towards zero. This is
+   *  the default.
+   *  @constant ABLLinkAudioConversionRound Round to the nearest value.
+   *  @constant ABLLinkAudioConversionDither Add triangular dither with a peak
+   *  amplitude of one LSB before rounding.
+   *  @constant ABLLinkAudioConversionShapedDither Like
+   *  ABLLinkAudioConversionDither with high-pass filtered dither noise.
+   */
+  typedef enum
+  {
+    ABLLinkAudioConversionTruncate = 0,
+    ABLLinkAudioConversionRound,
+    ABLLinkAudioConversionDither,
+    ABLLinkAudioConversionShapedDither
+  } ABLLinkAudioConversionMode;
+
+  /*! @brief Set how an audio sink converts samples to 16 bits.
+   *
+   *  @discussion Rounding and dither apply to formats wider than 16 bits and
+   *  to downmixed channels. Dither is computed in the same pass that converts
+   *  the buffer, its generator state is kept per sink. Must not be called
+   *  concurrently with committing buffers.
+   */
+  void ABLLinkAudioSinkSetConversionMode(
+      ABLLinkAudioSinkRef,
+      ABLLinkAudioConversionMode mode);
+
+  /*! @brief Shape of the transition to a new audio sink gain.
+   *
+   *  @constant ABLLinkAudioGainRampLinear The gain changes by the same
+   *  amount every frame.
+   *  @constant ABLLinkAudioGainRampExponential The gain changes by the same
+   *  ratio every frame, i.e. linearly in dB. Ramps from or to silence start
+   *  or end at -80 dB. Ramps between gains of opposite sign are linear.
+   */
+  typedef enum
+  {
+    ABLLinkAudioGainRampLinear = 0,
+    ABLLinkAudioGainRampExponential
+  } ABLLinkAudioGainRamp;
+
+  /*! @brief Set the gain applied to the audio sent by a sink.
+   *
+   *  @param gain Linear gain, 1 leaves the audio unchanged.
+   *  @param rampFrames Number of frames to reach the new gain. Zero
+   *  applies the gain immediately.
+   *  @param ramp Shape of the transition.
+   *
+   *  @discussion The gain is applied while converting buffers in
+   *  ABLLinkCommitCoreAudioBufferWithBeats and
+   *  ABLLinkCommitCoreAudioBufferWithHostTime, the committed AudioBufferList
+   *  is not modified. A new target starts ramping from the current gain at
+   *  the next commit. This function is lockfree and may be called from any
+   *  thread.
+   */
+  void ABLLinkAudioSinkSetGain(
+      ABLLinkAudioSinkRef,
+      float gain,
+      uint32_t rampFrames,
+      ABLLinkAudioGainRamp ramp);
+
+  /*! @brief Set the sample rate an audio sink sends at.
+   *
+   *  @param sampleRate Sample rate in Hz, or zero to send at the rate
+   *  configured with ABLLinkSetPropertiesFromASBD.
+   *  @return False if the sink can't convert from the configured rate to the
+   *  requested rate. The sink then sends at the configured rate.
+   *
+   *  @discussion Buffers committed with ABLLinkCommitCoreAudioBufferWithBeats
+   *  and ABLLinkCommitCoreAudioBufferWithHostTime are lowpass filtered and
+   *  resampled while converting them. Only rates up to the configured rate
+   *  are supported. The number of frames sent per buffer varies, and the
+   *  committed beat time accounts for the 16 frame delay of the filter, so
+   *  the audio stays aligned to the beat. The requested rate is kept when
+   *  the format changes. Must not be called concurrently with committing
+   *  buffers.
+   */
+  bool ABLLinkAudioSinkSetSampleRate(
+      ABLLinkAudioSinkRef,
+      uint32_t sampleRate);
+
+  /*! @brief Levels of the audio sent by a sink.
+   *
+   *  @field numChannels Number of channels sent, 1 or 2.
+   *  @field numFrames Number of frames metered since the previous call of
+   *  ABLLinkAudioSinkGetMeters.
+   *  @field peak Largest sample magnitude per channel, 1 is full scale.
+   *  @field rms Root mean square level per channel, 1 is full scale.
+   *  @field numClippedSamples Number of samples per channel that reached the
+   *  positive or negative limit of the 16-bit range.
+   */
+  typedef struct
+  {
+    uint32_t numChannels;
+    uint64_t numFrames;
+    float peak[2];
+    float rms[2];
+    uint64_t numClippedSamples[2];
+  } ABLLinkAudioSinkMeters;
+
+  /*! @brief Enable or disable metering of the audio sent by a sink.
+   *
+   *  @discussion Metering is disabled by default. While enabled, buffers
+   *  committed with ABLLinkCommitCoreAudioBufferWithBeats and
+   *  ABLLinkCommitCoreAudioBufferWithHostTime are metered after the channel
+   *  map, gain and sample rate conversion, in the same call that converts
+   *  them. Buffers are only converted, and thus metered, while a peer
+   *  receives audio from the sink. This function is lockfree and may be
+   *  called from any thread.
+   */
+  void ABLLinkAudioSinkSetMetersEnabled(
+      ABLLinkAudioSinkRef,
+      bool enabled);
+
+  /*! @brief Read the levels of the audio sent by a sink.
+   *
+   *  @param meters Receives the levels of the frames sent since the previous
+   *  call.
+   *  @return False if no frames were metered since the previous call.
+   *
+   *  @discussion Intended to be polled from a UI thread. Peaks are reset by
+   *  each call. This function is lockfree and wait-free, it never blocks the
+   *  audio thread, but must not be called concurrently with itself for the
+   *  same sink.
+   */
+  bool ABLLinkAudioSinkGetMeters(
+      ABLLinkAudioSinkRef,
+      ABLLinkAudioSinkMeters *meters);
+
+  /*! @brief What became of the buffers committed to a sink.
+   *
+   *  @field numCommittedBuffers Buffers committed to Link.
+   *  @field numFramesSent Frames in the committed buffers, after sample
+   *  rate conversion.
+   *  @field numBytesSent Bytes of 16-bit samples in the committed buffers.
+   *  @field numFailedCommits Buffers Link refused to commit.
+   *  @field numUnavailableBuffers Attempts to retain a buffer that returned
+   *  an invalid handle, either because no peer receives audio from the sink
+   *  or because no buffer was available. Link doesn't report which.
+   *  @field numUnsupportedFormatBuffers Buffers dropped because the sink
+   *  has no conversion for the format set with ABLLinkSetPropertiesFromASBD,
+   *  or because they held fewer channels than the format describes.
+   *  @field numOversizedBuffers Buffers dropped because they held more
+   *  samples after conversion than ABLLinkAudioSinkMaxNumSamples.
+   *  @field numGatedBuffers Buffers suppressed by the silence gate.
+   *  @field numBuffersWithoutOutput Buffers too short to yield a frame after
+   *  sample rate conversion. Their input isn't lost, it goes into the frames
+   *  of the next buffer.
+   *
+   *  @discussion All values are totals since the sink was created. Subtract
+   *  an earlier reading to get the counts of an interval. The buffer counts
+   *  tell why the ABLLinkCommitCoreAudioBuffer functions returned false.
+   *  Buffers committed directly with ABLLinkAudioReleaseAndCommitBuffer
+   *  are counted as well.
+   */
+  typedef struct
+  {
+    uint64_t numCommittedBuffers;
+    uint64_t numFramesSent;
+    uint64_t numBytesSent;
+    uint64_t numFailedCommits;
+    uint64_t numUnavailableBuffers;
+    uint64_t numUnsupportedFormatBuffers;
+    uint64_t numOversizedBuffers;
+    uint64_t numGatedBuffers;
+    uint64_t numBuffersWithoutOutput;
+  } ABLLinkAudioSinkStats;
+
+  /*! @brief Read what became of the buffers committed to a sink.
+   *
+   *  @discussion This function is lockfree, it never blocks the audio
+   *  thread, and may be called from any number of threads at once. A buffer
+   *  committed meanwhile may be missing from some of the totals.
+   */
+  void ABLLinkAudioSinkGetStats(
+      ABLLinkAudioSinkRef,
+      ABLLinkAudioSinkStats *stats);
+
+  /*! @brief Number of buckets of an ABLLinkTimingHistogram. */
+  enum { ABLLinkTimingNumBuckets = 32 };
+
+  /*! @brief Distribution of the durations of a LinkKit call.
+   *
+   *  @field counts Number of calls per duration. Bucket 0 counts calls
+   *  under 1 ns, bucket i calls taking from 2^(i-1) up to 2^i ns and the
+   *  last bucket all longer calls.
+   *  @field count Number of calls recorded.
+   *  @field totalNanoseconds Sum of the durations of all calls.
+   *  @field maxNanoseconds Duration of the longest call.
+   *
+   *  @discussion All values are totals since the histogram was created.
+   *  Subtract an earlier snapshot to get the distribution of an interval.
+   */
+  typedef struct
+  {
+    uint64_t counts[ABLLinkTimingNumBuckets];
+    uint64_t count;
+    uint64_t totalNanoseconds;
+    uint64_t maxNanoseconds;
+  } ABLLinkTimingHistogram;
+
+  /*! @brief Estimate a percentile of a timing histogram.
+   *
+   *  @param quantile Fraction of the calls, e.g. 0.99 for the 99th
+   *  percentile.
+   *  @return Duration in nanoseconds that the given fraction of the calls
+   *  didn't exceed. It is the upper end of the bucket the percentile falls
+   *  into, so it is accurate to within a factor of two. It is never more
+   *  than maxNanoseconds. Zero if no calls were recorded.
+   */
+  uint64_t ABLLinkTimingHistogramQuantile(
+      const ABLLinkTimingHistogram *histogram,
+      double quantile);
+
+  /*! @brief Durations of the audio thread calls of an ABLLink. */
+  typedef struct
+  {
+    ABLLinkTimingHistogram captureAudioSessionState;
+    ABLLinkTimingHistogram commitAudioSessionState;
+  } ABLLinkTimings;
+
+  /*! @brief Enable or disable timing the audio thread calls of an
+   *  ABLLink.
+   *
+   *  @discussion Timing is disabled by default. While enabled, each call of
+   *  ABLLinkCaptureAudioSessionState and ABLLinkCommitAudioSessionState is
+   *  timed and recorded, at the cost of reading the clock twice. This
+   *  function is lockfree and may be called from any thread.
+   */
+  void ABLLinkSetTimingEnabled(ABLLinkRef, bool enabled);
+
+  /*! @brief Read the durations of the audio thread calls of an ABLLink.
+   *
+   *  @discussion This function is lockfree, it never blocks the audio
+   *  thread, and may be called from any number of threads at once. A call
+   *  recorded meanwhile may be missing from some of the totals.
+   */
+  void ABLLinkGetTimings(ABLLinkRef, ABLLinkTimings *timings);
+
+  /*! @brief Durations of the audio thread work of a sink.
+   *
+   *  @field conversion Converting buffers committed with the
+   *  ABLLinkCommitCoreAudioBuffer functions into the sent format.
+   *  @field commit ABLLinkAudioReleaseAndCommitBuffer, whether called
+   *  directly or by the ABLLinkCommitCoreAudioBuffer functions.
+   */
+  typedef struct
+  {
+    ABLLinkTimingHistogram conversion;
+    ABLLinkTimingHistogram commit;
+  } ABLLinkAudioSinkTimings;
+
+  /*! @brief Enable or disable timing the audio thread work of a sink.
+   *
+   *  @discussion Timing is disabled by default. This function is lockfree
+   *  and may be called from any thread.
+   */
+  void ABLLinkAudioSinkSetTimingEnabled(
+      ABLLinkAudioSinkRef,
+      bool enabled);
+
+  /*! @brief Read the durations of the audio thread work of a sink.
+   *
+   *  @discussion This function is lockfree, it never blocks the audio
+   *  thread, and may be called from any number of threads at once.
+   */
+  void ABLLinkAudioSinkGetTimings(
+      ABLLinkAudioSinkRef,
+      ABLLinkAudioSinkTimings *timings);
+
+  /*! @brief What an audio sink does with silent input.
+   *
+   *  @constant ABLLinkAudioSilenceGateOff Every buffer is converted and
+   *  sent.
+   *  @constant ABLLinkAudioSilenceGateSuppress Gated buffers aren't sent.
+   *  Receivers see a gap in the stream.
+   *  @constant ABLLinkAudioSilenceGateSendSilence Gated buffers are sent as
+   *  zeros without converting them, receivers keep getting a continuous
+   *  stream.
+   */
+  typedef enum
+  {
+    ABLLinkAudioSilenceGateOff = 0,
+    ABLLinkAudioSilenceGateSuppress,
+    ABLLinkAudioSilenceGateSendSilence
+  } ABLLinkAudioSilenceGateMode;
+
+  /*! @brief Skip converting buffers while the input of an audio sink is
+   *  silent.
+   *
+   *  @param threshold Largest linear sample magnitude considered silent, 1
+   *  is full scale. Magnitudes below one 16-bit step are treated as zero.
+   *  @param holdFrames Number of silent frames to keep sending normally
+   *  before the gate closes, so that decaying tails aren't cut off.
+   *  @param mode What to do with gated buffers.
+   *
+   *  @discussion The gate is off by default. Buffers committed with
+   *  ABLLinkCommitCoreAudioBufferWithBeats and
+   *  ABLLinkCommitCoreAudioBufferWithHostTime are checked before the channel
+   *  map and gain are applied, and only the input channels the sink reads
+   *  are considered. The check stops at the first sample above the
+   *  threshold, and the first buffer that isn't silent reopens the gate.
+   *  Suppressed buffers aren't committed, and the commit returns false.
+   *  Gated buffers aren't metered. This function is lockfree and may be
+   *  called from any thread.
+   */
+  void ABLLinkAudioSinkSetSilenceGate(
+      ABLLinkAudioSinkRef,
+      float threshold,
+      uint32_t holdFrames,
+      ABLLinkAudioSilenceGateMode mode);
+
   /*! @brief Convenience function to commit a Core Audio buffer using beat time.
    *
    *  @param sink The audio sink to commit the buffer to.
@@ -561,7 +1146,8 @@ extern "C"
    *  @param quantum Quantum value for beat mapping.
    *  @param numFrames Number of frames in the buffer.
    *  @param ioData Pointer to the AudioBufferList containing the audio data.
-   *  @return True if the buffer was successfully committed.
+   *  @return True if the buffer was successfully committed. Use
+   *  ABLLinkAudioSinkGetStats to find out why buffers weren't.
    *
    *  @discussion This is a convenience function for iOS/macOS that directly
    *  commits audio data from a Core Audio AudioBufferList. The Link session
@@ -599,6 +1185,147 @@ extern "C"
       uint32_t numFrames,
       AudioBufferList *ioData);
 
+  /*! @brief Commit Core Audio buffers to several sinks at once.
+   *
+   *  @param sinks The audio sinks to commit the buffers to.
+   *  @param bufferLists The buffer to commit to each sink, in the same order
+   *  as the sinks.
+   *  @param count Number of sinks, at most 64.
+   *  @param sessionState The current Link session state.
+   *  @param hostTimeAtBufferBegin Host time at the start of the buffers.
+   *  @param quantum Quantum value for beat mapping.
+   *  @param numFrames Number of frames in each buffer.
+   *  @return A bitmap with bit i set if the buffer of sink i was
+   *  successfully committed.
+   *
+   *  @discussion Equivalent to calling
+   *  ABLLinkCommitCoreAudioBufferWithHostTime for every sink, but the beat at
+   *  the start of the buffers is computed once and the sinks are converted
+   *  back to back. Sinks beyond the first 64 aren't committed. This function
+   *  is lockfree.
+   */
+  uint64_t ABLLinkCommitCoreAudioBuffers(
+      const ABLLinkAudioSinkRef *sinks,
+      AudioBufferList *const *bufferLists,
+      uint32_t count,
+      ABLLinkSessionStateRef sessionState,
+      uint64_t hostTimeAtBufferBegin,
+      double quantum,
+      uint32_t numFrames);
+
+  /*! @brief Convenience function to commit a Core Audio buffer using a
+   *  buffer timeline.
+   *
+   *  @param sink The audio sink to commit the buffer to.
+   *  @param sessionState The session state the timeline was made from.
+   *  @param timeline The timeline of the buffer.
+   *  @param numFrames Number of frames in the buffer.
+   *  @param ioData Pointer to the AudioBufferList containing the audio data.
+   *  @return True if the buffer was successfully committed.
+   *
+   *  @discussion Equivalent to ABLLinkCommitCoreAudioBufferWithBeats with
+   *  the beat and quantum of the timeline. This function is lockfree.
+   */
+  bool ABLLinkCommitCoreAudioBufferWithTimeline(
+      ABLLinkAudioSinkRef sink,
+      ABLLinkSessionStateRef sessionState,
+      const ABLLinkBufferTimeline *timeline,
+      uint32_t numFrames,
+      AudioBufferList *ioData);
+
+
+  /*! @brief Reference to an audio source instance.
+   *
+   *  @discussion An audio source subscribes to an audio channel of another
+   *  peer and plays the received audio into Core Audio buffers.
+   */
+  typedef struct ABLLinkAudioSource *ABLLinkAudioSourceRef;
+
+  /*! @brief Create a new audio source receiving a channel of another peer.
+   *
+   *  @param peerName The name of the peer announcing the channel.
+   *  @param channelName The name of the channel.
+   *  @param maxNumFrames Largest number of frames per received buffer.
+   *  Larger buffers are dropped.
+   *  @return The audio source, or NULL if no peer in the session currently
+   *  announces the channel.
+   *
+   *  @discussion Received buffers are copied into a queue allocated here, so
+   *  neither receiving nor rendering allocates. Up to 32 buffers are queued,
+   *  further buffers are dropped until ABLLinkAudioSourceRender catches up.
+   */
+  ABLLinkAudioSourceRef ABLLinkAudioSourceNew(
+    ABLLinkRef,
+    const char *peerName,
+    const char *channelName,
+    uint32_t maxNumFrames);
+
+  /*! @brief Destroy an audio source and cleanup its associated resources.
+   *
+   *  @discussion Must not be called concurrently with
+   *  ABLLinkAudioSourceRender.
+   */
+  void ABLLinkAudioSourceDelete(ABLLinkAudioSourceRef);
+
+  /*! @brief Set the format ABLLinkAudioSourceRender writes.
+   *
+   *  @return False if received audio can't be played into the format.
+   *
+   *  @discussion Float and 32-bit signed integer linear PCM with one or two
+   *  channels are supported. Mono channels are played into both channels of
+   *  a non-interleaved stereo format. The sample rate of the format is
+   *  assumed to match the received audio. Must not be called concurrently
+   *  with ABLLinkAudioSourceRender.
+   */
+  bool ABLLinkAudioSourceSetPropertiesFromASBD(
+    ABLLinkAudioSourceRef,
+    const AudioStreamBasicDescription *asbd);
+
+  /*! @brief Set the delay between the beat received audio was sent at and
+   *  the beat it is played at.
+   *
+   *  @param numFrames The delay in frames, 2048 by default.
+   *
+   *  @discussion The latency has to cover the network and the buffering of
+   *  the sender, otherwise received frames arrive late and are skipped. This
+   *  function is lockfree and may be called from any thread.
+   */
+  void ABLLinkAudioSourceSetLatency(ABLLinkAudioSourceRef, uint32_t numFrames);
+
+  /*! @brief Set a linear gain applied to the received audio.
+   *
+   *  @discussion This function is lockfree and may be called from any
+   *  thread.
+   */
+  void ABLLinkAudioSourceSetGain(ABLLinkAudioSourceRef, float gain);
+
+  /*! @brief Play received audio into a Core Audio buffer.
+   *
+   *  @param source The audio source to render.
+   *  @param sessionState The current Link session state.
+   *  @param hostTimeAtBufferBegin Host time at the start of the buffer.
+   *  @param quantum Quantum value for beat mapping.
+   *  @param numFrames Number of frames in the buffer.
+   *  @param ioData Pointer to the AudioBufferList to write to.
+   *  @return The number of received frames played.
+   *
+   *  @discussion Received frames are played at the beat they were sent at
+   *  plus the latency. Small timing differences are absorbed, beyond that
+   *  late frames are skipped and frames without received audio are silent.
+   *  Until ABLLinkAudioSourceSetPropertiesFromASBD succeeds, the whole
+   *  buffer is silenced. Buffers without beat information are played as
+   *  they arrive. The
+   *  session state and quantum must be the same as used for rendering the
+   *  audio locally. This function is lockfree and doesn't allocate.
+   */
+  uint32_t ABLLinkAudioSourceRender(
+      ABLLinkAudioSourceRef source,
+      ABLLinkSessionStateRef sessionState,
+      uint64_t hostTimeAtBufferBegin,
+      double quantum,
+      uint32_t numFrames,
+      AudioBufferList *ioData);
+
 #ifdef __cplusplus
 }
 #endif
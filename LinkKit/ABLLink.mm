@@ -8,7 +8,10 @@
 #include "detail/ABLLinkAggregate.h"
 #include "detail/ABLNotificationView.h"
 #include "detail/ABLSettingsViewController.h"
+#include "detail/BeatGrid.hpp"
 #include "detail/BufferConversion.hpp"
+#include "detail/BufferTimeline.hpp"
+#include "detail/SinkCapacity.hpp"
 
 // C API implementations for buffer conversion functions in ABLLinkUtils.h
 extern "C"
@@ -32,28 +35,110 @@ extern "C"
   int16_t ABLConvertFloat(float input) {
     return ableton::link_kit::ConvertFloat(input);
   }
+
+  ABLLinkCommandQueueRef ABLLinkCommandQueueNew(const uint32_t commandSize, const uint32_t capacity) {
+    return new ABLLinkCommandQueue{{commandSize, capacity}};
+  }
+
+  void ABLLinkCommandQueueDelete(ABLLinkCommandQueueRef queue) {
+    delete queue;
+  }
+
+  bool ABLLinkCommandQueuePush(ABLLinkCommandQueueRef queue, const void* command) {
+    return queue->mImpl.push(command);
+  }
+
+  bool ABLLinkCommandQueuePop(ABLLinkCommandQueueRef queue, void* command) {
+    return queue->mImpl.pop(command);
+  }
+
+  ABLLinkStateSlotRef ABLLinkStateSlotNew(const uint32_t stateSize) {
+    return new ABLLinkStateSlot{ableton::link_kit::TripleBuffer{stateSize}};
+  }
+
+  void ABLLinkStateSlotDelete(ABLLinkStateSlotRef slot) {
+    delete slot;
+  }
+
+  void ABLLinkStateSlotWrite(ABLLinkStateSlotRef slot, const void* state) {
+    slot->mImpl.write(state);
+  }
+
+  bool ABLLinkStateSlotRead(ABLLinkStateSlotRef slot, void* state) {
+    return slot->mImpl.read(state);
+  }
 }
 
 namespace {
 
-// Wrappers that adapt AudioBufferList to the header-only buffer copy functions
-template <typename T>
-void SCopyBuffer(const uint32_t numFrames, AudioBufferList* input, int16_t* output) {
-  T* src = (T*)input->mBuffers[0].mData;
-  ableton::link_kit::CopyBufferMono(numFrames, src, output);
+// Translate the ASBD to the portable format description the kernels are
+// selected by. Formats other than linear PCM get an empty sample layout, which
+// no kernel reads.
+ableton::link_kit::FormatDescriptor MakeFormatDescriptor(const AudioStreamBasicDescription& asbd) {
+  using namespace ableton::link_kit;
+  FormatDescriptor format;
+  const auto flags = asbd.mFormatFlags;
+  format.numChannels = asbd.mChannelsPerFrame;
+  format.isInterleaved = !(flags & kAudioFormatFlagIsNonInterleaved);
+  format.sampleRate = asbd.mSampleRate;
+  if (asbd.mFormatID != kAudioFormatLinearPCM || format.numChannels == 0) {
+    return format;
+  }
+
+  // Samples of non-packed formats are padded to the size of a channel's
+  // share of the frame
+  auto& sample = format.sample;
+  format.bytesPerFrame = asbd.mBytesPerFrame;
+  sample.bitsPerSample = asbd.mBitsPerChannel;
+  sample.bytesPerSample = format.isInterleaved
+    ? asbd.mBytesPerFrame / format.numChannels
+    : asbd.mBytesPerFrame;
+  sample.numFractionBits =
+    (flags & kLinearPCMFormatFlagsSampleFractionMask) >> kLinearPCMFormatFlagsSampleFractionShift;
+  sample.encoding = flags & kAudioFormatFlagIsFloat ? SampleEncoding::Float
+    : flags & kAudioFormatFlagIsSignedInteger ? SampleEncoding::SignedInteger
+    : SampleEncoding::UnsignedInteger;
+  sample.byteOrder = flags & kAudioFormatFlagIsBigEndian ? ByteOrder::BigEndian
+    : ByteOrder::LittleEndian;
+  if (sample.bitsPerSample < 8 * sample.bytesPerSample) {
+    sample.alignment = flags & kAudioFormatFlagIsAlignedHigh ? SampleAlignment::High
+      : SampleAlignment::Low;
+  }
+  return format;
+}
+
+// Pick the channel map, resampler setup and conversion kernel for the current
+// format, instantiated for the widest instruction set supported by the CPU.
+// The CPU is queried once, the audio thread only pays for the indirect call.
+// The sink grows to hold the largest converted buffer before the audio thread
+// commits one.
+void UpdateConversionKernel(ABLLinkAudioSink& sink) {
+  using namespace ableton::link_kit;
+  sink.mConversionKernel = ConfigureConversion(sink.mConversion, BestInstructionSet());
+  sink.mSilenceCheck = SelectSilenceCheck(sink.mConversion, BestInstructionSet());
+  sink.mImpl.requestMaxNumSamples(SinkCapacity(sink.mConversion, sink.mMaxNumFrames));
 }
 
-template <typename T>
-void SCopyBufferStereo(const uint32_t numFrames, AudioBufferList* input, int16_t* output) {
-  T* left = (T*)input->mBuffers[0].mData;
-  T* right = (T*)input->mBuffers[1].mData;
-  ableton::link_kit::CopyBufferStereoNonInterleaved(numFrames, left, right, output);
+// The C timeline holds the same precomputed values
+ableton::link_kit::BufferTimeline ToBufferTimeline(const ABLLinkBufferTimeline& timeline) {
+  return {timeline.beatsAtBufferBegin,
+          timeline.phaseAtBufferBegin,
+          timeline.beatsPerFrame,
+          timeline.quantum,
+          timeline.hostTimeAtBufferBegin,
+          timeline.hostTicksPerFrame};
 }
 
-template <typename T>
-void SCopyBufferStereoInterleaved(const uint32_t numFrames, AudioBufferList* input, int16_t* output) {
-  T* src = (T*)input->mBuffers[0].mData;
-  ableton::link_kit::CopyBufferStereoInterleaved(numFrames, src, output);
+ABLLinkTimingHistogram ToTimingHistogram(
+  const ableton::link_kit::TimingHistogram::Snapshot& snapshot) {
+  static_assert(ABLLinkTimingNumBuckets == ableton::link_kit::TimingHistogram::kNumBuckets,
+    "Timing histograms must have the same buckets");
+  ABLLinkTimingHistogram histogram;
+  std::copy(snapshot.counts.begin(), snapshot.counts.end(), histogram.counts);
+  histogram.count = snapshot.count;
+  histogram.totalNanoseconds = snapshot.totalNanoseconds;
+  histogram.maxNanoseconds = snapshot.maxNanoseconds;
+  return histogram;
 }
 
 }
@@ -72,6 +157,8 @@ extern "C"
           [](bool) { }
         )
       )
+    , mpCallbackEvents(std::make_shared<ableton::link_kit::EventMailbox>(initialBpm))
+    , mPolledEvents(initialBpm)
     , mActive(true)
     , mEnabled(false)
     , mImpl(initialBpm, "")
@@ -83,29 +170,34 @@ extern "C"
     NSString* name = [[NSUserDefaults standardUserDefaults] objectForKey:ABLLinkPeerName];
     mImpl.setPeerName([name UTF8String]);
 
+    // Events are posted for both the callbacks and ABLLinkPollEvents. Only
+    // the first event posted since the previous delivery schedules one, so a
+    // burst of events costs the main queue a single block.
     mImpl.setNumPeersCallback(
       [this] (const std::size_t numPeers) {
-        auto pCallbacks = mpCallbacks;
-        dispatch_async(dispatch_get_main_queue(), ^{
-
-          pCallbacks->mPeerCountCallback(numPeers);
-        });
+        mPolledEvents.postNumPeers(numPeers);
+        if (mpCallbackEvents->postNumPeers(numPeers))
+        {
+          deliverEvents();
+        }
     });
 
     mImpl.setTempoCallback(
       [this] (const double tempo) {
-        auto pCallbacks = mpCallbacks;
-        dispatch_async(dispatch_get_main_queue(), ^{
-          pCallbacks->mTempoCallback(tempo);
-        });
+        mPolledEvents.postTempo(tempo);
+        if (mpCallbackEvents->postTempo(tempo))
+        {
+          deliverEvents();
+        }
     });
 
     mImpl.setStartStopCallback(
       [this] (const bool isStarted) {
-        auto pCallbacks = mpCallbacks;
-        dispatch_async(dispatch_get_main_queue(), ^{
-         pCallbacks->mStartStopCallback(isStarted);
-        });
+        mPolledEvents.postIsPlaying(isStarted);
+        if (mpCallbackEvents->postIsPlaying(isStarted))
+        {
+          deliverEvents();
+        }
     });
 
     const bool linkEnabled = [[NSUserDefaults standardUserDefaults] boolForKey:ABLLinkEnabledKey];
@@ -118,6 +210,29 @@ extern "C"
     mImpl.enableStartStopSync(startStopSyncEnabled);
   }
 
+  // Only the latest value of each changed event is delivered
+  void ABLLink::deliverEvents()
+  {
+    auto pCallbacks = mpCallbacks;
+    auto pEvents = mpCallbackEvents;
+    dispatch_async(dispatch_get_main_queue(), ^{
+      using ableton::link_kit::EventMailbox;
+      const auto events = pEvents->poll();
+      if (events.changes & EventMailbox::kNumPeers)
+      {
+        pCallbacks->mPeerCountCallback(events.numPeers);
+      }
+      if (events.changes & EventMailbox::kTempo)
+      {
+        pCallbacks->mTempoCallback(events.tempo);
+      }
+      if (events.changes & EventMailbox::kIsPlaying)
+      {
+        pCallbacks->mStartStopCallback(events.isPlaying);
+      }
+    });
+  }
+
   void ABLLink::updateEnabled()
   {
     mImpl.enable(mActive && mEnabled);
@@ -153,6 +268,19 @@ extern "C"
   {
   }
 
+  // Received buffers are only valid during the callback, they are copied into
+  // the playout queue on the network thread
+  ABLLinkAudioSource::ABLLinkAudioSource(
+    ABLLink& link, const ableton::ChannelId channelId, const uint32_t maxNumFrames)
+    : mPlayout(32, 2 * maxNumFrames)
+    , mImpl(link.mImpl, channelId,
+        [this](ableton::LinkAudioSource::BufferHandle bufferHandle) {
+          const auto& info = bufferHandle.info;
+          mPlayout.push(info, bufferHandle.samples, info.numFrames, info.numChannels);
+        })
+  {
+  }
+
 
   // ABLLink API
 
@@ -278,8 +406,24 @@ extern "C"
     };
   }
 
+  bool ABLLinkPollEvents(ABLLinkRef ablLink, ABLLinkEvents* events)
+  {
+    using ableton::link_kit::EventMailbox;
+    static_assert(ABLLinkEventTempo == EventMailbox::kTempo
+      && ABLLinkEventNumPeers == EventMailbox::kNumPeers
+      && ABLLinkEventIsPlaying == EventMailbox::kIsPlaying,
+      "Event flags must match EventMailbox changes");
+    const auto polled = ablLink->mPolledEvents.poll();
+    events->changes = polled.changes;
+    events->tempo = polled.tempo;
+    events->numPeers = polled.numPeers;
+    events->isPlaying = polled.isPlaying;
+    return polled.changes != 0;
+  }
+
   ABLLinkSessionStateRef ABLLinkCaptureAudioSessionState(ABLLinkRef ablLink)
   {
+    ableton::link_kit::ScopedTiming timing(ablLink->mCaptureTiming);
     ablLink->mAudioSessionState.mImpl = ablLink->mImpl.captureAudioSessionState();
     ablLink->mAudioSessionState.mClock = ablLink->mImpl.clock();
     return &ablLink->mAudioSessionState;
@@ -287,6 +431,7 @@ extern "C"
 
   void ABLLinkCommitAudioSessionState(ABLLinkRef ablLink, ABLLinkSessionStateRef sessionState)
   {
+    ableton::link_kit::ScopedTiming timing(ablLink->mCommitTiming);
     ablLink->mImpl.commitAudioSessionState(sessionState->mImpl);
   }
 
@@ -302,6 +447,24 @@ extern "C"
     ablLink->mImpl.commitAppSessionState(sessionState->mImpl);
   }
 
+  ABLLinkSessionStateRef ABLLinkSessionStateNew(ABLLinkRef ablLink)
+  {
+    return new ABLLinkSessionState{
+      ablLink->mImpl.captureAppSessionState(), ablLink->mImpl.clock()};
+  }
+
+  void ABLLinkSessionStateDelete(ABLLinkSessionStateRef sessionState)
+  {
+    delete sessionState;
+  }
+
+  void ABLLinkSessionStateCopy(
+    ABLLinkSessionStateRef destination,
+    ABLLinkSessionStateRef source)
+  {
+    *destination = *source;
+  }
+
   double ABLLinkGetTempo(ABLLinkSessionStateRef sessionState)
   {
     return sessionState->mImpl.tempo();
@@ -334,6 +497,77 @@ extern "C"
     return sessionState->mImpl.phaseAtTime(micros, quantum);
   }
 
+  ABLLinkBufferTimeline ABLLinkBufferTimelineMake(
+    ABLLinkSessionStateRef sessionState,
+    const uint64_t hostTimeAtBufferBegin,
+    const double sampleRate,
+    const double quantum)
+  {
+    const auto ticksPerSecond =
+      sessionState->mClock.microsToTicks(std::chrono::microseconds{1000000});
+    const auto timeline = ableton::link_kit::MakeBufferTimeline(
+      ABLLinkBeatAtTime(sessionState, hostTimeAtBufferBegin, quantum),
+      ABLLinkGetTempo(sessionState),
+      hostTimeAtBufferBegin,
+      static_cast<double>(ticksPerSecond),
+      sampleRate,
+      quantum);
+    return {timeline.beatsAtBufferBegin,
+            timeline.phaseAtBufferBegin,
+            timeline.beatsPerFrame,
+            timeline.quantum,
+            timeline.hostTimeAtBufferBegin,
+            timeline.hostTicksPerFrame};
+  }
+
+  double ABLLinkBufferTimelineBeatAtFrame(
+    const ABLLinkBufferTimeline* timeline,
+    const uint32_t frame)
+  {
+    return ToBufferTimeline(*timeline).beatAtFrame(frame);
+  }
+
+  double ABLLinkBufferTimelinePhaseAtFrame(
+    const ABLLinkBufferTimeline* timeline,
+    const uint32_t frame)
+  {
+    return ToBufferTimeline(*timeline).phaseAtFrame(frame);
+  }
+
+  uint64_t ABLLinkBufferTimelineHostTimeAtFrame(
+    const ABLLinkBufferTimeline* timeline,
+    const uint32_t frame)
+  {
+    return ToBufferTimeline(*timeline).hostTimeAtFrame(frame);
+  }
+
+  double ABLLinkBufferTimelineFrameAtBeat(
+    const ABLLinkBufferTimeline* timeline,
+    const double beatTime)
+  {
+    return ToBufferTimeline(*timeline).frameAtBeat(beatTime);
+  }
+
+  uint32_t ABLLinkBufferTimelineGetGridEvents(
+    const ABLLinkBufferTimeline* timeline,
+    ABLLinkSessionStateRef sessionState,
+    const uint32_t numFrames,
+    const uint32_t subdivisionsPerBeat,
+    ABLLinkGridEvent* events,
+    const uint32_t maxNumEvents)
+  {
+    using namespace ableton::link_kit;
+    static_assert(ABLLinkGridSubdivision == kGridSubdivision
+      && ABLLinkGridBeat == kGridBeat
+      && ABLLinkGridQuantum == kGridQuantum
+      && ABLLinkGridTransportStart == kGridTransportStart
+      && ABLLinkGridTransportStop == kGridTransportStop, "Grid event flags have to match");
+    const auto transport =
+      TransportChange{ABLLinkIsPlaying(sessionState), ABLLinkTimeForIsPlaying(sessionState)};
+    return FindGridEvents(ToBufferTimeline(*timeline), numFrames, subdivisionsPerBeat, transport,
+      events, maxNumEvents);
+  }
+
   uint64_t ABLLinkTimeAtBeat(
     ABLLinkSessionStateRef sessionState,
     const double beatTime,
@@ -433,6 +667,10 @@ extern "C"
   ABLLinkAudioSinkBufferHandleRef ABLLinkAudioRetainBuffer(ABLLinkAudioSinkRef sink)
   {
     sink->mBufferHandle.moImpl.emplace(sink->mImpl);
+    if (!*sink->mBufferHandle.moImpl)
+    {
+      sink->mStats.add(ableton::link_kit::SinkStats::kNoBuffer);
+    }
     return &sink->mBufferHandle;
   }
 
@@ -456,8 +694,10 @@ extern "C"
     const uint32_t numChannels,
     const uint32_t sampleRate)
   {
+    ableton::link_kit::ScopedTiming timing(sink->mCommitTiming);
     const auto result =sink->mBufferHandle.moImpl->commit(sessionState->mImpl, beatsAtBufferBegin, quantum, numFrames, numChannels, sampleRate);
     bufferHandle->moImpl.reset();
+    sink->mStats.addCommit(result, numFrames, numChannels);
     return result;
   }
 
@@ -468,76 +708,176 @@ extern "C"
 
   void ABLLinkSetPropertiesFromASBD(ABLLinkAudioSinkRef sink, const AudioStreamBasicDescription *asbd)
   {
-    sink->mASBD = *asbd;
-    sink->mImpl.requestMaxNumSamples(asbd->mChannelsPerFrame * asbd->mFramesPerPacket);
-
-    sink->mBufferCopyFn = nullptr;
-
-    if (sink->mASBD.mFormatID == kAudioFormatLinearPCM) {
-      switch (sink->mASBD.mBitsPerChannel) {
-        case 16: {
-          if (asbd->mFormatFlags & kAudioFormatFlagIsSignedInteger) {
-            if (asbd->mChannelsPerFrame == 1) {
-              sink->mBufferCopyFn = &SCopyBuffer<int16_t>;
-            } else {
-              if (asbd->mFormatFlags & kAudioFormatFlagIsNonInterleaved) {
-                sink->mBufferCopyFn = &SCopyBufferStereo<int16_t>;
-              } else {
-                sink->mBufferCopyFn = &SCopyBufferStereoInterleaved<int16_t>;
-              }
-            }
-          } else {
-            if (asbd->mChannelsPerFrame == 1) {
-                sink->mBufferCopyFn = &SCopyBuffer<uint16_t>;
-            } else {
-              if (asbd->mFormatFlags & kAudioFormatFlagIsNonInterleaved) {
-                sink->mBufferCopyFn = &SCopyBufferStereo<uint16_t>;
-              } else {
-                sink->mBufferCopyFn = &SCopyBufferStereoInterleaved<uint16_t>;
-              }
-            }
-          }
-          break;
-        }
-       case 32: {
-         if (asbd->mFormatFlags & kAudioFormatFlagIsFloat) {
-           if (asbd->mChannelsPerFrame == 1) {
-             sink->mBufferCopyFn = &SCopyBuffer<float>;
-           } else {
-             if (asbd->mFormatFlags & kAudioFormatFlagIsNonInterleaved) {
-               sink->mBufferCopyFn = &SCopyBufferStereo<float>;
-             } else {
-               sink->mBufferCopyFn = &SCopyBufferStereoInterleaved<float>;
-             }
-           }
-         } else if (asbd->mFormatFlags & kAudioFormatFlagIsSignedInteger) {
-            if (asbd->mChannelsPerFrame == 1) {
-              sink->mBufferCopyFn = &SCopyBuffer<int32_t>;
-            } else {
-              if (asbd->mFormatFlags & kAudioFormatFlagIsNonInterleaved) {
-                sink->mBufferCopyFn = &SCopyBufferStereo<int32_t>;
-              } else {
-                sink->mBufferCopyFn = &SCopyBufferStereoInterleaved<int32_t>;
-              }
-            }
-          } else {
-            if (asbd->mChannelsPerFrame == 1) {
-              sink->mBufferCopyFn = &SCopyBuffer<uint32_t>;
-            } else {
-              if (asbd->mFormatFlags & kAudioFormatFlagIsNonInterleaved) {
-                sink->mBufferCopyFn = &SCopyBufferStereo<uint32_t>;
-              } else {
-                sink->mBufferCopyFn = &SCopyBufferStereoInterleaved<uint32_t>;
-              }
-            }
-          }
-          break;
-        }
+    sink->mConversion.format = MakeFormatDescriptor(*asbd);
+    UpdateConversionKernel(*sink);
+  }
+
+  bool ABLLinkAudioSinkSetChannelSelection(
+    ABLLinkAudioSinkRef sink,
+    const uint32_t* inputChannels,
+    const uint32_t numOutputChannels)
+  {
+    const auto map = ableton::link_kit::MakeChannelSelection(inputChannels, numOutputChannels);
+    if (!map) {
+      return false;
+    }
+    sink->mConversion.requestedMap = map;
+    UpdateConversionKernel(*sink);
+    return true;
+  }
+
+  bool ABLLinkAudioSinkSetChannelMatrix(
+    ABLLinkAudioSinkRef sink,
+    const float* gains,
+    const uint32_t numInputChannels,
+    const uint32_t numOutputChannels)
+  {
+    const auto map =
+      ableton::link_kit::MakeChannelMatrix(gains, numInputChannels, numOutputChannels);
+    if (!map) {
+      return false;
+    }
+    sink->mConversion.requestedMap = map;
+    UpdateConversionKernel(*sink);
+    return true;
+  }
+
+  void ABLLinkAudioSinkResetChannelMap(ABLLinkAudioSinkRef sink)
+  {
+    sink->mConversion.requestedMap = std::nullopt;
+    UpdateConversionKernel(*sink);
+  }
+
+  void ABLLinkAudioSinkSetConversionMode(
+    ABLLinkAudioSinkRef sink,
+    const ABLLinkAudioConversionMode mode)
+  {
+    using ableton::link_kit::QuantizationMode;
+    switch (mode) {
+      case ABLLinkAudioConversionRound:
+        sink->mConversion.quantizer = ableton::link_kit::Quantizer{QuantizationMode::Round};
         break;
-        default:
-          break;
-      }
+      case ABLLinkAudioConversionDither:
+        sink->mConversion.quantizer = ableton::link_kit::Quantizer{QuantizationMode::Dither};
+        break;
+      case ABLLinkAudioConversionShapedDither:
+        sink->mConversion.quantizer = ableton::link_kit::Quantizer{QuantizationMode::ShapedDither};
+        break;
+      default:
+        sink->mConversion.quantizer = ableton::link_kit::Quantizer{};
+        break;
+    }
+    UpdateConversionKernel(*sink);
+  }
+
+  void ABLLinkAudioSinkSetGain(
+    ABLLinkAudioSinkRef sink,
+    const float gain,
+    const uint32_t rampFrames,
+    const ABLLinkAudioGainRamp ramp)
+  {
+    using ableton::link_kit::GainRampShape;
+    sink->mConversion.gain.setTarget(gain,
+      rampFrames,
+      ramp == ABLLinkAudioGainRampExponential ? GainRampShape::Exponential
+                                              : GainRampShape::Linear);
+  }
+
+  void ABLLinkAudioSinkSetMaxNumFrames(ABLLinkAudioSinkRef sink, const uint32_t maxNumFrames)
+  {
+    sink->mMaxNumFrames = maxNumFrames;
+    UpdateConversionKernel(*sink);
+  }
+
+  bool ABLLinkAudioSinkSetSampleRate(ABLLinkAudioSinkRef sink, const uint32_t sampleRate)
+  {
+    sink->mConversion.targetSampleRate = sampleRate;
+    UpdateConversionKernel(*sink);
+    const auto& resampler = sink->mConversion.resampler;
+    return sampleRate == 0 || sampleRate == resampler.inputRate() || resampler.isActive();
+  }
+
+  void ABLLinkAudioSinkSetMetersEnabled(ABLLinkAudioSinkRef sink, const bool enabled)
+  {
+    sink->mConversion.meter.setEnabled(enabled);
+  }
+
+  void ABLLinkAudioSinkSetSilenceGate(
+    ABLLinkAudioSinkRef sink,
+    const float threshold,
+    const uint32_t holdFrames,
+    const ABLLinkAudioSilenceGateMode mode)
+  {
+    using ableton::link_kit::SilenceGateMode;
+    const auto gateMode = mode == ABLLinkAudioSilenceGateSuppress ? SilenceGateMode::Suppress
+      : mode == ABLLinkAudioSilenceGateSendSilence ? SilenceGateMode::SendSilence
+      : SilenceGateMode::Off;
+    sink->mConversion.gate.setParameters(threshold, holdFrames, gateMode);
+  }
+
+  bool ABLLinkAudioSinkGetMeters(ABLLinkAudioSinkRef sink, ABLLinkAudioSinkMeters* meters)
+  {
+    const auto levels = sink->mConversion.meter.read();
+    meters->numChannels = levels.numChannels;
+    meters->numFrames = levels.numFrames;
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+      meters->peak[i] = levels.peak[i];
+      meters->rms[i] = levels.rms[i];
+      meters->numClippedSamples[i] = levels.numClippedSamples[i];
     }
+    return levels.numFrames > 0;
+  }
+
+  void ABLLinkSetTimingEnabled(ABLLinkRef ablLink, const bool enabled)
+  {
+    ablLink->mCaptureTiming.setEnabled(enabled);
+    ablLink->mCommitTiming.setEnabled(enabled);
+  }
+
+  void ABLLinkGetTimings(ABLLinkRef ablLink, ABLLinkTimings* timings)
+  {
+    timings->captureAudioSessionState = ToTimingHistogram(ablLink->mCaptureTiming.snapshot());
+    timings->commitAudioSessionState = ToTimingHistogram(ablLink->mCommitTiming.snapshot());
+  }
+
+  void ABLLinkAudioSinkSetTimingEnabled(ABLLinkAudioSinkRef sink, const bool enabled)
+  {
+    sink->mConversionTiming.setEnabled(enabled);
+    sink->mCommitTiming.setEnabled(enabled);
+  }
+
+  void ABLLinkAudioSinkGetTimings(ABLLinkAudioSinkRef sink, ABLLinkAudioSinkTimings* timings)
+  {
+    timings->conversion = ToTimingHistogram(sink->mConversionTiming.snapshot());
+    timings->commit = ToTimingHistogram(sink->mCommitTiming.snapshot());
+  }
+
+  void ABLLinkAudioSinkGetStats(ABLLinkAudioSinkRef sink, ABLLinkAudioSinkStats* stats)
+  {
+    using ableton::link_kit::SinkStats;
+    const auto totals = sink->mStats.totals();
+    stats->numCommittedBuffers = totals[SinkStats::kCommittedBuffers];
+    stats->numFramesSent = totals[SinkStats::kFramesSent];
+    stats->numBytesSent = totals[SinkStats::kBytesSent];
+    stats->numFailedCommits = totals[SinkStats::kFailedCommits];
+    stats->numUnavailableBuffers = totals[SinkStats::kNoBuffer];
+    stats->numUnsupportedFormatBuffers = totals[SinkStats::kUnsupportedFormat];
+    stats->numOversizedBuffers = totals[SinkStats::kOversized];
+    stats->numGatedBuffers = totals[SinkStats::kGated];
+    stats->numBuffersWithoutOutput = totals[SinkStats::kNoOutput];
+  }
+
+  uint64_t ABLLinkTimingHistogramQuantile(
+    const ABLLinkTimingHistogram* histogram,
+    const double quantile)
+  {
+    ableton::link_kit::TimingHistogram::Snapshot snapshot;
+    std::copy_n(histogram->counts, ABLLinkTimingNumBuckets, snapshot.counts.begin());
+    snapshot.count = histogram->count;
+    snapshot.totalNanoseconds = histogram->totalNanoseconds;
+    snapshot.maxNanoseconds = histogram->maxNanoseconds;
+    return ableton::link_kit::TimingQuantile(snapshot, quantile);
   }
 
   bool ABLLinkCommitCoreAudioBufferWithBeats(
@@ -548,17 +888,83 @@ extern "C"
     const uint32_t numFrames,
     AudioBufferList *ioData)
   {
-    if (sink->mBufferCopyFn == nullptr || (sink->mImpl.maxNumSamples() >= sink->mASBD.mChannelsPerFrame * numFrames))
+    auto& conversion = sink->mConversion;
+    auto& stats = sink->mStats;
+    const auto numChannels = conversion.map.numOutputChannels;
+    if (sink->mConversionKernel == nullptr)
+    {
+      stats.add(ableton::link_kit::SinkStats::kUnsupportedFormat);
+      return false;
+    }
+    if (!ableton::link_kit::FitsSink(conversion, numFrames, sink->mImpl.maxNumSamples()))
+    {
+      // Grow for the following buffers, in case the host exceeds the
+      // announced maximum by more than the headroom
+      sink->mImpl.requestMaxNumSamples(ableton::link_kit::SinkCapacity(conversion, numFrames));
+      stats.add(ableton::link_kit::SinkStats::kOversized);
+      return false;
+    }
+
+    // Buffers may hold any number of channels, as long as there are enough
+    // channels in total for the channel map
+    const auto& format = conversion.format;
+    ableton::link_kit::InputBuffers input;
+    input.numBuffers = std::min(
+      ioData->mNumberBuffers, static_cast<UInt32>(input.buffers.size()));
+    for (uint32_t i = 0; i < input.numBuffers; ++i)
+    {
+      input.buffers[i] = {ioData->mBuffers[i].mData, ioData->mBuffers[i].mNumberChannels};
+    }
+    if (ableton::link_kit::NumChannels(input) < conversion.map.numInputChannels)
     {
+      stats.add(ableton::link_kit::SinkStats::kUnsupportedFormat);
       return false;
     }
 
+    // The first resampled frame lies between input frames, stamp its beat
+    const auto& resampler = conversion.resampler;
+    const auto beatsAtOutputBegin = beatsAtBufferBegin
+      + resampler.nextOutputOffset() * ABLLinkGetTempo(sessionState)
+          / (60.0 * format.sampleRate);
+    const auto sampleRate = resampler.isActive()
+      ? resampler.outputRate()
+      : static_cast<uint32_t>(format.sampleRate);
+
+    // Silent input isn't converted, and with the Suppress mode not even a
+    // buffer is retained
+    if (const auto numGatedFrames = ableton::link_kit::GateSilence(
+          conversion, sink->mSilenceCheck, numFrames, input))
+    {
+      if (conversion.gate.mode() != ableton::link_kit::SilenceGateMode::SendSilence
+          || *numGatedFrames == 0)
+      {
+        stats.add(ableton::link_kit::SinkStats::kGated);
+        return false;
+      }
+      ABLLinkAudioSinkBufferHandleRef bufferHandle = ABLLinkAudioRetainBuffer(sink);
+      if (!ABLLinkAudioSinkBufferHandleIsValid(bufferHandle))
+      {
+        return false;
+      }
+      std::fill_n(ABLLinkAudioSinkBufferSamples(bufferHandle), *numGatedFrames * numChannels, int16_t{0});
+      return ABLLinkAudioReleaseAndCommitBuffer(sink, bufferHandle, sessionState, beatsAtOutputBegin, quantum, *numGatedFrames, numChannels, sampleRate);
+    }
+
     ABLLinkAudioSinkBufferHandleRef bufferHandle = ABLLinkAudioRetainBuffer(sink);
     if (ABLLinkAudioSinkBufferHandleIsValid(bufferHandle))
     {
       auto* output = ABLLinkAudioSinkBufferSamples(bufferHandle);
-      sink->mBufferCopyFn(numFrames, ioData, output);
-      return ABLLinkAudioReleaseAndCommitBuffer(sink, bufferHandle, sessionState, beatsAtBufferBegin, quantum, numFrames, sink->mASBD.mChannelsPerFrame, sink->mASBD.mSampleRate);
+      uint32_t numOutputFrames = 0;
+      {
+        ableton::link_kit::ScopedTiming timing(sink->mConversionTiming);
+        numOutputFrames = sink->mConversionKernel(conversion, numFrames, input, output);
+      }
+      if (!stats.addConversion(numOutputFrames))
+      {
+        ABLLinkAudioReleaseBuffer(bufferHandle);
+        return false;
+      }
+      return ABLLinkAudioReleaseAndCommitBuffer(sink, bufferHandle, sessionState, beatsAtOutputBegin, quantum, numOutputFrames, numChannels, sampleRate);
     }
     return false;
   }
@@ -575,4 +981,112 @@ extern "C"
     return ABLLinkCommitCoreAudioBufferWithBeats(sink, sessionState, beatsAtBufferBegin, quantum, numFrames, ioData);
   }
 
+  uint64_t ABLLinkCommitCoreAudioBuffers(
+    const ABLLinkAudioSinkRef *sinks,
+    AudioBufferList *const *bufferLists,
+    const uint32_t count,
+    ABLLinkSessionStateRef sessionState,
+    const uint64_t hostTimeAtBufferBegin,
+    const double quantum,
+    const uint32_t numFrames)
+  {
+    const double beatsAtBufferBegin = ABLLinkBeatAtTime(sessionState, hostTimeAtBufferBegin, quantum);
+    uint64_t committed = 0;
+    for (uint32_t i = 0; i < std::min(count, 64u); ++i)
+    {
+      if (ABLLinkCommitCoreAudioBufferWithBeats(
+            sinks[i], sessionState, beatsAtBufferBegin, quantum, numFrames, bufferLists[i]))
+      {
+        committed |= uint64_t{1} << i;
+      }
+    }
+    return committed;
+  }
+
+  bool ABLLinkCommitCoreAudioBufferWithTimeline(
+    ABLLinkAudioSinkRef sink,
+    ABLLinkSessionStateRef sessionState,
+    const ABLLinkBufferTimeline *timeline,
+    const uint32_t numFrames,
+    AudioBufferList *ioData)
+  {
+    return ABLLinkCommitCoreAudioBufferWithBeats(sink, sessionState,
+      timeline->beatsAtBufferBegin, timeline->quantum, numFrames, ioData);
+  }
+
+
+  ABLLinkAudioSourceRef ABLLinkAudioSourceNew(
+    ABLLinkRef ablLink,
+    const char* peerName,
+    const char* channelName,
+    const uint32_t maxNumFrames)
+  {
+    for (const auto& channel : ablLink->mImpl.channels())
+    {
+      if (channel.peerName == peerName && channel.name == channelName)
+      {
+        return new ABLLinkAudioSource(*ablLink, channel.id, maxNumFrames);
+      }
+    }
+    return nullptr;
+  }
+
+  void ABLLinkAudioSourceDelete(ABLLinkAudioSourceRef source)
+  {
+    delete source;
+  }
+
+  bool ABLLinkAudioSourceSetPropertiesFromASBD(
+    ABLLinkAudioSourceRef source,
+    const AudioStreamBasicDescription *asbd)
+  {
+    using namespace ableton::link_kit;
+    return source->mPlayout.setFormat(MakeFormatDescriptor(*asbd), BestInstructionSet());
+  }
+
+  void ABLLinkAudioSourceSetLatency(ABLLinkAudioSourceRef source, const uint32_t numFrames)
+  {
+    source->mPlayout.setLatency(numFrames);
+  }
+
+  void ABLLinkAudioSourceSetGain(ABLLinkAudioSourceRef source, const float gain)
+  {
+    source->mPlayout.setGain(gain);
+  }
+
+  uint32_t ABLLinkAudioSourceRender(
+    ABLLinkAudioSourceRef source,
+    ABLLinkSessionStateRef sessionState,
+    const uint64_t hostTimeAtBufferBegin,
+    const double quantum,
+    const uint32_t numFrames,
+    AudioBufferList *ioData)
+  {
+    // Without a format the playout can't tell the frame size, but the buffer
+    // sizes are known here
+    if (!source->mPlayout.hasFormat())
+    {
+      for (UInt32 i = 0; i < ioData->mNumberBuffers; ++i)
+      {
+        std::memset(ioData->mBuffers[i].mData, 0, ioData->mBuffers[i].mDataByteSize);
+      }
+      return 0;
+    }
+
+    ableton::link_kit::OutputBuffers output;
+    output.numBuffers = std::min(
+      ioData->mNumberBuffers, static_cast<UInt32>(output.buffers.size()));
+    for (uint32_t i = 0; i < output.numBuffers; ++i)
+    {
+      output.buffers[i] = ioData->mBuffers[i].mData;
+    }
+
+    const double beatsAtBufferBegin = ABLLinkBeatAtTime(sessionState, hostTimeAtBufferBegin, quantum);
+    return source->mPlayout.render(numFrames, output, beatsAtBufferBegin,
+      ABLLinkGetTempo(sessionState),
+      [&](const ABLLinkAudioSource::Info& info) {
+        return info.beginBeats(sessionState->mImpl, quantum);
+      });
+  }
+
 } // extern "C"
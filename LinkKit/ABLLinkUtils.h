@@ -38,6 +38,80 @@ extern "C"
   /*! @brief Convert float sample to int16_t (range: -1.0 to 1.0) */
   int16_t ABLConvertFloat(float input);
 
+  /*! @brief Reference to a command queue.
+   *
+   *  @discussion A command queue passes fixed size commands from one thread
+   *  to another, e.g. tempo proposals and transport requests from the main
+   *  thread to the audio thread. Commands arrive in order and none are
+   *  skipped. There must be at most one thread pushing and one thread
+   *  popping at a time.
+   */
+  typedef struct ABLLinkCommandQueue* ABLLinkCommandQueueRef;
+
+  /*! @brief Create a command queue.
+   *
+   *  @param commandSize Size of each command in bytes. Commands are copied
+   *  as bytes and must not hold references to memory they own.
+   *  @param capacity Number of commands the queue holds before pushing
+   *  fails.
+   */
+  ABLLinkCommandQueueRef ABLLinkCommandQueueNew(uint32_t commandSize, uint32_t capacity);
+
+  /*! @brief Destroy a command queue. */
+  void ABLLinkCommandQueueDelete(ABLLinkCommandQueueRef);
+
+  /*! @brief Add a command to the queue.
+   *
+   *  @return False if the queue is full, the command is dropped then.
+   *
+   *  @discussion This function is wait-free and doesn't allocate.
+   */
+  bool ABLLinkCommandQueuePush(ABLLinkCommandQueueRef, const void* command);
+
+  /*! @brief Take the oldest command from the queue.
+   *
+   *  @return False if the queue is empty.
+   *
+   *  @discussion This function is wait-free and doesn't allocate.
+   */
+  bool ABLLinkCommandQueuePop(ABLLinkCommandQueueRef, void* command);
+
+  /*! @brief Reference to a state slot.
+   *
+   *  @discussion A state slot passes the latest version of a fixed size
+   *  state from one thread to another, e.g. settings like the output latency
+   *  from the main thread to the audio thread. Unlike a command queue,
+   *  intermediate versions are skipped, and writing never fails. The state
+   *  is triple buffered, so neither side waits for the other or sees a
+   *  partially written state. There must be at most one thread writing and
+   *  one thread reading at a time.
+   */
+  typedef struct ABLLinkStateSlot* ABLLinkStateSlotRef;
+
+  /*! @brief Create a state slot holding a zeroed state.
+   *
+   *  @param stateSize Size of the state in bytes. States are copied as
+   *  bytes and must not hold references to memory they own.
+   */
+  ABLLinkStateSlotRef ABLLinkStateSlotNew(uint32_t stateSize);
+
+  /*! @brief Destroy a state slot. */
+  void ABLLinkStateSlotDelete(ABLLinkStateSlotRef);
+
+  /*! @brief Publish a new version of the state.
+   *
+   *  @discussion This function is wait-free and doesn't allocate.
+   */
+  void ABLLinkStateSlotWrite(ABLLinkStateSlotRef, const void* state);
+
+  /*! @brief Copy the latest published version of the state.
+   *
+   *  @return True if the state was published since the previous read.
+   *
+   *  @discussion This function is wait-free and doesn't allocate.
+   */
+  bool ABLLinkStateSlotRead(ABLLinkStateSlotRef, void* state);
+
 #ifdef __cplusplus
 }
 #endif
@@ -7,6 +7,14 @@
 #include <ableton/LinkAudio.hpp>
 #include <AudioToolbox/AudioToolbox.h>
 #include "detail/ABLSettingsViewController.h"
+#include "detail/CommandQueue.hpp"
+#include "detail/EventMailbox.hpp"
+#include "detail/KernelTable.hpp"
+#include "detail/Playout.hpp"
+#include "detail/SinkCapacity.hpp"
+#include "detail/SinkStats.hpp"
+#include "detail/TimingHistogram.hpp"
+#include "detail/TripleBuffer.hpp"
 
 extern "C"
 {
@@ -63,29 +71,72 @@ extern "C"
     void enableLinkAudio(bool);
     bool isLinkAudioEnabled();
     void setPeerName(const char*);
+    // Schedule delivery of the pending callback events on the main queue
+    void deliverEvents();
 
     std::shared_ptr<ABLLinkCallbacks> mpCallbacks;
+    // Session events waiting for main queue delivery. Shared with the
+    // delivery block, which may run after the ABLLink is gone.
+    std::shared_ptr<ableton::link_kit::EventMailbox> mpCallbackEvents;
+    // Session events waiting for ABLLinkPollEvents
+    ableton::link_kit::EventMailbox mPolledEvents;
     bool mActive;
     std::atomic<bool> mEnabled;
     ableton::LinkAudio mImpl;
     ABLSettingsViewController *mpSettingsViewController;
     ABLLinkSessionState mAudioSessionState;
     ABLLinkSessionState mAppSessionState;
+    // Durations of the audio session state calls, if enabled
+    ableton::link_kit::TimingHistogram mCaptureTiming;
+    ableton::link_kit::TimingHistogram mCommitTiming;
   };
 
   struct ABLLinkAudioSinkBufferHandle {
     std::optional<ableton::LinkAudioSink::BufferHandle> moImpl;
   };
 
-  typedef void (*BufferCopyFn)(const uint32_t numFrames, AudioBufferList* input, int16_t* output);
-
   struct ABLLinkAudioSink
   {
     ABLLinkAudioSink(ABLLink& link, const char* name, uint32_t maxNumSamples);
 
     ableton::LinkAudioSink mImpl;
     ABLLinkAudioSinkBufferHandle mBufferHandle;
-    AudioStreamBasicDescription mASBD;
-    BufferCopyFn mBufferCopyFn = nullptr;
+    // Format, channel map, gain and resampler state of the conversion
+    ableton::link_kit::ConversionState mConversion;
+    // Kernel selected for the current configuration, nullptr if the format
+    // isn't supported
+    ableton::link_kit::ConversionKernel mConversionKernel = nullptr;
+    // Silence check for the current format, nullptr if the format isn't
+    // supported
+    ableton::link_kit::SilenceCheck mSilenceCheck = nullptr;
+    // Durations of converting and committing buffers, if enabled
+    ableton::link_kit::TimingHistogram mConversionTiming;
+    ableton::link_kit::TimingHistogram mCommitTiming;
+    // Outcomes of committed buffers
+    ableton::link_kit::SinkStats mStats;
+    // Largest buffer committed by the host in input frames, the sink is sized
+    // for it
+    uint32_t mMaxNumFrames = ableton::link_kit::kDefaultMaxNumFrames;
+  };
+
+  struct ABLLinkAudioSource
+  {
+    using Info = ableton::LinkAudioSource::BufferHandle::Info;
+
+    ABLLinkAudioSource(ABLLink& link, ableton::ChannelId channelId, uint32_t maxNumFrames);
+
+    // Declared before the source, so that it outlives the receive callback
+    ableton::link_kit::AudioPlayout<Info> mPlayout;
+    ableton::LinkAudioSource mImpl;
+  };
+
+  struct ABLLinkCommandQueue
+  {
+    ableton::link_kit::CommandQueue mImpl;
+  };
+
+  struct ABLLinkStateSlot
+  {
+    ableton::link_kit::TripleBuffer mImpl;
   };
 }
@@ -0,0 +1,190 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#pragma once
+
+#include "BufferTimeline.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+namespace ableton::link_kit
+{
+
+// Bits of GridEvent::flags. Grid lines carry every flag that applies, so a
+// quantum boundary on a whole beat is also a beat and a subdivision.
+enum GridEventFlag : uint32_t
+{
+  kGridSubdivision = 1u << 0,
+  kGridBeat = 1u << 1,
+  kGridQuantum = 1u << 2,
+  kGridTransportStart = 1u << 3,
+  kGridTransportStop = 1u << 4,
+};
+
+// A frame of a buffer at which the grid or the transport is crossed
+struct GridEvent
+{
+  uint32_t frame = 0;
+  uint32_t flags = 0;
+  // The grid line, or the beat at the transport change if the event is only
+  // a transport change
+  double beats = 0.0;
+};
+
+// The most recent start or stop of the transport
+struct TransportChange
+{
+  bool isPlaying = false;
+  uint64_t hostTime = 0;
+};
+
+namespace detail
+{
+
+// Grid lines this close are the same line
+constexpr double kGridBeatTolerance = 1e-9;
+// Rounding errors of the timeline don't move a crossing to the next frame
+constexpr double kGridFrameTolerance = 1e-6;
+
+// First frame at or after a fractional frame position
+inline double CrossingFrame(const double frame)
+{
+  return std::ceil(frame - kGridFrameTolerance);
+}
+
+// Collects events in frame order, merging events of the same frame
+template <typename Event>
+class GridEventWriter
+{
+public:
+  GridEventWriter(Event* events, const uint32_t maxNumEvents)
+    : mEvents(events)
+    , mMaxNumEvents(maxNumEvents)
+  {
+  }
+
+  void write(const uint32_t frame, const uint32_t flags, const double beats)
+  {
+    if (mNumEvents > 0 && mEvents[mNumEvents - 1].frame == frame)
+    {
+      mEvents[mNumEvents - 1].flags |= flags;
+    }
+    else if (mNumEvents < mMaxNumEvents)
+    {
+      mEvents[mNumEvents++] = {frame, flags, beats};
+    }
+  }
+
+  uint32_t numEvents() const
+  {
+    return mNumEvents;
+  }
+
+private:
+  Event* mEvents;
+  uint32_t mMaxNumEvents;
+  uint32_t mNumEvents = 0;
+};
+
+} // namespace detail
+
+// Find the frames of a buffer at which the timeline crosses a subdivision of a
+// beat, a whole beat or a multiple of the quantum, and at which the transport
+// changes. An event is at the first frame at or after the crossing, so each
+// crossing lands in exactly one of consecutive buffers. Events are written in
+// frame order, at most one per frame and at most maxNumEvents. Returns the
+// number of events written. The cost depends on the number of grid lines in
+// the buffer, not on its length. Event may be any aggregate with the fields of
+// GridEvent, in the same order.
+template <typename Event>
+uint32_t FindGridEvents(const BufferTimeline& timeline,
+                        const uint32_t numFrames,
+                        const uint32_t subdivisionsPerBeat,
+                        const std::optional<TransportChange>& transport,
+                        Event* events,
+                        const uint32_t maxNumEvents)
+{
+  detail::GridEventWriter<Event> writer(events, maxNumEvents);
+  if (numFrames == 0 || !(timeline.beatsPerFrame > 0.0))
+  {
+    return 0;
+  }
+
+  // Only a transport change within the buffer is an event
+  bool hasTransport = false;
+  uint32_t transportFrame = 0;
+  uint32_t transportFlags = 0;
+  if (transport)
+  {
+    const auto frame = detail::CrossingFrame(timeline.frameAtHostTime(transport->hostTime));
+    if (frame >= 0.0 && frame < numFrames)
+    {
+      hasTransport = true;
+      transportFrame = static_cast<uint32_t>(frame);
+      transportFlags = transport->isPlaying ? kGridTransportStart : kGridTransportStop;
+    }
+  }
+  const auto writeTransportBefore = [&](const uint32_t frame) {
+    if (hasTransport && transportFrame < frame)
+    {
+      writer.write(transportFrame, transportFlags, timeline.beatAtFrame(transportFrame));
+      hasTransport = false;
+    }
+  };
+
+  // Walk subdivisions and multiples of the quantum in order, starting at the
+  // last ones before the buffer
+  const auto numSubdivisions = int64_t{std::max(subdivisionsPerBeat, 1u)};
+  const auto quantum = timeline.quantum;
+  const auto firstBeats = timeline.beatAtFrame(-1.0);
+  const auto endBeats = timeline.beatAtFrame(numFrames);
+  auto subdivision = static_cast<int64_t>(std::floor(firstBeats * numSubdivisions));
+  auto quantumIndex = quantum > 0.0 ? static_cast<int64_t>(std::floor(firstBeats / quantum)) : 0;
+  const auto subdivisionBeats = [&] {
+    return static_cast<double>(subdivision) / static_cast<double>(numSubdivisions);
+  };
+  const auto quantumBeats = [&] {
+    return quantum > 0.0 ? static_cast<double>(quantumIndex) * quantum
+                         : std::numeric_limits<double>::infinity();
+  };
+
+  while (true)
+  {
+    const auto beats = std::min(subdivisionBeats(), quantumBeats());
+    if (beats > endBeats)
+    {
+      break;
+    }
+
+    uint32_t flags = 0;
+    if (subdivisionBeats() - beats < detail::kGridBeatTolerance)
+    {
+      flags |= kGridSubdivision | (subdivision % numSubdivisions == 0 ? kGridBeat : 0u);
+      ++subdivision;
+    }
+    if (quantumBeats() - beats < detail::kGridBeatTolerance)
+    {
+      flags |= kGridQuantum;
+      ++quantumIndex;
+    }
+
+    const auto frame = detail::CrossingFrame(timeline.frameAtBeat(beats));
+    if (frame >= 0.0 && frame < numFrames)
+    {
+      const auto gridFrame = static_cast<uint32_t>(frame);
+      writeTransportBefore(gridFrame);
+      if (hasTransport && transportFrame == gridFrame)
+      {
+        flags |= transportFlags;
+        hasTransport = false;
+      }
+      writer.write(gridFrame, flags, beats);
+    }
+  }
+  writeTransportBefore(numFrames);
+  return writer.numEvents();
+}
+
+} // namespace ableton::link_kit
@@ -2,8 +2,12 @@
 
 #pragma once
 
-#include "ableton/util/FloatIntConversion.hpp"
+#include "InstructionSet.hpp"
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 namespace ableton::link_kit
 {
@@ -32,10 +36,110 @@ inline int16_t ConvertUInt32(uint32_t input)
   return static_cast<int16_t>((static_cast<int64_t>(input) - 2147483648LL) >> 16);
 }
 
-// Convert float sample (range: -1.0 to 1.0)
+// Clamp a float sample to [-1.0, 1.0] and scale it to the 16-bit range like
+// util::floatToInt16: negative samples by 2^15 and positive samples by
+// 2^15 - 1, so that both full scale values map to the limits. The comparisons
+// mirror the vector min/max instructions, so NaN maps to the negative limit and
+// the vector kernels below produce identical results.
+inline float ScaleFloat(const float input)
+{
+  const float lower = input > -1.0f ? input : -1.0f;
+  const float clamped = lower < 1.0f ? lower : 1.0f;
+  return clamped * (clamped < 0.0f ? 32768.0f : 32767.0f);
+}
+
+// Convert float sample (range: -1.0 to 1.0). Identical to util::floatToInt16
+// for all samples but NaN.
 inline int16_t ConvertFloat(float input)
 {
-  return ableton::util::floatToInt16(input);
+  return static_cast<int16_t>(ScaleFloat(input));
+}
+
+// Convert float sample rounding to the nearest 16-bit value (ties to even)
+// instead of truncating
+inline int16_t RoundFloat(float input)
+{
+  return static_cast<int16_t>(std::nearbyint(ScaleFloat(input)));
+}
+
+// Sample types without a matching builtin type. They wrap the raw storage so
+// that they can be dispatched on like the builtin sample types.
+
+// Signed 24-bit sample packed into 3 bytes, little endian
+struct PackedInt24
+{
+  uint8_t bytes[3];
+};
+
+// Signed 24-bit sample in the low bits of a 32-bit word, the high byte is
+// ignored
+struct LowAlignedInt24
+{
+  int32_t value;
+};
+
+// Signed 8.24 fixed point sample, i.e. 1.0 is represented as 2^24
+struct Fixed824
+{
+  int32_t value;
+};
+
+// Sample stored in big endian byte order
+template <typename T>
+struct BigEndian
+{
+  T value;
+};
+
+inline uint16_t ByteSwap(const uint16_t input)
+{
+  return __builtin_bswap16(input);
+}
+
+inline uint32_t ByteSwap(const uint32_t input)
+{
+  return __builtin_bswap32(input);
+}
+
+// Convert the native byte order value of a big endian sample
+template <typename T>
+T FromBigEndian(const BigEndian<T> input)
+{
+  using Bits = std::conditional_t<sizeof(T) == 2, uint16_t, uint32_t>;
+  static_assert(sizeof(T) == sizeof(Bits), "Unsupported big endian sample type");
+  Bits bits;
+  std::memcpy(&bits, &input.value, sizeof(bits));
+  bits = ByteSwap(bits);
+  T output;
+  std::memcpy(&output, &bits, sizeof(output));
+  return output;
+}
+
+// Convert packed 24-bit sample (keep the upper two bytes)
+inline int16_t ConvertPackedInt24(PackedInt24 input)
+{
+  return static_cast<int16_t>(input.bytes[1] | (input.bytes[2] << 8));
+}
+
+// Convert low aligned 24-bit sample (shift to 16-bit range)
+inline int16_t ConvertLowAlignedInt24(LowAlignedInt24 input)
+{
+  return static_cast<int16_t>(input.value >> 8);
+}
+
+// Convert 8.24 fixed point sample (shift to 16-bit range and saturate)
+inline int16_t ConvertFixed824(Fixed824 input)
+{
+  const auto shifted = input.value >> 9;
+  const auto lower = shifted > -32768 ? shifted : -32768;
+  return static_cast<int16_t>(lower < 32767 ? lower : 32767);
+}
+
+// Convert double sample (range: -1.0 to 1.0). It is narrowed to float first,
+// so that it converts exactly like the same sample in float.
+inline int16_t ConvertFloat64(double input)
+{
+  return ConvertFloat(static_cast<float>(input));
 }
 
 // Type-dispatched conversion helper
@@ -72,41 +176,1823 @@ inline int16_t Convert<float>(float input)
   return ConvertFloat(input);
 }
 
-// Copy mono buffer - converts samples from input type T to int16_t
-template <typename T>
-void CopyBufferMono(const uint32_t numFrames, const T* input, int16_t* output)
+template <>
+inline int16_t Convert<double>(double input)
+{
+  return ConvertFloat64(input);
+}
+
+template <>
+inline int16_t Convert<PackedInt24>(PackedInt24 input)
+{
+  return ConvertPackedInt24(input);
+}
+
+template <>
+inline int16_t Convert<LowAlignedInt24>(LowAlignedInt24 input)
+{
+  return ConvertLowAlignedInt24(input);
+}
+
+template <>
+inline int16_t Convert<Fixed824>(Fixed824 input)
+{
+  return ConvertFixed824(input);
+}
+
+template <>
+inline int16_t Convert<BigEndian<int16_t>>(BigEndian<int16_t> input)
+{
+  return ConvertInt16(FromBigEndian(input));
+}
+
+template <>
+inline int16_t Convert<BigEndian<int32_t>>(BigEndian<int32_t> input)
+{
+  return ConvertInt32(FromBigEndian(input));
+}
+
+template <>
+inline int16_t Convert<BigEndian<float>>(BigEndian<float> input)
+{
+  return ConvertFloat(FromBigEndian(input));
+}
+
+// Rounding applied when reducing float samples to 16 bits. Integer samples are
+// always truncated.
+namespace rounding
+{
+struct Truncate
+{
+};
+
+struct Nearest
 {
-  for (uint32_t frame = 0; frame < numFrames; ++frame)
+};
+} // namespace rounding
+
+template <typename Rounding, typename T>
+int16_t Quantize(T input)
+{
+  if constexpr (std::is_same_v<Rounding, rounding::Nearest>)
+  {
+    static_assert(std::is_same_v<T, float>, "Only float samples can be rounded");
+    return RoundFloat(input);
+  }
+  else
   {
-    output[frame] = Convert<T>(input[frame]);
+    return Convert<T>(input);
   }
 }
 
-// Copy stereo non-interleaved buffer - two separate arrays for left and right
+// Normalize sample to float (range: -1.0 to 1.0). ConvertFloat(ToFloat(x))
+// is exact for 16-bit inputs.
 template <typename T>
-void CopyBufferStereoNonInterleaved(const uint32_t numFrames,
-                                    const T* left,
-                                    const T* right,
-                                    int16_t* output)
+float ToFloat(T input);
+
+// Like util::int16ToFloat, the inverse of the scaling in ScaleFloat
+template <>
+inline float ToFloat<int16_t>(int16_t input)
 {
-  for (uint32_t frame = 0; frame < numFrames; ++frame)
-  {
-    output[2 * frame] = Convert<T>(left[frame]);
-    output[2 * frame + 1] = Convert<T>(right[frame]);
-  }
+  return static_cast<float>(input) / (input < 0 ? 32768.0f : 32767.0f);
 }
 
-// Copy stereo interleaved buffer - left and right samples alternate in single
-// array
+template <>
+inline float ToFloat<uint16_t>(uint16_t input)
+{
+  return ToFloat<int16_t>(ConvertUInt16(input));
+}
+
+template <>
+inline float ToFloat<int32_t>(int32_t input)
+{
+  return static_cast<float>(input) * (1.0f / 2147483648.0f);
+}
+
+template <>
+inline float ToFloat<uint32_t>(uint32_t input)
+{
+  return ToFloat<int32_t>(static_cast<int32_t>(input ^ 0x80000000u));
+}
+
+template <>
+inline float ToFloat<float>(float input)
+{
+  return input;
+}
+
+template <>
+inline float ToFloat<double>(double input)
+{
+  return static_cast<float>(input);
+}
+
+template <>
+inline float ToFloat<PackedInt24>(PackedInt24 input)
+{
+  const auto value = uint32_t{input.bytes[0]} << 8 | uint32_t{input.bytes[1]} << 16
+                     | uint32_t{input.bytes[2]} << 24;
+  return ToFloat<int32_t>(static_cast<int32_t>(value));
+}
+
+template <>
+inline float ToFloat<LowAlignedInt24>(LowAlignedInt24 input)
+{
+  return ToFloat<int32_t>(static_cast<int32_t>(static_cast<uint32_t>(input.value) << 8));
+}
+
+template <>
+inline float ToFloat<Fixed824>(Fixed824 input)
+{
+  return static_cast<float>(input.value) * (1.0f / 16777216.0f);
+}
+
+template <>
+inline float ToFloat<BigEndian<int16_t>>(BigEndian<int16_t> input)
+{
+  return ToFloat<int16_t>(FromBigEndian(input));
+}
+
+template <>
+inline float ToFloat<BigEndian<int32_t>>(BigEndian<int32_t> input)
+{
+  return ToFloat<int32_t>(FromBigEndian(input));
+}
+
+template <>
+inline float ToFloat<BigEndian<float>>(BigEndian<float> input)
+{
+  return FromBigEndian(input);
+}
+
+// Expand a received 16-bit sample to float, normalized like ToFloat and
+// multiplied by scale. With the scale of ExpansionScale<float>(1), ConvertFloat
+// restores the sample exactly.
+inline float ExpandFloat(const int16_t input, const float scale)
+{
+  return ToFloat<int16_t>(input) * scale;
+}
+
+// Expand a received 16-bit sample to int32, multiplied by scale, saturated and
+// truncated towards zero. 2147483520 is the largest float below 2^31. The
+// comparisons mirror the vector min/max instructions like in ConvertFloat.
+inline int32_t ExpandInt32(const int16_t input, const float scale)
+{
+  const float scaled = static_cast<float>(input) * scale;
+  const float lower = scaled > -2147483648.0f ? scaled : -2147483648.0f;
+  const float clamped = lower < 2147483520.0f ? lower : 2147483520.0f;
+  return static_cast<int32_t>(clamped);
+}
+
+// Factor expanding 16-bit samples to type U with the given linear gain. Float
+// samples are normalized before they are scaled.
+template <typename U>
+float ExpansionScale(float gain);
+
+template <>
+inline float ExpansionScale<float>(const float gain)
+{
+  return gain;
+}
+
+template <>
+inline float ExpansionScale<int32_t>(const float gain)
+{
+  return gain * 65536.0f;
+}
+
+template <typename U>
+U Expand(int16_t input, float scale);
+
+template <>
+inline float Expand<float>(const int16_t input, const float scale)
+{
+  return ExpandFloat(input, scale);
+}
+
+template <>
+inline int32_t Expand<int32_t>(const int16_t input, const float scale)
+{
+  return ExpandInt32(input, scale);
+}
+
+// Frames processed per block by routines that need intermediate storage.
+// Blocks are small enough to keep all intermediate data in L1 cache and on the
+// stack.
+constexpr uint32_t kBlockSize = 64;
+
+// Levels of converted 16-bit samples, accumulated across blocks
+struct SampleLevels
+{
+  int32_t max = 0;
+  int32_t min = 0;
+  uint64_t sumOfSquares = 0;
+  // Samples at the positive or negative limit
+  uint64_t numClipped = 0;
+};
+
+inline void AccumulateLevels(const int16_t sample, SampleLevels& levels)
+{
+  const int32_t value = sample;
+  levels.max = std::max(levels.max, value);
+  levels.min = std::min(levels.min, value);
+  levels.sumOfSquares += static_cast<uint64_t>(value * value);
+  levels.numClipped += value == 32767 || value == -32768 ? 1 : 0;
+}
+
+inline SampleLevels MergeLevels(const SampleLevels& lhs, const SampleLevels& rhs)
+{
+  return {std::max(lhs.max, rhs.max),
+          std::min(lhs.min, rhs.min),
+          lhs.sumOfSquares + rhs.sumOfSquares,
+          lhs.numClipped + rhs.numClipped};
+}
+
+// Instruction sets the buffer copy routines can be instantiated for. Each
+// provides two loops: a contiguous conversion and a conversion that
+// interleaves two planar inputs. Vector loops finish with a scalar tail.
+// Float input can optionally be rounded instead of truncated. A third loop
+// meters converted samples, keeping the levels of even and odd samples apart
+// so that stereo frames are metered per channel. A fourth checks whether input
+// converts to silence, stopping at the first sample that doesn't. For the
+// receive direction, two more loops expand 16-bit samples to float or int32,
+// contiguously or splitting stereo frames into planar outputs.
+namespace isa
+{
+
+// Number of samples vector loads may read past the end of a block. Vector loops
+// stop early enough to keep these reads inside the buffer.
 template <typename T>
-void CopyBufferStereoInterleaved(const uint32_t numFrames,
-                                 const T* input,
-                                 int16_t* output)
+inline constexpr uint32_t kLoadPadding = 0;
+
+template <>
+inline constexpr uint32_t kLoadPadding<PackedInt24> = 2;
+
+// Samples vector meter loops accumulate in narrow lanes before flushing them to
+// the totals. A chunk puts kMeterChunkSize / kWidth samples in each 16-bit lane,
+// 2^11 with SSE2 and 2^10 with AVX2 and NEON. Lanes count at most as many
+// clipped samples in 16 bits, and sum as many halves of squares, each below
+// 2^16, in 32 bits.
+inline constexpr uint32_t kMeterChunkSize = 16384;
+
+// Blocks vector silence checks reduce to their range before branching on it
+inline constexpr uint32_t kSilenceGroupSize = 4;
+
+struct Scalar
+{
+  template <typename T, typename Rounding = rounding::Truncate>
+  static void convert(const uint32_t numSamples, const T* input, int16_t* output)
+  {
+    for (uint32_t i = 0; i < numSamples; ++i)
+    {
+      output[i] = Quantize<Rounding>(input[i]);
+    }
+  }
+
+  template <typename T, typename Rounding = rounding::Truncate>
+  static void interleave(const uint32_t numFrames,
+                         const T* left,
+                         const T* right,
+                         int16_t* output)
+  {
+    for (uint32_t frame = 0; frame < numFrames; ++frame)
+    {
+      output[2 * frame] = Quantize<Rounding>(left[frame]);
+      output[2 * frame + 1] = Quantize<Rounding>(right[frame]);
+    }
+  }
+
+  static void meter(const uint32_t numSamples,
+                    const int16_t* samples,
+                    SampleLevels& even,
+                    SampleLevels& odd)
+  {
+    for (uint32_t i = 0; i < numSamples; ++i)
+    {
+      AccumulateLevels(samples[i], i % 2 == 0 ? even : odd);
+    }
+  }
+
+  // True if no sample converts to a magnitude above threshold
+  template <typename T>
+  static bool isSilent(const uint32_t numSamples, const T* input, const int16_t threshold)
+  {
+    for (uint32_t i = 0; i < numSamples; ++i)
+    {
+      const auto sample = Convert<T>(input[i]);
+      if (sample > threshold || sample < -threshold)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Scale is ExpansionScale<U>(gain)
+  template <typename U>
+  static void expand(const uint32_t numSamples,
+                     const int16_t* input,
+                     U* output,
+                     const float scale)
+  {
+    for (uint32_t i = 0; i < numSamples; ++i)
+    {
+      output[i] = Expand<U>(input[i], scale);
+    }
+  }
+
+  template <typename U>
+  static void deinterleave(const uint32_t numFrames,
+                           const int16_t* input,
+                           U* left,
+                           U* right,
+                           const float scale)
+  {
+    for (uint32_t frame = 0; frame < numFrames; ++frame)
+    {
+      left[frame] = Expand<U>(input[2 * frame], scale);
+      right[frame] = Expand<U>(input[2 * frame + 1], scale);
+    }
+  }
+
+  // Add an input channel of a channel map downmix to one or two output sums,
+  // left += leftGain * input and right += rightGain * input. Vector versions
+  // multiply and add separately, so all instruction sets round alike.
+  static void accumulate(const uint32_t numOutputChannels,
+                         const uint32_t numFrames,
+                         const float* input,
+                         const float leftGain,
+                         const float rightGain,
+                         float* left,
+                         float* right)
+  {
+    for (uint32_t frame = 0; frame < numFrames; ++frame)
+    {
+      const auto leftProduct = leftGain * input[frame];
+      left[frame] += leftProduct;
+    }
+    if (numOutputChannels == 2)
+    {
+      for (uint32_t frame = 0; frame < numFrames; ++frame)
+      {
+        const auto rightProduct = rightGain * input[frame];
+        right[frame] += rightProduct;
+      }
+    }
+  }
+};
+
+#if defined(LINK_KIT_SIMD_SSE2)
+
+struct Sse2
 {
-  for (uint32_t frame = 0; frame < numFrames * 2; ++frame)
+  static constexpr uint32_t kWidth = 8;
+
+  static __m128i load(const void* input)
+  {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(input));
+  }
+
+  static __m128i fromInt32(const __m128i lo, const __m128i hi)
+  {
+    return _mm_packs_epi32(_mm_srai_epi32(lo, 16), _mm_srai_epi32(hi, 16));
+  }
+
+  // cvtps rounds to nearest even in the default rounding mode
+  static __m128i toInt32(const __m128 input, rounding::Truncate)
+  {
+    return _mm_cvttps_epi32(input);
+  }
+
+  static __m128i toInt32(const __m128 input, rounding::Nearest)
+  {
+    return _mm_cvtps_epi32(input);
+  }
+
+  // Selects the scale of 2^15 for negative and 2^15 - 1 for other samples
+  static __m128 signScale(const __m128 input, const __m128 negative, const __m128 positive)
+  {
+    const auto isNegative = _mm_cmplt_ps(input, _mm_setzero_ps());
+    return _mm_or_ps(_mm_and_ps(isNegative, negative), _mm_andnot_ps(isNegative, positive));
+  }
+
+  // Vector ScaleFloat
+  static __m128 scaleFloat(const __m128 input)
+  {
+    const auto clamped =
+      _mm_min_ps(_mm_max_ps(input, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f));
+    return _mm_mul_ps(
+      clamped, signScale(clamped, _mm_set1_ps(32768.0f), _mm_set1_ps(32767.0f)));
+  }
+
+  template <typename Rounding>
+  static __m128i fromFloat(const __m128 lo, const __m128 hi, Rounding rounding)
+  {
+    return _mm_packs_epi32(
+      toInt32(scaleFloat(lo), rounding), toInt32(scaleFloat(hi), rounding));
+  }
+
+  static __m128i swapBytes16(const __m128i input)
+  {
+    return _mm_or_si128(_mm_slli_epi16(input, 8), _mm_srli_epi16(input, 8));
+  }
+
+  // SSE2 has no byte shuffle: swap the bytes of each 16-bit word, then the
+  // words of each 32-bit word
+  static __m128i swapBytes32(const __m128i input)
+  {
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(swapBytes16(input), 0xB1), 0xB1);
+  }
+
+  static __m128i convertBlock(const int16_t* input, rounding::Truncate = {})
+  {
+    return load(input);
+  }
+
+  static __m128i convertBlock(const uint16_t* input, rounding::Truncate = {})
+  {
+    return _mm_xor_si128(load(input), _mm_set1_epi16(static_cast<int16_t>(0x8000)));
+  }
+
+  static __m128i convertBlock(const int32_t* input, rounding::Truncate = {})
+  {
+    return fromInt32(load(input), load(input + 4));
+  }
+
+  static __m128i convertBlock(const uint32_t* input, rounding::Truncate = {})
+  {
+    const auto bias = _mm_set1_epi32(static_cast<int32_t>(0x80000000u));
+    return fromInt32(_mm_xor_si128(load(input), bias), _mm_xor_si128(load(input + 4), bias));
+  }
+
+  template <typename Rounding = rounding::Truncate>
+  static __m128i convertBlock(const float* input, Rounding rounding = {})
+  {
+    return fromFloat(_mm_loadu_ps(input), _mm_loadu_ps(input + 4), rounding);
+  }
+
+  // Four samples, narrowed to float
+  static __m128 narrowFloat64(const double* input)
+  {
+    return _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(input)),
+                         _mm_cvtpd_ps(_mm_loadu_pd(input + 2)));
+  }
+
+  static __m128i convertBlock(const double* input, rounding::Truncate = {})
+  {
+    return fromFloat(narrowFloat64(input), narrowFloat64(input + 4), rounding::Truncate{});
+  }
+
+  // Four samples shifted to the upper 24 bits of 32-bit words. Two overlapping
+  // 64-bit loads hold two samples each, shifting the 64-bit lanes moves the
+  // first and second sample of each into place. Reads two bytes past the
+  // four samples.
+  static __m128i unpackInt24(const PackedInt24* input)
+  {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(input);
+    const auto pairs =
+      _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(bytes)),
+                         _mm_loadl_epi64(reinterpret_cast<const __m128i*>(bytes + 6)));
+    const auto firsts = _mm_slli_epi64(pairs, 8);
+    const auto seconds = _mm_slli_epi64(pairs, 16);
+    const auto mask = _mm_set_epi32(0, -1, 0, -1);
+    return _mm_or_si128(_mm_and_si128(mask, firsts), _mm_andnot_si128(mask, seconds));
+  }
+
+  static __m128i convertBlock(const PackedInt24* input, rounding::Truncate = {})
+  {
+    return fromInt32(unpackInt24(input), unpackInt24(input + 4));
+  }
+
+  static __m128i convertBlock(const LowAlignedInt24* input, rounding::Truncate = {})
+  {
+    return fromInt32(_mm_slli_epi32(load(input), 8), _mm_slli_epi32(load(input + 4), 8));
+  }
+
+  static __m128i convertBlock(const Fixed824* input, rounding::Truncate = {})
   {
-    output[frame] = Convert<T>(input[frame]);
+    return _mm_packs_epi32(_mm_srai_epi32(load(input), 9), _mm_srai_epi32(load(input + 4), 9));
   }
+
+  static __m128i convertBlock(const BigEndian<int16_t>* input, rounding::Truncate = {})
+  {
+    return swapBytes16(load(input));
+  }
+
+  static __m128i convertBlock(const BigEndian<int32_t>* input, rounding::Truncate = {})
+  {
+    return fromInt32(swapBytes32(load(input)), swapBytes32(load(input + 4)));
+  }
+
+  static __m128i convertBlock(const BigEndian<float>* input, rounding::Truncate = {})
+  {
+    return fromFloat(_mm_castsi128_ps(swapBytes32(load(input))),
+                     _mm_castsi128_ps(swapBytes32(load(input + 4))),
+                     rounding::Truncate{});
+  }
+
+  template <typename T, typename Rounding = rounding::Truncate>
+  static void convert(const uint32_t numSamples, const T* input, int16_t* output)
+  {
+    uint32_t i = 0;
+    for (; i + kWidth + kLoadPadding<T> <= numSamples; i += kWidth)
+    {
+      _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(output + i), convertBlock(input + i, Rounding{}));
+    }
+    Scalar::convert<T, Rounding>(numSamples - i, input + i, output + i);
+  }
+
+  template <typename T, typename Rounding = rounding::Truncate>
+  static void interleave(const uint32_t numFrames,
+                         const T* left,
+                         const T* right,
+                         int16_t* output)
+  {
+    uint32_t frame = 0;
+    for (; frame + kWidth + kLoadPadding<T> <= numFrames; frame += kWidth)
+    {
+      const auto l = convertBlock(left + frame, Rounding{});
+      const auto r = convertBlock(right + frame, Rounding{});
+      auto* out = reinterpret_cast<__m128i*>(output + 2 * frame);
+      _mm_storeu_si128(out, _mm_unpacklo_epi16(l, r));
+      _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(l, r));
+    }
+    Scalar::interleave<T, Rounding>(
+      numFrames - frame, left + frame, right + frame, output + 2 * frame);
+  }
+
+  // Each 32-bit lane holds an even sample in its low and an odd sample in its
+  // high half. Squares are split into their 16-bit halves, which are summed
+  // separately in 32-bit lanes without shuffling and flushed to the 64-bit
+  // totals after each chunk.
+  static void meter(const uint32_t numSamples,
+                    const int16_t* samples,
+                    SampleLevels& even,
+                    SampleLevels& odd)
+  {
+    static_assert(kMeterChunkSize / kWidth < 1 << 16, "Meter chunks overflow 16-bit lanes");
+    const auto zero = _mm_setzero_si128();
+    const auto lowHalf = _mm_set1_epi32(0xFFFF);
+    const auto upper = _mm_set1_epi16(32767);
+    const auto lower = _mm_set1_epi16(-32768);
+    const auto numVectorSamples = numSamples - numSamples % kWidth;
+    uint32_t i = 0;
+    while (i < numVectorSamples)
+    {
+      const auto chunkBegin = i;
+      const auto chunkEnd = i + std::min(numVectorSamples - i, kMeterChunkSize);
+      auto max = zero;
+      auto min = zero;
+      auto evenLow = zero;
+      auto evenHigh = zero;
+      auto oddLow = zero;
+      auto oddHigh = zero;
+      for (; i < chunkEnd; i += kWidth)
+      {
+        const auto x = load(samples + i);
+        max = _mm_max_epi16(max, x);
+        min = _mm_min_epi16(min, x);
+        const auto lo = _mm_mullo_epi16(x, x);
+        const auto hi = _mm_mulhi_epi16(x, x);
+        evenLow = _mm_add_epi32(evenLow, _mm_and_si128(lo, lowHalf));
+        evenHigh = _mm_add_epi32(evenHigh, _mm_and_si128(hi, lowHalf));
+        oddLow = _mm_add_epi32(oddLow, _mm_srli_epi32(lo, 16));
+        oddHigh = _mm_add_epi32(oddHigh, _mm_srli_epi32(hi, 16));
+      }
+
+      // Clipping is rare, only chunks reaching the limits are counted
+      auto clipped = zero;
+      const auto limits =
+        _mm_or_si128(_mm_cmpeq_epi16(max, upper), _mm_cmpeq_epi16(min, lower));
+      if (_mm_movemask_epi8(limits) != 0)
+      {
+        for (auto j = chunkBegin; j < chunkEnd; j += kWidth)
+        {
+          const auto x = load(samples + j);
+          clipped = _mm_sub_epi16(clipped, _mm_cmpeq_epi16(x, upper));
+          clipped = _mm_sub_epi16(clipped, _mm_cmpeq_epi16(x, lower));
+        }
+      }
+
+      int16_t maxs[kWidth];
+      int16_t mins[kWidth];
+      uint16_t clips[kWidth];
+      uint32_t lows[2][kWidth / 2];
+      uint32_t highs[2][kWidth / 2];
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(maxs), max);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(mins), min);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(clips), clipped);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(lows[0]), evenLow);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(lows[1]), oddLow);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(highs[0]), evenHigh);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(highs[1]), oddHigh);
+      for (uint32_t lane = 0; lane < kWidth; ++lane)
+      {
+        auto& levels = lane % 2 == 0 ? even : odd;
+        const auto parity = lane % 2;
+        levels.max = std::max<int32_t>(levels.max, maxs[lane]);
+        levels.min = std::min<int32_t>(levels.min, mins[lane]);
+        levels.numClipped += clips[lane];
+        levels.sumOfSquares +=
+          uint64_t{lows[parity][lane / 2]} + (uint64_t{highs[parity][lane / 2]} << 16);
+      }
+    }
+    Scalar::meter(numSamples - i, samples + i, even, odd);
+  }
+
+  template <typename T>
+  static bool isSilent(const uint32_t numSamples, const T* input, const int16_t threshold)
+  {
+    const auto upper = _mm_set1_epi16(threshold);
+    const auto lower = _mm_set1_epi16(static_cast<int16_t>(-threshold));
+    uint32_t i = 0;
+    // Branch once per group of blocks on their range
+    for (; i + kSilenceGroupSize * kWidth + kLoadPadding<T> <= numSamples;
+         i += kSilenceGroupSize * kWidth)
+    {
+      auto max = convertBlock(input + i);
+      auto min = max;
+      for (uint32_t j = 1; j < kSilenceGroupSize; ++j)
+      {
+        const auto x = convertBlock(input + i + j * kWidth);
+        max = _mm_max_epi16(max, x);
+        min = _mm_min_epi16(min, x);
+      }
+      const auto loud =
+        _mm_or_si128(_mm_cmpgt_epi16(max, upper), _mm_cmplt_epi16(min, lower));
+      if (_mm_movemask_epi8(loud) != 0)
+      {
+        return false;
+      }
+    }
+    for (; i + kWidth + kLoadPadding<T> <= numSamples; i += kWidth)
+    {
+      const auto x = convertBlock(input + i);
+      const auto loud = _mm_or_si128(_mm_cmpgt_epi16(x, upper), _mm_cmplt_epi16(x, lower));
+      if (_mm_movemask_epi8(loud) != 0)
+      {
+        return false;
+      }
+    }
+    return Scalar::isSilent(numSamples - i, input + i, threshold);
+  }
+
+  // Floats are scaled but not clamped before comparing them. |scaled| <
+  // threshold + 1 holds exactly when the truncated sample is within the
+  // threshold. Only the largest threshold also admits the positive samples
+  // saturating to it.
+  static bool isSilent(const uint32_t numSamples, const float* input, const int16_t threshold)
+  {
+    if (threshold == 32767)
+    {
+      return isSilent<float>(numSamples, input, threshold);
+    }
+    const auto bound = _mm_set1_ps(static_cast<float>(threshold + 1));
+    const auto negative = _mm_set1_ps(32768.0f);
+    const auto positive = _mm_set1_ps(32767.0f);
+    const auto magnitude = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    uint32_t i = 0;
+    for (; i + kSilenceGroupSize * 4 <= numSamples; i += kSilenceGroupSize * 4)
+    {
+      // Not less than also catches NaN, which converts to the negative limit
+      auto loud = _mm_setzero_ps();
+      for (uint32_t j = 0; j < kSilenceGroupSize; ++j)
+      {
+        const auto x = _mm_loadu_ps(input + i + j * 4);
+        const auto scaled =
+          _mm_and_ps(_mm_mul_ps(x, signScale(x, negative, positive)), magnitude);
+        loud = _mm_or_ps(loud, _mm_cmpnlt_ps(scaled, bound));
+      }
+      if (_mm_movemask_ps(loud) != 0)
+      {
+        return false;
+      }
+    }
+    return Scalar::isSilent(numSamples - i, input + i, threshold);
+  }
+
+  // Scale four int32 samples and store them as float or saturated int32.
+  // Float samples are normalized like ToFloat first.
+  static void store(float* output, const __m128i samples, const __m128 scale)
+  {
+    const auto x = _mm_cvtepi32_ps(samples);
+    const auto normalized =
+      _mm_div_ps(x, signScale(x, _mm_set1_ps(32768.0f), _mm_set1_ps(32767.0f)));
+    _mm_storeu_ps(output, _mm_mul_ps(normalized, scale));
+  }
+
+  static void store(int32_t* output, const __m128i samples, const __m128 scale)
+  {
+    const auto scaled = _mm_mul_ps(_mm_cvtepi32_ps(samples), scale);
+    const auto clamped = _mm_min_ps(_mm_max_ps(scaled, _mm_set1_ps(-2147483648.0f)),
+                                    _mm_set1_ps(2147483520.0f));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_cvttps_epi32(clamped));
+  }
+
+  template <typename U>
+  static void expand(const uint32_t numSamples,
+                     const int16_t* input,
+                     U* output,
+                     const float scale)
+  {
+    uint32_t i = 0;
+    if constexpr (std::is_same_v<U, int32_t>)
+    {
+      // Without gain, int32 samples are the 16-bit samples in the upper half
+      if (scale == ExpansionScale<int32_t>(1.0f))
+      {
+        const auto zero = _mm_setzero_si128();
+        for (; i + kWidth <= numSamples; i += kWidth)
+        {
+          const auto x = load(input + i);
+          auto* out = reinterpret_cast<__m128i*>(output + i);
+          _mm_storeu_si128(out, _mm_unpacklo_epi16(zero, x));
+          _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(zero, x));
+        }
+        return Scalar::expand(numSamples - i, input + i, output + i, scale);
+      }
+    }
+
+    const auto factor = _mm_set1_ps(scale);
+    for (; i + kWidth <= numSamples; i += kWidth)
+    {
+      // Unpacking a vector with itself puts each sample in the upper half of a
+      // 32-bit word, the arithmetic shift sign extends it
+      const auto x = load(input + i);
+      store(output + i, _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16), factor);
+      store(output + i + 4, _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16), factor);
+    }
+    Scalar::expand(numSamples - i, input + i, output + i, scale);
+  }
+
+  template <typename U>
+  static void deinterleave(const uint32_t numFrames,
+                           const int16_t* input,
+                           U* left,
+                           U* right,
+                           const float scale)
+  {
+    uint32_t frame = 0;
+    if constexpr (std::is_same_v<U, int32_t>)
+    {
+      if (scale == ExpansionScale<int32_t>(1.0f))
+      {
+        const auto mask = _mm_set1_epi32(static_cast<int32_t>(0xFFFF0000u));
+        for (; frame + 4 <= numFrames; frame += 4)
+        {
+          const auto x = load(input + 2 * frame);
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(left + frame), _mm_slli_epi32(x, 16));
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(right + frame), _mm_and_si128(x, mask));
+        }
+        return Scalar::deinterleave(
+          numFrames - frame, input + 2 * frame, left + frame, right + frame, scale);
+      }
+    }
+
+    const auto factor = _mm_set1_ps(scale);
+    for (; frame + kWidth <= numFrames; frame += kWidth)
+    {
+      // Each 32-bit word holds a frame, left in the lower half
+      const auto lo = load(input + 2 * frame);
+      const auto hi = load(input + 2 * frame + kWidth);
+      store(left + frame, _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16), factor);
+      store(left + frame + 4, _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16), factor);
+      store(right + frame, _mm_srai_epi32(lo, 16), factor);
+      store(right + frame + 4, _mm_srai_epi32(hi, 16), factor);
+    }
+    Scalar::deinterleave(
+      numFrames - frame, input + 2 * frame, left + frame, right + frame, scale);
+  }
+
+  // Two vectors per step, all loaded before the first store, since stores to
+  // the sums could alias the input as far as the compiler knows
+  static void accumulate(const uint32_t numOutputChannels,
+                         const uint32_t numFrames,
+                         const float* input,
+                         const float leftGain,
+                         const float rightGain,
+                         float* left,
+                         float* right)
+  {
+    const auto leftFactor = _mm_set1_ps(leftGain);
+    const auto rightFactor = _mm_set1_ps(rightGain);
+    uint32_t frame = 0;
+    if (numOutputChannels == 2)
+    {
+      for (; frame + 8 <= numFrames; frame += 8)
+      {
+        const auto x0 = _mm_loadu_ps(input + frame);
+        const auto x1 = _mm_loadu_ps(input + frame + 4);
+        const auto l0 = _mm_add_ps(_mm_loadu_ps(left + frame), _mm_mul_ps(leftFactor, x0));
+        const auto l1 = _mm_add_ps(_mm_loadu_ps(left + frame + 4), _mm_mul_ps(leftFactor, x1));
+        const auto r0 = _mm_add_ps(_mm_loadu_ps(right + frame), _mm_mul_ps(rightFactor, x0));
+        const auto r1 = _mm_add_ps(_mm_loadu_ps(right + frame + 4), _mm_mul_ps(rightFactor, x1));
+        _mm_storeu_ps(left + frame, l0);
+        _mm_storeu_ps(left + frame + 4, l1);
+        _mm_storeu_ps(right + frame, r0);
+        _mm_storeu_ps(right + frame + 4, r1);
+      }
+    }
+    else
+    {
+      for (; frame + 8 <= numFrames; frame += 8)
+      {
+        const auto x0 = _mm_loadu_ps(input + frame);
+        const auto x1 = _mm_loadu_ps(input + frame + 4);
+        const auto l0 = _mm_add_ps(_mm_loadu_ps(left + frame), _mm_mul_ps(leftFactor, x0));
+        const auto l1 = _mm_add_ps(_mm_loadu_ps(left + frame + 4), _mm_mul_ps(leftFactor, x1));
+        _mm_storeu_ps(left + frame, l0);
+        _mm_storeu_ps(left + frame + 4, l1);
+      }
+    }
+    Scalar::accumulate(numOutputChannels,
+                       numFrames - frame,
+                       input + frame,
+                       leftGain,
+                       rightGain,
+                       left + frame,
+                       right + frame);
+  }
+};
+
+#endif
+
+#if defined(LINK_KIT_SIMD_AVX2)
+
+// AVX2 code is compiled with a function level target attribute so that it can
+// be shipped alongside the baseline kernels. It must only be called on CPUs
+// supporting AVX2.
+struct Avx2
+{
+  static constexpr uint32_t kWidth = 16;
+
+  LINK_KIT_TARGET_AVX2 static __m256i load(const void* input)
+  {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input));
+  }
+
+  // _mm256_packs_epi32 packs within 128-bit lanes, the permutation restores
+  // sample order
+  LINK_KIT_TARGET_AVX2 static __m256i pack(const __m256i lo, const __m256i hi)
+  {
+    return _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xD8);
+  }
+
+  LINK_KIT_TARGET_AVX2 static __m256i fromInt32(const __m256i lo, const __m256i hi)
+  {
+    return pack(_mm256_srai_epi32(lo, 16), _mm256_srai_epi32(hi, 16));
+  }
+
+  LINK_KIT_TARGET_AVX2 static __m256i toInt32(const __m256 input, rounding::Truncate)
+  {
+    return _mm256_cvttps_epi32(input);
+  }
+
+  LINK_KIT_TARGET_AVX2 static __m256i toInt32(const __m256 input, rounding::Nearest)
+  {
+    return _mm256_cvtps_epi32(input);
+  }
+
+  // See Sse2::signScale
+  LINK_KIT_TARGET_AVX2 static __m256 signScale(const __m256 input,
+                                               const __m256 negative,
+                                               const __m256 positive)
+  {
+    return _mm256_blendv_ps(
+      positive, negative, _mm256_cmp_ps(input, _mm256_setzero_ps(), _CMP_LT_OQ));
+  }
+
+  LINK_KIT_TARGET_AVX2 static __m256 scaleFloat(const __m256 input)
+  {
+    const auto clamped =
+      _mm256_min_ps(_mm256_max_ps(input, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
+    return _mm256_mul_ps(
+      clamped, signScale(clamped, _mm256_set1_ps(32768.0f), _mm256_set1_ps(32767.0f)));
+  }
+
+  template <typename Rounding>
+  LINK_KIT_TARGET_AVX2 static __m256i fromFloat(const __m256 lo,
+                                                const __m256 hi,
+                                                Rounding rounding)
+  {
+    return pack(toInt32(scaleFloat(lo), rounding), toInt32(scaleFloat(hi), rounding));
+  }
+
+  LINK_KIT_TARGET_AVX2 static __m256i swapBytes16(const __m256i input)
+  {
+    const auto order = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12,
+                                        15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10,
+                                        13, 12, 15, 14);
+    return _mm256_shuffle_epi8(input, order);
+  }
+
+  LINK_KIT_TARGET_AVX2 static __m256i swapBytes32(const __m256i input)
+  {
+    const auto order = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14,
+                                        13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8,
+                                        15, 14, 13, 12);
+    return _mm256_shuffle_epi8(input, order);
+  }
+
+  LINK_KIT_TARGET_AVX2 static __m256i convertBlock(const int16_t* input, rounding::Truncate = {})
+  {
+    return load(input);
+  }
+
+  LINK_KIT_TARGET_AVX2 static __m256i convertBlock(const uint16_t* input, rounding::Truncate = {})
+  {
+    return _mm256_xor_si256(load(input), _mm256_set1_epi16(static_cast<int16_t>(0x8000)));
+  }
+
+  LINK_KIT_TARGET_AVX2 static __m256i convertBlock(const int32_t* input, rounding::Truncate = {})
+  {
+    return fromInt32(load(input), load(input + 8));
+  }
+
+  LINK_KIT_TARGET_AVX2 static __m256i convertBlock(const uint32_t* input, rounding::Truncate = {})
+  {
+    const auto bias = _mm256_set1_epi32(static_cast<int32_t>(0x80000000u));
+    return fromInt32(
+      _mm256_xor_si256(load(input), bias), _mm256_xor_si256(load(input + 8), bias));
+  }
+
+  template <typename Rounding = rounding::Truncate>
+  LINK_KIT_TARGET_AVX2 static __m256i convertBlock(const float* input,
+                                                   Rounding rounding = {})
+  {
+    return fromFloat(_mm256_loadu_ps(input), _mm256_loadu_ps(input + 8), rounding);
+  }
+
+  // Eight samples, narrowed to float
+  LINK_KIT_TARGET_AVX2 static __m256 narrowFloat64(const double* input)
+  {
+    const auto lo = _mm256_cvtpd_ps(_mm256_loadu_pd(input));
+    const auto hi = _mm256_cvtpd_ps(_mm256_loadu_pd(input + 4));
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+  }
+
+  LINK_KIT_TARGET_AVX2 static __m256i convertBlock(const double* input, rounding::Truncate = {})
+  {
+    return fromFloat(narrowFloat64(input), narrowFloat64(input + 8), rounding::Truncate{});
+  }
+
+  // Eight samples shifted to the upper 24 bits of 32-bit words. Each 128-bit
+  // lane loads four samples and shuffles their bytes into place. Reads four
+  // bytes past the eight samples.
+  LINK_KIT_TARGET_AVX2 static __m256i unpackInt24(const PackedInt24* input)
+  {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(input);
+    const auto samples = _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes))),
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + 12)),
+      1);
+    const auto order = _mm256_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10,
+                                        11, -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1,
+                                        9, 10, 11);
+    return _mm256_shuffle_epi8(samples, order);
+  }
+
+  LINK_KIT_TARGET_AVX2 static __m256i convertBlock(const PackedInt24* input,
+                                                   rounding::Truncate = {})
+  {
+    return fromInt32(unpackInt24(input), unpackInt24(input + 8));
+  }
+
+  LINK_KIT_TARGET_AVX2 static __m256i convertBlock(const LowAlignedInt24* input,
+                                                   rounding::Truncate = {})
+  {
+    return fromInt32(
+      _mm256_slli_epi32(load(input), 8), _mm256_slli_epi32(load(input + 8), 8));
+  }
+
+  LINK_KIT_TARGET_AVX2 static __m256i convertBlock(const Fixed824* input,
+                                                   rounding::Truncate = {})
+  {
+    return pack(_mm256_srai_epi32(load(input), 9), _mm256_srai_epi32(load(input + 8), 9));
+  }
+
+  LINK_KIT_TARGET_AVX2 static __m256i convertBlock(const BigEndian<int16_t>* input,
+                                                   rounding::Truncate = {})
+  {
+    return swapBytes16(load(input));
+  }
+
+  LINK_KIT_TARGET_AVX2 static __m256i convertBlock(const BigEndian<int32_t>* input,
+                                                   rounding::Truncate = {})
+  {
+    return fromInt32(swapBytes32(load(input)), swapBytes32(load(input + 8)));
+  }
+
+  LINK_KIT_TARGET_AVX2 static __m256i convertBlock(const BigEndian<float>* input,
+                                                   rounding::Truncate = {})
+  {
+    return fromFloat(_mm256_castsi256_ps(swapBytes32(load(input))),
+                     _mm256_castsi256_ps(swapBytes32(load(input + 8))),
+                     rounding::Truncate{});
+  }
+
+  template <typename T, typename Rounding = rounding::Truncate>
+  LINK_KIT_TARGET_AVX2 static void convert(const uint32_t numSamples,
+                                           const T* input,
+                                           int16_t* output)
+  {
+    uint32_t i = 0;
+    for (; i + kWidth + kLoadPadding<T> <= numSamples; i += kWidth)
+    {
+      _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(output + i), convertBlock(input + i, Rounding{}));
+    }
+    Scalar::convert<T, Rounding>(numSamples - i, input + i, output + i);
+  }
+
+  template <typename T, typename Rounding = rounding::Truncate>
+  LINK_KIT_TARGET_AVX2 static void interleave(const uint32_t numFrames,
+                                              const T* left,
+                                              const T* right,
+                                              int16_t* output)
+  {
+    uint32_t frame = 0;
+    for (; frame + kWidth + kLoadPadding<T> <= numFrames; frame += kWidth)
+    {
+      const auto l = convertBlock(left + frame, Rounding{});
+      const auto r = convertBlock(right + frame, Rounding{});
+      const auto lo = _mm256_unpacklo_epi16(l, r);
+      const auto hi = _mm256_unpackhi_epi16(l, r);
+      auto* out = reinterpret_cast<__m256i*>(output + 2 * frame);
+      _mm256_storeu_si256(out, _mm256_permute2x128_si256(lo, hi, 0x20));
+      _mm256_storeu_si256(out + 1, _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+    Scalar::interleave<T, Rounding>(
+      numFrames - frame, left + frame, right + frame, output + 2 * frame);
+  }
+
+  // Like Sse2::meter
+  LINK_KIT_TARGET_AVX2 static void meter(const uint32_t numSamples,
+                                         const int16_t* samples,
+                                         SampleLevels& even,
+                                         SampleLevels& odd)
+  {
+    static_assert(kMeterChunkSize / kWidth < 1 << 16, "Meter chunks overflow 16-bit lanes");
+    const auto zero = _mm256_setzero_si256();
+    const auto lowHalf = _mm256_set1_epi32(0xFFFF);
+    const auto upper = _mm256_set1_epi16(32767);
+    const auto lower = _mm256_set1_epi16(-32768);
+    const auto numVectorSamples = numSamples - numSamples % kWidth;
+    uint32_t i = 0;
+    while (i < numVectorSamples)
+    {
+      const auto chunkBegin = i;
+      const auto chunkEnd = i + std::min(numVectorSamples - i, kMeterChunkSize);
+      auto max = zero;
+      auto min = zero;
+      auto evenLow = zero;
+      auto evenHigh = zero;
+      auto oddLow = zero;
+      auto oddHigh = zero;
+      for (; i < chunkEnd; i += kWidth)
+      {
+        const auto x = load(samples + i);
+        max = _mm256_max_epi16(max, x);
+        min = _mm256_min_epi16(min, x);
+        const auto lo = _mm256_mullo_epi16(x, x);
+        const auto hi = _mm256_mulhi_epi16(x, x);
+        evenLow = _mm256_add_epi32(evenLow, _mm256_and_si256(lo, lowHalf));
+        evenHigh = _mm256_add_epi32(evenHigh, _mm256_and_si256(hi, lowHalf));
+        oddLow = _mm256_add_epi32(oddLow, _mm256_srli_epi32(lo, 16));
+        oddHigh = _mm256_add_epi32(oddHigh, _mm256_srli_epi32(hi, 16));
+      }
+
+      // Clipping is rare, only chunks reaching the limits are counted
+      auto clipped = zero;
+      const auto limits =
+        _mm256_or_si256(_mm256_cmpeq_epi16(max, upper), _mm256_cmpeq_epi16(min, lower));
+      if (_mm256_movemask_epi8(limits) != 0)
+      {
+        for (auto j = chunkBegin; j < chunkEnd; j += kWidth)
+        {
+          const auto x = load(samples + j);
+          clipped = _mm256_sub_epi16(clipped, _mm256_cmpeq_epi16(x, upper));
+          clipped = _mm256_sub_epi16(clipped, _mm256_cmpeq_epi16(x, lower));
+        }
+      }
+
+      int16_t maxs[kWidth];
+      int16_t mins[kWidth];
+      uint16_t clips[kWidth];
+      uint32_t lows[2][kWidth / 2];
+      uint32_t highs[2][kWidth / 2];
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(maxs), max);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(mins), min);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(clips), clipped);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(lows[0]), evenLow);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(lows[1]), oddLow);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(highs[0]), evenHigh);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(highs[1]), oddHigh);
+      for (uint32_t lane = 0; lane < kWidth; ++lane)
+      {
+        auto& levels = lane % 2 == 0 ? even : odd;
+        const auto parity = lane % 2;
+        levels.max = std::max<int32_t>(levels.max, maxs[lane]);
+        levels.min = std::min<int32_t>(levels.min, mins[lane]);
+        levels.numClipped += clips[lane];
+        levels.sumOfSquares +=
+          uint64_t{lows[parity][lane / 2]} + (uint64_t{highs[parity][lane / 2]} << 16);
+      }
+    }
+    Scalar::meter(numSamples - i, samples + i, even, odd);
+  }
+
+  template <typename T>
+  LINK_KIT_TARGET_AVX2 static bool isSilent(const uint32_t numSamples,
+                                            const T* input,
+                                            const int16_t threshold)
+  {
+    const auto upper = _mm256_set1_epi16(threshold);
+    const auto lower = _mm256_set1_epi16(static_cast<int16_t>(-threshold));
+    uint32_t i = 0;
+    for (; i + kSilenceGroupSize * kWidth + kLoadPadding<T> <= numSamples;
+         i += kSilenceGroupSize * kWidth)
+    {
+      auto max = convertBlock(input + i);
+      auto min = max;
+      for (uint32_t j = 1; j < kSilenceGroupSize; ++j)
+      {
+        const auto x = convertBlock(input + i + j * kWidth);
+        max = _mm256_max_epi16(max, x);
+        min = _mm256_min_epi16(min, x);
+      }
+      const auto loud =
+        _mm256_or_si256(_mm256_cmpgt_epi16(max, upper), _mm256_cmpgt_epi16(lower, min));
+      if (_mm256_movemask_epi8(loud) != 0)
+      {
+        return false;
+      }
+    }
+    for (; i + kWidth + kLoadPadding<T> <= numSamples; i += kWidth)
+    {
+      const auto x = convertBlock(input + i);
+      const auto loud =
+        _mm256_or_si256(_mm256_cmpgt_epi16(x, upper), _mm256_cmpgt_epi16(lower, x));
+      if (_mm256_movemask_epi8(loud) != 0)
+      {
+        return false;
+      }
+    }
+    return Scalar::isSilent(numSamples - i, input + i, threshold);
+  }
+
+  // See Sse2::isSilent for floats
+  LINK_KIT_TARGET_AVX2 static bool isSilent(const uint32_t numSamples,
+                                            const float* input,
+                                            const int16_t threshold)
+  {
+    if (threshold == 32767)
+    {
+      return isSilent<float>(numSamples, input, threshold);
+    }
+    const auto bound = _mm256_set1_ps(static_cast<float>(threshold + 1));
+    const auto negative = _mm256_set1_ps(32768.0f);
+    const auto positive = _mm256_set1_ps(32767.0f);
+    const auto magnitude = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    uint32_t i = 0;
+    for (; i + kSilenceGroupSize * 8 <= numSamples; i += kSilenceGroupSize * 8)
+    {
+      auto loud = _mm256_setzero_ps();
+      for (uint32_t j = 0; j < kSilenceGroupSize; ++j)
+      {
+        const auto x = _mm256_loadu_ps(input + i + j * 8);
+        const auto scaled =
+          _mm256_and_ps(_mm256_mul_ps(x, signScale(x, negative, positive)), magnitude);
+        loud = _mm256_or_ps(loud, _mm256_cmp_ps(scaled, bound, _CMP_NLT_UQ));
+      }
+      if (_mm256_movemask_ps(loud) != 0)
+      {
+        return false;
+      }
+    }
+    return Scalar::isSilent(numSamples - i, input + i, threshold);
+  }
+
+  LINK_KIT_TARGET_AVX2 static void store(float* output,
+                                         const __m256i samples,
+                                         const __m256 scale)
+  {
+    const auto x = _mm256_cvtepi32_ps(samples);
+    const auto normalized = _mm256_div_ps(
+      x, signScale(x, _mm256_set1_ps(32768.0f), _mm256_set1_ps(32767.0f)));
+    _mm256_storeu_ps(output, _mm256_mul_ps(normalized, scale));
+  }
+
+  LINK_KIT_TARGET_AVX2 static void store(int32_t* output,
+                                         const __m256i samples,
+                                         const __m256 scale)
+  {
+    const auto scaled = _mm256_mul_ps(_mm256_cvtepi32_ps(samples), scale);
+    const auto clamped =
+      _mm256_min_ps(_mm256_max_ps(scaled, _mm256_set1_ps(-2147483648.0f)),
+                    _mm256_set1_ps(2147483520.0f));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), _mm256_cvttps_epi32(clamped));
+  }
+
+  template <typename U>
+  LINK_KIT_TARGET_AVX2 static void expand(const uint32_t numSamples,
+                                          const int16_t* input,
+                                          U* output,
+                                          const float scale)
+  {
+    uint32_t i = 0;
+    if constexpr (std::is_same_v<U, int32_t>)
+    {
+      if (scale == ExpansionScale<int32_t>(1.0f))
+      {
+        for (; i + kWidth <= numSamples; i += kWidth)
+        {
+          const auto x = load(input + i);
+          auto* out = reinterpret_cast<__m256i*>(output + i);
+          _mm256_storeu_si256(
+            out, _mm256_slli_epi32(_mm256_cvtepi16_epi32(_mm256_castsi256_si128(x)), 16));
+          _mm256_storeu_si256(
+            out + 1, _mm256_slli_epi32(_mm256_cvtepi16_epi32(_mm256_extracti128_si256(x, 1)), 16));
+        }
+        return Scalar::expand(numSamples - i, input + i, output + i, scale);
+      }
+    }
+
+    const auto factor = _mm256_set1_ps(scale);
+    for (; i + kWidth <= numSamples; i += kWidth)
+    {
+      const auto x = load(input + i);
+      store(output + i, _mm256_cvtepi16_epi32(_mm256_castsi256_si128(x)), factor);
+      store(output + i + 8, _mm256_cvtepi16_epi32(_mm256_extracti128_si256(x, 1)), factor);
+    }
+    Scalar::expand(numSamples - i, input + i, output + i, scale);
+  }
+
+  template <typename U>
+  LINK_KIT_TARGET_AVX2 static void deinterleave(const uint32_t numFrames,
+                                                const int16_t* input,
+                                                U* left,
+                                                U* right,
+                                                const float scale)
+  {
+    uint32_t frame = 0;
+    if constexpr (std::is_same_v<U, int32_t>)
+    {
+      if (scale == ExpansionScale<int32_t>(1.0f))
+      {
+        const auto mask = _mm256_set1_epi32(static_cast<int32_t>(0xFFFF0000u));
+        for (; frame + 8 <= numFrames; frame += 8)
+        {
+          const auto x = load(input + 2 * frame);
+          _mm256_storeu_si256(reinterpret_cast<__m256i*>(left + frame), _mm256_slli_epi32(x, 16));
+          _mm256_storeu_si256(reinterpret_cast<__m256i*>(right + frame),
+                              _mm256_and_si256(x, mask));
+        }
+        return Scalar::deinterleave(
+          numFrames - frame, input + 2 * frame, left + frame, right + frame, scale);
+      }
+    }
+
+    const auto factor = _mm256_set1_ps(scale);
+    for (; frame + 8 <= numFrames; frame += 8)
+    {
+      // Each 32-bit word holds a frame, left in the lower half
+      const auto x = load(input + 2 * frame);
+      store(left + frame, _mm256_srai_epi32(_mm256_slli_epi32(x, 16), 16), factor);
+      store(right + frame, _mm256_srai_epi32(x, 16), factor);
+    }
+    Scalar::deinterleave(
+      numFrames - frame, input + 2 * frame, left + frame, right + frame, scale);
+  }
+
+  LINK_KIT_TARGET_AVX2 static void accumulate(const uint32_t numOutputChannels,
+                                              const uint32_t numFrames,
+                                              const float* input,
+                                              const float leftGain,
+                                              const float rightGain,
+                                              float* left,
+                                              float* right)
+  {
+    const auto leftFactor = _mm256_set1_ps(leftGain);
+    const auto rightFactor = _mm256_set1_ps(rightGain);
+    uint32_t frame = 0;
+    if (numOutputChannels == 2)
+    {
+      for (; frame + 8 <= numFrames; frame += 8)
+      {
+        const auto x = _mm256_loadu_ps(input + frame);
+        const auto leftProduct = _mm256_mul_ps(leftFactor, x);
+        _mm256_storeu_ps(left + frame, _mm256_add_ps(_mm256_loadu_ps(left + frame), leftProduct));
+        const auto rightProduct = _mm256_mul_ps(rightFactor, x);
+        _mm256_storeu_ps(right + frame,
+                         _mm256_add_ps(_mm256_loadu_ps(right + frame), rightProduct));
+      }
+    }
+    else
+    {
+      for (; frame + 8 <= numFrames; frame += 8)
+      {
+        const auto x = _mm256_loadu_ps(input + frame);
+        const auto leftProduct = _mm256_mul_ps(leftFactor, x);
+        _mm256_storeu_ps(left + frame, _mm256_add_ps(_mm256_loadu_ps(left + frame), leftProduct));
+      }
+    }
+    Scalar::accumulate(numOutputChannels,
+                       numFrames - frame,
+                       input + frame,
+                       leftGain,
+                       rightGain,
+                       left + frame,
+                       right + frame);
+  }
+};
+
+#endif
+
+#if defined(LINK_KIT_SIMD_NEON)
+
+struct Neon
+{
+  static constexpr uint32_t kWidth = 8;
+
+  static uint8x16_t loadBytes(const void* input)
+  {
+    return vld1q_u8(reinterpret_cast<const uint8_t*>(input));
+  }
+
+  static int16x8_t convertBlock(const int16_t* input, rounding::Truncate = {})
+  {
+    return vld1q_s16(input);
+  }
+
+  static int16x8_t convertBlock(const uint16_t* input, rounding::Truncate = {})
+  {
+    return vreinterpretq_s16_u16(veorq_u16(vld1q_u16(input), vdupq_n_u16(0x8000)));
+  }
+
+  static int16x8_t fromInt32(const int32x4_t lo, const int32x4_t hi)
+  {
+    return vcombine_s16(vshrn_n_s32(lo, 16), vshrn_n_s32(hi, 16));
+  }
+
+  static int16x8_t convertBlock(const int32_t* input, rounding::Truncate = {})
+  {
+    return fromInt32(vld1q_s32(input), vld1q_s32(input + 4));
+  }
+
+  static int16x8_t convertBlock(const uint32_t* input, rounding::Truncate = {})
+  {
+    const auto bias = vdupq_n_u32(0x80000000u);
+    const auto lo = vreinterpretq_s32_u32(veorq_u32(vld1q_u32(input), bias));
+    const auto hi = vreinterpretq_s32_u32(veorq_u32(vld1q_u32(input + 4), bias));
+    return fromInt32(lo, hi);
+  }
+
+  static int32x4_t toInt32(const float32x4_t input, rounding::Truncate)
+  {
+    return vcvtq_s32_f32(input);
+  }
+
+  static int32x4_t toInt32(const float32x4_t input, rounding::Nearest)
+  {
+    return vcvtnq_s32_f32(input);
+  }
+
+  // See Sse2::signScale
+  static float32x4_t signScale(const float32x4_t input,
+                               const float32x4_t negative,
+                               const float32x4_t positive)
+  {
+    return vbslq_f32(vcltzq_f32(input), negative, positive);
+  }
+
+  // Vector ScaleFloat
+  static float32x4_t scaleFloat(const float32x4_t input)
+  {
+    const auto clamped =
+      vminnmq_f32(vmaxnmq_f32(input, vdupq_n_f32(-1.0f)), vdupq_n_f32(1.0f));
+    return vmulq_f32(
+      clamped, signScale(clamped, vdupq_n_f32(32768.0f), vdupq_n_f32(32767.0f)));
+  }
+
+  template <typename Rounding>
+  static int16x4_t convertHalf(const float32x4_t input, Rounding rounding)
+  {
+    return vmovn_s32(toInt32(scaleFloat(input), rounding));
+  }
+
+  template <typename Rounding = rounding::Truncate>
+  static int16x8_t convertBlock(const float* input, Rounding rounding = {})
+  {
+    return vcombine_s16(convertHalf(vld1q_f32(input), rounding),
+                        convertHalf(vld1q_f32(input + 4), rounding));
+  }
+
+  // Four samples, narrowed to float
+  static float32x4_t narrowFloat64(const double* input)
+  {
+    return vcombine_f32(vcvt_f32_f64(vld1q_f64(input)), vcvt_f32_f64(vld1q_f64(input + 2)));
+  }
+
+  static int16x8_t convertBlock(const double* input, rounding::Truncate = {})
+  {
+    return vcombine_s16(convertHalf(narrowFloat64(input), rounding::Truncate{}),
+                        convertHalf(narrowFloat64(input + 4), rounding::Truncate{}));
+  }
+
+  // vld3 splits the three bytes of each sample into separate registers, the
+  // upper two form the 16-bit result
+  static int16x8_t convertBlock(const PackedInt24* input, rounding::Truncate = {})
+  {
+    const auto bytes = vld3_u8(reinterpret_cast<const uint8_t*>(input));
+    return vreinterpretq_s16_u16(
+      vorrq_u16(vshll_n_u8(bytes.val[2], 8), vmovl_u8(bytes.val[1])));
+  }
+
+  static int16x8_t convertBlock(const LowAlignedInt24* input, rounding::Truncate = {})
+  {
+    const auto* values = reinterpret_cast<const int32_t*>(input);
+    return fromInt32(
+      vshlq_n_s32(vld1q_s32(values), 8), vshlq_n_s32(vld1q_s32(values + 4), 8));
+  }
+
+  static int16x8_t convertBlock(const Fixed824* input, rounding::Truncate = {})
+  {
+    const auto* values = reinterpret_cast<const int32_t*>(input);
+    return vcombine_s16(
+      vqshrn_n_s32(vld1q_s32(values), 9), vqshrn_n_s32(vld1q_s32(values + 4), 9));
+  }
+
+  static int16x8_t convertBlock(const BigEndian<int16_t>* input, rounding::Truncate = {})
+  {
+    return vreinterpretq_s16_u8(vrev16q_u8(loadBytes(input)));
+  }
+
+  static int16x8_t convertBlock(const BigEndian<int32_t>* input, rounding::Truncate = {})
+  {
+    return fromInt32(vreinterpretq_s32_u8(vrev32q_u8(loadBytes(input))),
+                     vreinterpretq_s32_u8(vrev32q_u8(loadBytes(input + 4))));
+  }
+
+  static int16x8_t convertBlock(const BigEndian<float>* input, rounding::Truncate = {})
+  {
+    const rounding::Truncate truncate;
+    return vcombine_s16(
+      convertHalf(vreinterpretq_f32_u8(vrev32q_u8(loadBytes(input))), truncate),
+      convertHalf(vreinterpretq_f32_u8(vrev32q_u8(loadBytes(input + 4))), truncate));
+  }
+
+  template <typename T, typename Rounding = rounding::Truncate>
+  static void convert(const uint32_t numSamples, const T* input, int16_t* output)
+  {
+    uint32_t i = 0;
+    for (; i + kWidth + kLoadPadding<T> <= numSamples; i += kWidth)
+    {
+      vst1q_s16(output + i, convertBlock(input + i, Rounding{}));
+    }
+    Scalar::convert<T, Rounding>(numSamples - i, input + i, output + i);
+  }
+
+  template <typename T, typename Rounding = rounding::Truncate>
+  static void interleave(const uint32_t numFrames,
+                         const T* left,
+                         const T* right,
+                         int16_t* output)
+  {
+    uint32_t frame = 0;
+    for (; frame + kWidth + kLoadPadding<T> <= numFrames; frame += kWidth)
+    {
+      vst2q_s16(output + 2 * frame,
+                int16x8x2_t{{convertBlock(left + frame, Rounding{}),
+                             convertBlock(right + frame, Rounding{})}});
+    }
+    Scalar::interleave<T, Rounding>(
+      numFrames - frame, left + frame, right + frame, output + 2 * frame);
+  }
+
+  // vld2 splits even and odd samples into separate registers. Squares are at
+  // most 2^30, pairwise accumulation widens them to 64 bits.
+  static void meter(const uint32_t numSamples,
+                    const int16_t* samples,
+                    SampleLevels& even,
+                    SampleLevels& odd)
+  {
+    static_assert(kMeterChunkSize / kWidth < 1 << 16, "Meter chunks overflow 16-bit lanes");
+    const auto upper = vdupq_n_s16(32767);
+    const auto lower = vdupq_n_s16(-32768);
+    SampleLevels* levels[2] = {&even, &odd};
+    const auto numVectorSamples = numSamples - numSamples % (2 * kWidth);
+    uint32_t i = 0;
+    while (i < numVectorSamples)
+    {
+      const auto chunkBegin = i;
+      const auto chunkEnd = i + std::min(numVectorSamples - i, kMeterChunkSize);
+      int16x8_t max[2] = {vdupq_n_s16(0), vdupq_n_s16(0)};
+      int16x8_t min[2] = {vdupq_n_s16(0), vdupq_n_s16(0)};
+      uint64x2_t sums[2] = {vdupq_n_u64(0), vdupq_n_u64(0)};
+      for (; i < chunkEnd; i += 2 * kWidth)
+      {
+        const auto x = vld2q_s16(samples + i);
+        for (uint32_t parity = 0; parity < 2; ++parity)
+        {
+          const auto values = x.val[parity];
+          max[parity] = vmaxq_s16(max[parity], values);
+          min[parity] = vminq_s16(min[parity], values);
+          const auto lo = vmull_s16(vget_low_s16(values), vget_low_s16(values));
+          const auto hi = vmull_high_s16(values, values);
+          sums[parity] = vpadalq_u32(sums[parity], vreinterpretq_u32_s32(lo));
+          sums[parity] = vpadalq_u32(sums[parity], vreinterpretq_u32_s32(hi));
+        }
+      }
+
+      for (uint32_t parity = 0; parity < 2; ++parity)
+      {
+        const auto chunkMax = vmaxvq_s16(max[parity]);
+        const auto chunkMin = vminvq_s16(min[parity]);
+        levels[parity]->max = std::max<int32_t>(levels[parity]->max, chunkMax);
+        levels[parity]->min = std::min<int32_t>(levels[parity]->min, chunkMin);
+        levels[parity]->sumOfSquares += vaddvq_u64(sums[parity]);
+        // Clipping is rare, only chunks reaching the limits are counted
+        if (chunkMax == 32767 || chunkMin == -32768)
+        {
+          uint16x8_t clipped = vdupq_n_u16(0);
+          for (auto j = chunkBegin; j < chunkEnd; j += 2 * kWidth)
+          {
+            const auto values = vld2q_s16(samples + j).val[parity];
+            clipped = vsubq_u16(clipped, vceqq_s16(values, upper));
+            clipped = vsubq_u16(clipped, vceqq_s16(values, lower));
+          }
+          levels[parity]->numClipped += vaddlvq_u16(clipped);
+        }
+      }
+    }
+    Scalar::meter(numSamples - i, samples + i, even, odd);
+  }
+
+  template <typename T>
+  static bool isSilent(const uint32_t numSamples, const T* input, const int16_t threshold)
+  {
+    const auto upper = vdupq_n_s16(threshold);
+    const auto lower = vdupq_n_s16(static_cast<int16_t>(-threshold));
+    uint32_t i = 0;
+    for (; i + kSilenceGroupSize * kWidth + kLoadPadding<T> <= numSamples;
+         i += kSilenceGroupSize * kWidth)
+    {
+      auto max = convertBlock(input + i);
+      auto min = max;
+      for (uint32_t j = 1; j < kSilenceGroupSize; ++j)
+      {
+        const auto x = convertBlock(input + i + j * kWidth);
+        max = vmaxq_s16(max, x);
+        min = vminq_s16(min, x);
+      }
+      if (vmaxvq_u16(vorrq_u16(vcgtq_s16(max, upper), vcltq_s16(min, lower))) != 0)
+      {
+        return false;
+      }
+    }
+    for (; i + kWidth + kLoadPadding<T> <= numSamples; i += kWidth)
+    {
+      const auto x = convertBlock(input + i);
+      if (vmaxvq_u16(vorrq_u16(vcgtq_s16(x, upper), vcltq_s16(x, lower))) != 0)
+      {
+        return false;
+      }
+    }
+    return Scalar::isSilent(numSamples - i, input + i, threshold);
+  }
+
+  // See Sse2::isSilent for floats
+  static bool isSilent(const uint32_t numSamples, const float* input, const int16_t threshold)
+  {
+    if (threshold == 32767)
+    {
+      return isSilent<float>(numSamples, input, threshold);
+    }
+    const auto bound = vdupq_n_f32(static_cast<float>(threshold + 1));
+    const auto negative = vdupq_n_f32(32768.0f);
+    const auto positive = vdupq_n_f32(32767.0f);
+    uint32_t i = 0;
+    for (; i + kSilenceGroupSize * 4 <= numSamples; i += kSilenceGroupSize * 4)
+    {
+      // Absolute less than is false for NaN
+      auto quiet = vdupq_n_u32(0xFFFFFFFF);
+      for (uint32_t j = 0; j < kSilenceGroupSize; ++j)
+      {
+        const auto x = vld1q_f32(input + i + j * 4);
+        const auto scaled = vmulq_f32(x, signScale(x, negative, positive));
+        quiet = vandq_u32(quiet, vcaltq_f32(scaled, bound));
+      }
+      if (vminvq_u32(quiet) == 0)
+      {
+        return false;
+      }
+    }
+    return Scalar::isSilent(numSamples - i, input + i, threshold);
+  }
+
+  static void store(float* output, const int32x4_t samples, const float32x4_t scale)
+  {
+    const auto x = vcvtq_f32_s32(samples);
+    const auto normalized =
+      vdivq_f32(x, signScale(x, vdupq_n_f32(32768.0f), vdupq_n_f32(32767.0f)));
+    vst1q_f32(output, vmulq_f32(normalized, scale));
+  }
+
+  // vcvtq saturates by itself, but to INT32_MAX rather than the largest float
+  // below 2^31 the other loops produce
+  static void store(int32_t* output, const int32x4_t samples, const float32x4_t scale)
+  {
+    const auto scaled = vmulq_f32(vcvtq_f32_s32(samples), scale);
+    const auto clamped = vminq_f32(vmaxq_f32(scaled, vdupq_n_f32(-2147483648.0f)),
+                                   vdupq_n_f32(2147483520.0f));
+    vst1q_s32(output, vcvtq_s32_f32(clamped));
+  }
+
+  template <typename U>
+  static void expand(const uint32_t numSamples,
+                     const int16_t* input,
+                     U* output,
+                     const float scale)
+  {
+    uint32_t i = 0;
+    if constexpr (std::is_same_v<U, int32_t>)
+    {
+      if (scale == ExpansionScale<int32_t>(1.0f))
+      {
+        for (; i + kWidth <= numSamples; i += kWidth)
+        {
+          const auto x = vld1q_s16(input + i);
+          vst1q_s32(output + i, vshll_n_s16(vget_low_s16(x), 16));
+          vst1q_s32(output + i + 4, vshll_n_s16(vget_high_s16(x), 16));
+        }
+        return Scalar::expand(numSamples - i, input + i, output + i, scale);
+      }
+    }
+
+    const auto factor = vdupq_n_f32(scale);
+    for (; i + kWidth <= numSamples; i += kWidth)
+    {
+      const auto x = vld1q_s16(input + i);
+      store(output + i, vmovl_s16(vget_low_s16(x)), factor);
+      store(output + i + 4, vmovl_s16(vget_high_s16(x)), factor);
+    }
+    Scalar::expand(numSamples - i, input + i, output + i, scale);
+  }
+
+  template <typename U>
+  static void deinterleave(const uint32_t numFrames,
+                           const int16_t* input,
+                           U* left,
+                           U* right,
+                           const float scale)
+  {
+    uint32_t frame = 0;
+    if constexpr (std::is_same_v<U, int32_t>)
+    {
+      if (scale == ExpansionScale<int32_t>(1.0f))
+      {
+        for (; frame + kWidth <= numFrames; frame += kWidth)
+        {
+          const auto x = vld2q_s16(input + 2 * frame);
+          vst1q_s32(left + frame, vshll_n_s16(vget_low_s16(x.val[0]), 16));
+          vst1q_s32(left + frame + 4, vshll_n_s16(vget_high_s16(x.val[0]), 16));
+          vst1q_s32(right + frame, vshll_n_s16(vget_low_s16(x.val[1]), 16));
+          vst1q_s32(right + frame + 4, vshll_n_s16(vget_high_s16(x.val[1]), 16));
+        }
+        return Scalar::deinterleave(
+          numFrames - frame, input + 2 * frame, left + frame, right + frame, scale);
+      }
+    }
+
+    const auto factor = vdupq_n_f32(scale);
+    for (; frame + kWidth <= numFrames; frame += kWidth)
+    {
+      const auto x = vld2q_s16(input + 2 * frame);
+      store(left + frame, vmovl_s16(vget_low_s16(x.val[0])), factor);
+      store(left + frame + 4, vmovl_s16(vget_high_s16(x.val[0])), factor);
+      store(right + frame, vmovl_s16(vget_low_s16(x.val[1])), factor);
+      store(right + frame + 4, vmovl_s16(vget_high_s16(x.val[1])), factor);
+    }
+    Scalar::deinterleave(
+      numFrames - frame, input + 2 * frame, left + frame, right + frame, scale);
+  }
+
+  // Two vectors per step, all loaded before the first store, since stores to
+  // the sums could alias the input as far as the compiler knows
+  static void accumulate(const uint32_t numOutputChannels,
+                         const uint32_t numFrames,
+                         const float* input,
+                         const float leftGain,
+                         const float rightGain,
+                         float* left,
+                         float* right)
+  {
+    const auto leftFactor = vdupq_n_f32(leftGain);
+    const auto rightFactor = vdupq_n_f32(rightGain);
+    uint32_t frame = 0;
+    if (numOutputChannels == 2)
+    {
+      for (; frame + 8 <= numFrames; frame += 8)
+      {
+        const auto x0 = vld1q_f32(input + frame);
+        const auto x1 = vld1q_f32(input + frame + 4);
+        const auto l0 = vaddq_f32(vld1q_f32(left + frame), vmulq_f32(leftFactor, x0));
+        const auto l1 = vaddq_f32(vld1q_f32(left + frame + 4), vmulq_f32(leftFactor, x1));
+        const auto r0 = vaddq_f32(vld1q_f32(right + frame), vmulq_f32(rightFactor, x0));
+        const auto r1 = vaddq_f32(vld1q_f32(right + frame + 4), vmulq_f32(rightFactor, x1));
+        vst1q_f32(left + frame, l0);
+        vst1q_f32(left + frame + 4, l1);
+        vst1q_f32(right + frame, r0);
+        vst1q_f32(right + frame + 4, r1);
+      }
+    }
+    else
+    {
+      for (; frame + 8 <= numFrames; frame += 8)
+      {
+        const auto x0 = vld1q_f32(input + frame);
+        const auto x1 = vld1q_f32(input + frame + 4);
+        const auto l0 = vaddq_f32(vld1q_f32(left + frame), vmulq_f32(leftFactor, x0));
+        const auto l1 = vaddq_f32(vld1q_f32(left + frame + 4), vmulq_f32(leftFactor, x1));
+        vst1q_f32(left + frame, l0);
+        vst1q_f32(left + frame + 4, l1);
+      }
+    }
+    Scalar::accumulate(numOutputChannels,
+                       numFrames - frame,
+                       input + frame,
+                       leftGain,
+                       rightGain,
+                       left + frame,
+                       right + frame);
+  }
+};
+
+#endif
+
+// Widest instruction set enabled at compile time
+#if defined(__AVX2__)
+using Native = Avx2;
+#elif defined(LINK_KIT_SIMD_SSE2)
+using Native = Sse2;
+#elif defined(LINK_KIT_SIMD_NEON)
+using Native = Neon;
+#else
+using Native = Scalar;
+#endif
+
+} // namespace isa
+
+// Invoke fn with the isa tag corresponding to the given instruction set. This
+// turns the result of BestInstructionSet() into a kernel instantiation, e.g.
+// a function pointer that can be stored and called from the audio thread.
+template <typename Fn>
+auto WithInstructionSet(const InstructionSet instructionSet, Fn&& fn)
+{
+  switch (instructionSet)
+  {
+#if defined(LINK_KIT_SIMD_SSE2)
+  case InstructionSet::Sse2:
+    return fn(isa::Sse2{});
+  case InstructionSet::Avx2:
+    return fn(isa::Avx2{});
+#endif
+#if defined(LINK_KIT_SIMD_NEON)
+  case InstructionSet::Neon:
+    return fn(isa::Neon{});
+#endif
+  default:
+    return fn(isa::Scalar{});
+  }
+}
+
+// Copy mono buffer - converts samples from input type T to int16_t
+template <typename T, typename Isa = isa::Native>
+void CopyBufferMono(const uint32_t numFrames, const T* input, int16_t* output)
+{
+  Isa::convert(numFrames, input, output);
+}
+
+// Copy stereo non-interleaved buffer - two separate arrays for left and right
+template <typename T, typename Isa = isa::Native>
+void CopyBufferStereoNonInterleaved(const uint32_t numFrames,
+                                    const T* left,
+                                    const T* right,
+                                    int16_t* output)
+{
+  Isa::interleave(numFrames, left, right, output);
+}
+
+// Copy stereo interleaved buffer - left and right samples alternate in single
+// array
+template <typename T, typename Isa = isa::Native>
+void CopyBufferStereoInterleaved(const uint32_t numFrames,
+                                 const T* input,
+                                 int16_t* output)
+{
+  Isa::convert(numFrames * 2, input, output);
 }
 
-} // namespace ableton::link_kit
\ No newline at end of file
+} // namespace ableton::link_kit
@@ -0,0 +1,91 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+namespace ableton::link_kit
+{
+
+// Position of beats in a quantum, following Link: phases of negative beats
+// count up from the previous multiple of the quantum, and a zero quantum has
+// a zero phase
+inline double PhaseOf(const double beats, const double quantum)
+{
+  return quantum == 0.0 ? 0.0 : beats - quantum * std::floor(beats / quantum);
+}
+
+// The session timeline across one audio buffer. The tempo can't change within
+// a captured session state, so beats and host time are linear in the frame
+// index. Evaluating the timeline once per buffer leaves a multiply-add per
+// query.
+struct BufferTimeline
+{
+  double beatsAtBufferBegin = 0.0;
+  double phaseAtBufferBegin = 0.0;
+  double beatsPerFrame = 0.0;
+  double quantum = 0.0;
+  uint64_t hostTimeAtBufferBegin = 0;
+  double hostTicksPerFrame = 0.0;
+
+  double beatAtFrame(const double frame) const
+  {
+    return beatsAtBufferBegin + frame * beatsPerFrame;
+  }
+
+  double phaseAtFrame(const double frame) const
+  {
+    return PhaseOf(phaseAtBufferBegin + frame * beatsPerFrame, quantum);
+  }
+
+  // Rounded to the nearest tick
+  uint64_t hostTimeAtFrame(const double frame) const
+  {
+    return hostTimeAtBufferBegin + static_cast<uint64_t>(std::llround(frame * hostTicksPerFrame));
+  }
+
+  // Fractional frame index at which the timeline reaches a beat, may lie
+  // outside the buffer
+  double frameAtBeat(const double beats) const
+  {
+    return (beats - beatsAtBufferBegin) / beatsPerFrame;
+  }
+
+  // The timeline of the buffer starting numFrames later
+  BufferTimeline advanced(const uint32_t numFrames) const
+  {
+    auto timeline = *this;
+    timeline.beatsAtBufferBegin = beatAtFrame(numFrames);
+    timeline.phaseAtBufferBegin = phaseAtFrame(numFrames);
+    timeline.hostTimeAtBufferBegin = hostTimeAtFrame(numFrames);
+    return timeline;
+  }
+
+  // Fractional frame index of a host time, may lie outside the buffer
+  double frameAtHostTime(const uint64_t hostTime) const
+  {
+    const auto ticks = static_cast<int64_t>(hostTime - hostTimeAtBufferBegin);
+    return static_cast<double>(ticks) / hostTicksPerFrame;
+  }
+};
+
+// Tempo in beats per minute, host ticks per second as given by the clock
+inline BufferTimeline MakeBufferTimeline(const double beatsAtBufferBegin,
+                                         const double tempo,
+                                         const uint64_t hostTimeAtBufferBegin,
+                                         const double hostTicksPerSecond,
+                                         const double sampleRate,
+                                         const double quantum)
+{
+  BufferTimeline timeline;
+  timeline.beatsAtBufferBegin = beatsAtBufferBegin;
+  timeline.phaseAtBufferBegin = PhaseOf(beatsAtBufferBegin, quantum);
+  timeline.beatsPerFrame = tempo / (60.0 * sampleRate);
+  timeline.quantum = quantum;
+  timeline.hostTimeAtBufferBegin = hostTimeAtBufferBegin;
+  timeline.hostTicksPerFrame = hostTicksPerSecond / sampleRate;
+  return timeline;
+}
+
+} // namespace ableton::link_kit
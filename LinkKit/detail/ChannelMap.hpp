@@ -0,0 +1,366 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#pragma once
+
+#include "BufferConversion.hpp"
+#include "GainRamp.hpp"
+#include "Quantizer.hpp"
+#include "Resampler.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <type_traits>
+
+namespace ableton::link_kit
+{
+
+// Describes how the channels of an input buffer are reduced to the one or two
+// channels sent by a sink. Each output channel is a weighted sum of input
+// channels. Maps that only route input channels to outputs with unity gain are
+// flagged as such and converted without a float round trip.
+struct ChannelMap
+{
+  static constexpr uint32_t kMaxInputChannels = 64;
+  static constexpr uint32_t kMaxOutputChannels = 2;
+
+  // Number of input channels the map reads from
+  uint32_t numInputChannels = 0;
+  uint32_t numOutputChannels = 0;
+  // gains[output][input]
+  std::array<std::array<float, kMaxInputChannels>, kMaxOutputChannels> gains{};
+  // Input channel feeding each output if isRouting is set
+  std::array<uint32_t, kMaxOutputChannels> sources{};
+  bool isRouting = false;
+};
+
+// Route the given input channels to the outputs, one input channel per output
+inline std::optional<ChannelMap> MakeChannelSelection(const uint32_t* inputChannels,
+                                                      const uint32_t numOutputChannels)
+{
+  if (numOutputChannels == 0 || numOutputChannels > ChannelMap::kMaxOutputChannels)
+  {
+    return std::nullopt;
+  }
+
+  ChannelMap map;
+  map.numOutputChannels = numOutputChannels;
+  map.isRouting = true;
+  for (uint32_t output = 0; output < numOutputChannels; ++output)
+  {
+    const auto input = inputChannels[output];
+    if (input >= ChannelMap::kMaxInputChannels)
+    {
+      return std::nullopt;
+    }
+    map.gains[output][input] = 1.0f;
+    map.sources[output] = input;
+    map.numInputChannels = std::max(map.numInputChannels, input + 1);
+  }
+  return map;
+}
+
+// Mix the input channels to the outputs with a row-major gain matrix, i.e.
+// gains[output * numInputChannels + input]
+inline std::optional<ChannelMap> MakeChannelMatrix(const float* gains,
+                                                   const uint32_t numInputChannels,
+                                                   const uint32_t numOutputChannels)
+{
+  if (numInputChannels == 0 || numInputChannels > ChannelMap::kMaxInputChannels
+      || numOutputChannels == 0 || numOutputChannels > ChannelMap::kMaxOutputChannels)
+  {
+    return std::nullopt;
+  }
+
+  ChannelMap map;
+  map.numInputChannels = numInputChannels;
+  map.numOutputChannels = numOutputChannels;
+  map.isRouting = true;
+  for (uint32_t output = 0; output < numOutputChannels; ++output)
+  {
+    uint32_t numUnity = 0;
+    uint32_t numNonZero = 0;
+    for (uint32_t input = 0; input < numInputChannels; ++input)
+    {
+      const auto gain = gains[output * numInputChannels + input];
+      map.gains[output][input] = gain;
+      if (gain != 0.0f)
+      {
+        ++numNonZero;
+        numUnity += gain == 1.0f ? 1 : 0;
+        map.sources[output] = input;
+      }
+    }
+    map.isRouting = map.isRouting && numNonZero == 1 && numUnity == 1;
+  }
+  return map;
+}
+
+// Whether any output channel reads the input channel
+inline bool ReadsInput(const ChannelMap& map, const uint32_t channel)
+{
+  for (uint32_t output = 0; output < map.numOutputChannels; ++output)
+  {
+    if (map.gains[output][channel] != 0.0f)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// The map used if none is configured: mono stays mono, everything else sends
+// the first two channels
+inline ChannelMap DefaultChannelMap(const uint32_t numInputChannels)
+{
+  static constexpr uint32_t kFirstTwo[] = {0, 1};
+  return *MakeChannelSelection(kFirstTwo, numInputChannels == 1 ? 1 : 2);
+}
+
+namespace detail
+{
+
+template <typename T>
+constexpr std::array<uint32_t, ChannelMap::kMaxInputChannels> PackedStrides()
+{
+  std::array<uint32_t, ChannelMap::kMaxInputChannels> strides{};
+  for (auto& stride : strides)
+  {
+    stride = sizeof(T);
+  }
+  return strides;
+}
+
+} // namespace detail
+
+// Input channels of a buffer list: sample `frame` of channel `c` starts
+// frame * strides[c] bytes after data[c]. Planar packed channels have a stride
+// of sizeof(T), interleaved channels point into the same buffer with a stride
+// of the size of a frame. Padded or partially interleaved buffers only differ
+// in their strides, samples don't need to be aligned.
+template <typename T>
+struct InputChannels
+{
+  std::array<const void*, ChannelMap::kMaxInputChannels> data{};
+  std::array<uint32_t, ChannelMap::kMaxInputChannels> strides = detail::PackedStrides<T>();
+};
+
+namespace detail
+{
+
+template <typename Isa, typename S>
+void WriteBlock(const uint32_t numOutputChannels,
+                const uint32_t numFrames,
+                const S* left,
+                const S* right,
+                int16_t* output)
+{
+  if (numOutputChannels == 1)
+  {
+    Isa::convert(numFrames, left, output);
+  }
+  else
+  {
+    Isa::interleave(numFrames, left, right, output);
+  }
+}
+
+template <typename T>
+T LoadSample(const uint8_t* data)
+{
+  T sample;
+  std::memcpy(&sample, data, sizeof(T));
+  return sample;
+}
+
+template <typename T>
+void Gather(const uint32_t numFrames, const void* input, const uint32_t stride, T* output)
+{
+  const auto* bytes = static_cast<const uint8_t*>(input);
+  for (uint32_t frame = 0; frame < numFrames; ++frame)
+  {
+    output[frame] = LoadSample<T>(bytes + frame * stride);
+  }
+}
+
+template <typename T>
+void GatherFloat(const uint32_t numFrames,
+                 const void* input,
+                 const uint32_t stride,
+                 float* output)
+{
+  const auto* bytes = static_cast<const uint8_t*>(input);
+  for (uint32_t frame = 0; frame < numFrames; ++frame)
+  {
+    output[frame] = ToFloat<T>(LoadSample<T>(bytes + frame * stride));
+  }
+}
+
+inline const void* Advance(const void* data, const size_t numBytes)
+{
+  return static_cast<const uint8_t*>(data) + numBytes;
+}
+
+} // namespace detail
+
+// Convert the input channels to interleaved int16_t according to the channel
+// map. Routing maps reuse the plain conversion kernels, other maps accumulate
+// the weighted inputs per block, apply the gain, resample and convert the
+// sums. Routed input also goes through float blocks while the gain isn't
+// unity or the resampler is active, or if the quantizer rounds or dithers
+// input other than Int16. Returns the number of frames written, which is less
+// than numFrames when resampling.
+template <typename T, typename Isa = isa::Native>
+uint32_t CopyBufferMapped(const ChannelMap& map,
+                          const uint32_t numFrames,
+                          const InputChannels<T>& input,
+                          int16_t* output,
+                          Quantizer& quantizer,
+                          GainRamp& gain,
+                          Resampler& resampler)
+{
+  const auto numOutputChannels = map.numOutputChannels;
+  gain.update();
+  const auto isExact =
+    gain.isUnity() && !resampler.isActive()
+    && (quantizer.mode() == QuantizationMode::Truncate || std::is_same_v<T, int16_t>);
+
+  const auto left = map.sources[0];
+  const auto right = map.sources[numOutputChannels - 1];
+  if (map.isRouting && isExact && input.strides[left] == sizeof(T)
+      && input.strides[right] == sizeof(T))
+  {
+    detail::WriteBlock<Isa>(numOutputChannels,
+                            numFrames,
+                            static_cast<const T*>(input.data[left]),
+                            static_cast<const T*>(input.data[right]),
+                            output);
+    return numFrames;
+  }
+
+  uint32_t numOutputFrames = 0;
+  for (uint32_t begin = 0; begin < numFrames; begin += kBlockSize)
+  {
+    const auto blockSize = std::min(kBlockSize, numFrames - begin);
+    auto* out = output + numOutputFrames * numOutputChannels;
+
+    if (map.isRouting && isExact)
+    {
+      std::array<std::array<T, kBlockSize>, ChannelMap::kMaxOutputChannels> block;
+      for (uint32_t channel = 0; channel < numOutputChannels; ++channel)
+      {
+        const auto source = map.sources[channel];
+        const auto stride = input.strides[source];
+        detail::Gather(blockSize,
+                       detail::Advance(input.data[source], size_t{begin} * stride),
+                       stride,
+                       block[channel].data());
+      }
+      detail::WriteBlock<Isa>(
+        numOutputChannels, blockSize, block[0].data(), block[1].data(), out);
+      numOutputFrames += blockSize;
+      continue;
+    }
+
+    std::array<std::array<float, kBlockSize>, ChannelMap::kMaxOutputChannels> sums{};
+    if (map.isRouting)
+    {
+      for (uint32_t channel = 0; channel < numOutputChannels; ++channel)
+      {
+        const auto source = map.sources[channel];
+        const auto stride = input.strides[source];
+        detail::GatherFloat<T>(blockSize,
+                               detail::Advance(input.data[source], size_t{begin} * stride),
+                               stride,
+                               sums[channel].data());
+      }
+    }
+    else
+    {
+      std::array<float, kBlockSize> samples;
+      for (uint32_t channel = 0; channel < map.numInputChannels; ++channel)
+      {
+        if (!ReadsInput(map, channel))
+        {
+          continue;
+        }
+
+        const auto stride = input.strides[channel];
+        detail::GatherFloat<T>(blockSize,
+                               detail::Advance(input.data[channel], size_t{begin} * stride),
+                               stride,
+                               samples.data());
+        Isa::accumulate(numOutputChannels,
+                        blockSize,
+                        samples.data(),
+                        map.gains[0][channel],
+                        map.gains[1][channel],
+                        sums[0].data(),
+                        sums[1].data());
+      }
+    }
+    gain.apply(numOutputChannels, blockSize, sums[0].data(), sums[1].data());
+
+    if (resampler.isActive())
+    {
+      std::array<std::array<float, kBlockSize>, ChannelMap::kMaxOutputChannels> resampled;
+      const auto numResampled = resampler.process(numOutputChannels,
+                                                  blockSize,
+                                                  sums[0].data(),
+                                                  sums[1].data(),
+                                                  resampled[0].data(),
+                                                  resampled[1].data());
+      quantizer.quantize<Isa>(numOutputChannels,
+                              numResampled,
+                              resampled[0].data(),
+                              resampled[1].data(),
+                              out);
+      numOutputFrames += numResampled;
+      continue;
+    }
+
+    quantizer.quantize<Isa>(
+      numOutputChannels, blockSize, sums[0].data(), sums[1].data(), out);
+    numOutputFrames += blockSize;
+  }
+  return numOutputFrames;
+}
+
+// Mapped copy at the input sample rate
+template <typename T, typename Isa = isa::Native>
+uint32_t CopyBufferMapped(const ChannelMap& map,
+                          const uint32_t numFrames,
+                          const InputChannels<T>& input,
+                          int16_t* output,
+                          Quantizer& quantizer,
+                          GainRamp& gain)
+{
+  Resampler resampler;
+  return CopyBufferMapped<T, Isa>(map, numFrames, input, output, quantizer, gain, resampler);
+}
+
+// Mapped copy with unity gain
+template <typename T, typename Isa = isa::Native>
+uint32_t CopyBufferMapped(const ChannelMap& map,
+                          const uint32_t numFrames,
+                          const InputChannels<T>& input,
+                          int16_t* output,
+                          Quantizer& quantizer)
+{
+  GainRamp gain;
+  return CopyBufferMapped<T, Isa>(map, numFrames, input, output, quantizer, gain);
+}
+
+// Mapped copy with unity gain and truncating conversion
+template <typename T, typename Isa = isa::Native>
+uint32_t CopyBufferMapped(const ChannelMap& map,
+                          const uint32_t numFrames,
+                          const InputChannels<T>& input,
+                          int16_t* output)
+{
+  Quantizer quantizer;
+  return CopyBufferMapped<T, Isa>(map, numFrames, input, output, quantizer);
+}
+
+} // namespace ableton::link_kit
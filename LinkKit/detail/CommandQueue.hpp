@@ -0,0 +1,76 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#pragma once
+
+#include "SpscIndices.hpp"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace ableton::link_kit
+{
+
+// Single producer, single consumer queue of fixed size commands, e.g. from a
+// UI thread to the audio thread. Commands are copied as bytes, so they have to
+// be trivially copyable. All storage is allocated by the constructor, pushing
+// and popping are wait-free: they neither lock, allocate nor retry.
+class CommandQueue
+{
+public:
+  CommandQueue(const uint32_t commandSize, const uint32_t capacity)
+    : mCommandSize(commandSize)
+    , mStorage(size_t{commandSize} * capacity)
+    , mIndices(capacity)
+  {
+  }
+
+  uint32_t commandSize() const
+  {
+    return mCommandSize;
+  }
+
+  uint32_t capacity() const
+  {
+    return mIndices.capacity();
+  }
+
+  // Copy commandSize bytes into the queue. Returns false and drops the
+  // command if the queue is full. Producer only.
+  bool push(const void* command)
+  {
+    const auto index = mIndices.writeSlot();
+    if (index == mIndices.capacity())
+    {
+      return false;
+    }
+    std::memcpy(slot(index), command, mCommandSize);
+    mIndices.commitWrite();
+    return true;
+  }
+
+  // Copy the oldest command out of the queue. Returns false if the queue is
+  // empty. Consumer only.
+  bool pop(void* command)
+  {
+    const auto index = mIndices.readSlot();
+    if (index == mIndices.capacity())
+    {
+      return false;
+    }
+    std::memcpy(command, slot(index), mCommandSize);
+    mIndices.commitRead();
+    return true;
+  }
+
+private:
+  uint8_t* slot(const uint32_t index)
+  {
+    return mStorage.data() + size_t{index} * mCommandSize;
+  }
+
+  uint32_t mCommandSize;
+  std::vector<uint8_t> mStorage;
+  SpscIndices mIndices;
+};
+
+} // namespace ableton::link_kit
@@ -0,0 +1,86 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace ableton::link_kit
+{
+
+// Keeps the latest tempo, peer count and play state of a session together with
+// a mask of what changed since the consumer last polled. Any number of threads
+// may post without locking, a burst of events between two polls costs the
+// consumer a single poll. Posting tells whether the mailbox was empty before,
+// so that a consumer that has to be woken up is woken up once per poll rather
+// than once per event.
+class EventMailbox
+{
+public:
+  // Bits of Events::changes
+  enum Change : uint32_t
+  {
+    kTempo = 1u << 0,
+    kNumPeers = 1u << 1,
+    kIsPlaying = 1u << 2,
+  };
+
+  struct Events
+  {
+    uint32_t changes = 0;
+    double tempo = 0.0;
+    uint64_t numPeers = 0;
+    bool isPlaying = false;
+  };
+
+  explicit EventMailbox(const double tempo)
+    : mTempo(tempo)
+  {
+  }
+
+  // Each returns true if there were no changes pending before. Lock-free, may
+  // be called from any thread.
+  bool postTempo(const double tempo)
+  {
+    mTempo.store(tempo, std::memory_order_relaxed);
+    return post(kTempo);
+  }
+
+  bool postNumPeers(const uint64_t numPeers)
+  {
+    mNumPeers.store(numPeers, std::memory_order_relaxed);
+    return post(kNumPeers);
+  }
+
+  bool postIsPlaying(const bool isPlaying)
+  {
+    mIsPlaying.store(isPlaying, std::memory_order_relaxed);
+    return post(kIsPlaying);
+  }
+
+  // The latest values and what changed since the previous poll. A value
+  // posted while polling may be reported again by the next poll, but no
+  // change is lost. Lock-free, one consumer at a time.
+  Events poll()
+  {
+    Events events;
+    events.changes = mChanges.exchange(0, std::memory_order_acquire);
+    events.tempo = mTempo.load(std::memory_order_relaxed);
+    events.numPeers = mNumPeers.load(std::memory_order_relaxed);
+    events.isPlaying = mIsPlaying.load(std::memory_order_relaxed);
+    return events;
+  }
+
+private:
+  bool post(const Change change)
+  {
+    return mChanges.fetch_or(change, std::memory_order_release) == 0;
+  }
+
+  std::atomic<double> mTempo;
+  std::atomic<uint64_t> mNumPeers{0};
+  std::atomic<bool> mIsPlaying{false};
+  std::atomic<uint32_t> mChanges{0};
+};
+
+} // namespace ableton::link_kit
@@ -0,0 +1,169 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#pragma once
+
+#include "BufferConversion.hpp"
+#include "FormatDescriptor.hpp"
+#include "InstructionSet.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+namespace ableton::link_kit
+{
+
+// Received audio is interleaved 16-bit with one or two channels. It is
+// expanded into buffers described by a FormatDescriptor, the reverse of what
+// the sink kernels do.
+
+// Output buffers of an expansion. Formats describe one buffer per channel if
+// planar or a single buffer holding all channels if interleaved.
+struct OutputBuffers
+{
+  std::array<void*, 2> buffers{};
+  uint32_t numBuffers = 0;
+};
+
+// Expand numFrames of received audio into the output, applying a linear gain
+using ExpansionKernel = void (*)(uint32_t numFrames,
+                                 const int16_t* input,
+                                 const OutputBuffers& output,
+                                 float gain);
+
+// Sample types received audio can be expanded to
+using ExpansionTypes = std::tuple<float, int32_t>;
+
+constexpr size_t kNumExpansionTypes = std::tuple_size_v<ExpansionTypes>;
+
+namespace kernels
+{
+
+// Mono to mono or interleaved to interleaved
+template <typename U, typename Isa, uint32_t NumChannels>
+void Expand(const uint32_t numFrames,
+            const int16_t* input,
+            const OutputBuffers& output,
+            const float gain)
+{
+  Isa::expand(numFrames * NumChannels,
+              input,
+              static_cast<U*>(output.buffers[0]),
+              ExpansionScale<U>(gain));
+}
+
+// Stereo to planar stereo
+template <typename U, typename Isa>
+void Deinterleave(const uint32_t numFrames,
+                  const int16_t* input,
+                  const OutputBuffers& output,
+                  const float gain)
+{
+  Isa::deinterleave(numFrames,
+                    input,
+                    static_cast<U*>(output.buffers[0]),
+                    static_cast<U*>(output.buffers[1]),
+                    ExpansionScale<U>(gain));
+}
+
+// Mono to planar stereo, the left channel is expanded once and copied
+template <typename U, typename Isa>
+void Duplicate(const uint32_t numFrames,
+               const int16_t* input,
+               const OutputBuffers& output,
+               const float gain)
+{
+  Isa::expand(numFrames, input, static_cast<U*>(output.buffers[0]), ExpansionScale<U>(gain));
+  std::memcpy(output.buffers[1], output.buffers[0], numFrames * sizeof(U));
+}
+
+} // namespace kernels
+
+// The expansion kernels instantiated for one sample type and instruction set
+struct ExpansionKernelSet
+{
+  // Indexed by number of channels - 1
+  std::array<ExpansionKernel, 2> contiguous;
+  ExpansionKernel deinterleave;
+  ExpansionKernel duplicate;
+};
+
+template <typename U, typename Isa>
+constexpr ExpansionKernelSet MakeExpansionKernelSet()
+{
+  return {{{&kernels::Expand<U, Isa, 1>, &kernels::Expand<U, Isa, 2>}},
+          &kernels::Deinterleave<U, Isa>,
+          &kernels::Duplicate<U, Isa>};
+}
+
+template <typename Isa, size_t... Indices>
+constexpr auto MakeExpansionTable(std::index_sequence<Indices...>)
+{
+  return std::array<ExpansionKernelSet, kNumExpansionTypes>{
+    {MakeExpansionKernelSet<std::tuple_element_t<Indices, ExpansionTypes>, Isa>()...}};
+}
+
+// Expansion kernels for every output type, in the order of ExpansionTypes
+template <typename Isa>
+inline constexpr auto kExpansionTable =
+  MakeExpansionTable<Isa>(std::make_index_sequence<kNumExpansionTypes>{});
+
+namespace detail
+{
+
+template <size_t... Indices>
+constexpr std::optional<size_t> FindExpansionType(const SampleLayout& layout,
+                                                  std::index_sequence<Indices...>)
+{
+  std::optional<size_t> index;
+  ((LayoutOf<std::tuple_element_t<Indices, ExpansionTypes>>() == layout
+      ? (void)(index = Indices)
+      : (void)0),
+   ...);
+  return index;
+}
+
+} // namespace detail
+
+// Pick the kernel expanding numInputChannels of received audio into the
+// format. Channel counts have to match, except that mono is expanded into both
+// channels of a planar stereo output. Returns nullptr for other channel
+// counts, sample types other than ExpansionTypes and padded formats.
+inline ExpansionKernel SelectExpansionKernel(const FormatDescriptor& format,
+                                             const uint32_t numInputChannels,
+                                             const InstructionSet instructionSet)
+{
+  const auto index =
+    detail::FindExpansionType(format.sample, std::make_index_sequence<kNumExpansionTypes>{});
+  const auto numChannels = format.numChannels;
+  if (!index || numInputChannels == 0 || numInputChannels > 2 || numChannels == 0
+      || numChannels > 2)
+  {
+    return nullptr;
+  }
+
+  const auto numBufferChannels = format.isInterleaved ? numChannels : 1;
+  if (FrameStride(format, numBufferChannels)
+      != numBufferChannels * format.sample.bytesPerSample)
+  {
+    return nullptr;
+  }
+
+  return WithInstructionSet(instructionSet, [&](auto tag) -> ExpansionKernel {
+    const auto& set = kExpansionTable<decltype(tag)>[*index];
+    if (numChannels == numInputChannels)
+    {
+      return numChannels == 2 && !format.isInterleaved ? set.deinterleave
+                                                       : set.contiguous[numChannels - 1];
+    }
+    if (numInputChannels == 1 && !format.isInterleaved)
+    {
+      return set.duplicate;
+    }
+    return nullptr;
+  });
+}
+
+} // namespace ableton::link_kit
@@ -0,0 +1,269 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#pragma once
+
+#include "BufferConversion.hpp"
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+namespace ableton::link_kit
+{
+
+enum class SampleEncoding
+{
+  SignedInteger,
+  UnsignedInteger,
+  Float,
+};
+
+enum class ByteOrder
+{
+  LittleEndian,
+  BigEndian,
+};
+
+// Position of the significant bits in samples that are wider than their bit
+// depth. Samples without padding are packed.
+enum class SampleAlignment
+{
+  Packed,
+  High,
+  Low,
+};
+
+// Memory layout of a single sample
+struct SampleLayout
+{
+  uint32_t bitsPerSample = 0;
+  uint32_t bytesPerSample = 0;
+  // Number of bits right of the binary point of fixed point samples
+  uint32_t numFractionBits = 0;
+  SampleEncoding encoding = SampleEncoding::SignedInteger;
+  ByteOrder byteOrder = ByteOrder::LittleEndian;
+  SampleAlignment alignment = SampleAlignment::Packed;
+
+  friend constexpr bool operator==(const SampleLayout& lhs, const SampleLayout& rhs)
+  {
+    return lhs.bitsPerSample == rhs.bitsPerSample
+           && lhs.bytesPerSample == rhs.bytesPerSample
+           && lhs.numFractionBits == rhs.numFractionBits && lhs.encoding == rhs.encoding
+           && lhs.byteOrder == rhs.byteOrder && lhs.alignment == rhs.alignment;
+  }
+};
+
+// Platform independent description of an input stream, e.g. translated from an
+// AudioStreamBasicDescription
+struct FormatDescriptor
+{
+  SampleLayout sample;
+  uint32_t numChannels = 0;
+  // Planar streams have one buffer per channel
+  bool isInterleaved = true;
+  // Bytes from one frame to the next in a buffer holding all channels if
+  // interleaved or one channel otherwise. Zero if there is no padding between
+  // frames.
+  uint32_t bytesPerFrame = 0;
+  double sampleRate = 0.0;
+};
+
+// Bytes between frames of a buffer holding the given number of channels.
+// Buffers of the layout the format describes may be padded, other buffers are
+// assumed to hold their channels back to back.
+inline uint32_t FrameStride(const FormatDescriptor& format, const uint32_t numChannels)
+{
+  const auto numDescribedChannels = format.isInterleaved ? format.numChannels : 1;
+  if (numChannels == numDescribedChannels && format.bytesPerFrame != 0)
+  {
+    return format.bytesPerFrame;
+  }
+  return numChannels * format.sample.bytesPerSample;
+}
+
+// Every sample type there is a Convert<T> specialization for. Kernels are
+// instantiated for each of them.
+using SampleTypes = std::tuple<int16_t,
+                               uint16_t,
+                               BigEndian<int16_t>,
+                               PackedInt24,
+                               LowAlignedInt24,
+                               int32_t,
+                               uint32_t,
+                               Fixed824,
+                               BigEndian<int32_t>,
+                               float,
+                               BigEndian<float>,
+                               double>;
+
+constexpr size_t kNumSampleTypes = std::tuple_size_v<SampleTypes>;
+
+template <size_t Index>
+using SampleTypeAt = std::tuple_element_t<Index, SampleTypes>;
+
+// The layout a sample type reads
+template <typename T>
+constexpr SampleLayout LayoutOf();
+
+template <>
+constexpr SampleLayout LayoutOf<int16_t>()
+{
+  return {16, 2, 0, SampleEncoding::SignedInteger};
+}
+
+template <>
+constexpr SampleLayout LayoutOf<uint16_t>()
+{
+  return {16, 2, 0, SampleEncoding::UnsignedInteger};
+}
+
+template <>
+constexpr SampleLayout LayoutOf<PackedInt24>()
+{
+  return {24, 3, 0, SampleEncoding::SignedInteger};
+}
+
+template <>
+constexpr SampleLayout LayoutOf<LowAlignedInt24>()
+{
+  return {24, 4, 0, SampleEncoding::SignedInteger, ByteOrder::LittleEndian,
+          SampleAlignment::Low};
+}
+
+template <>
+constexpr SampleLayout LayoutOf<int32_t>()
+{
+  return {32, 4, 0, SampleEncoding::SignedInteger};
+}
+
+template <>
+constexpr SampleLayout LayoutOf<uint32_t>()
+{
+  return {32, 4, 0, SampleEncoding::UnsignedInteger};
+}
+
+template <>
+constexpr SampleLayout LayoutOf<Fixed824>()
+{
+  return {32, 4, 24, SampleEncoding::SignedInteger};
+}
+
+template <>
+constexpr SampleLayout LayoutOf<float>()
+{
+  return {32, 4, 0, SampleEncoding::Float};
+}
+
+template <>
+constexpr SampleLayout LayoutOf<double>()
+{
+  return {64, 8, 0, SampleEncoding::Float};
+}
+
+template <>
+constexpr SampleLayout LayoutOf<BigEndian<int16_t>>()
+{
+  auto layout = LayoutOf<int16_t>();
+  layout.byteOrder = ByteOrder::BigEndian;
+  return layout;
+}
+
+template <>
+constexpr SampleLayout LayoutOf<BigEndian<int32_t>>()
+{
+  auto layout = LayoutOf<int32_t>();
+  layout.byteOrder = ByteOrder::BigEndian;
+  return layout;
+}
+
+template <>
+constexpr SampleLayout LayoutOf<BigEndian<float>>()
+{
+  auto layout = LayoutOf<float>();
+  layout.byteOrder = ByteOrder::BigEndian;
+  return layout;
+}
+
+// Maps a sample layout to the index of the type in SampleTypes reading it
+struct SampleTypeEntry
+{
+  SampleLayout layout;
+  size_t index;
+};
+
+namespace detail
+{
+
+template <size_t... Indices>
+constexpr auto MakeSampleTypeTable(std::index_sequence<Indices...>)
+{
+  return std::array<SampleTypeEntry, kNumSampleTypes + 1>{{
+    {LayoutOf<SampleTypeAt<Indices>>(), Indices}...,
+    // High aligned 24-bit samples only differ from 32-bit samples in the
+    // resolution of the low byte, which is discarded anyway
+    {{24, 4, 0, SampleEncoding::SignedInteger, ByteOrder::LittleEndian,
+      SampleAlignment::High},
+     5},
+  }};
+}
+
+} // namespace detail
+
+constexpr auto kSampleTypeTable =
+  detail::MakeSampleTypeTable(std::make_index_sequence<kNumSampleTypes>{});
+
+static_assert(std::is_same_v<SampleTypeAt<kSampleTypeTable.back().index>, int32_t>);
+
+// Index of the sample type in SampleTypes that reads the layout, if any
+constexpr std::optional<size_t> FindSampleType(const SampleLayout& layout)
+{
+  for (const auto& entry : kSampleTypeTable)
+  {
+    if (entry.layout == layout)
+    {
+      return entry.index;
+    }
+  }
+  return std::nullopt;
+}
+
+// How samples of a layout are read: by the type at index in SampleTypes,
+// starting offset bytes into each sample
+struct SampleReader
+{
+  size_t index = 0;
+  uint32_t offset = 0;
+};
+
+// Samples padded to a wider container than any type reads are read by the type
+// of the packed layout, at the offset of their significant bytes
+constexpr std::optional<SampleReader> FindSampleReader(const SampleLayout& layout)
+{
+  if (const auto index = FindSampleType(layout))
+  {
+    return SampleReader{*index, 0};
+  }
+
+  const auto numBytes = layout.bitsPerSample / 8;
+  if (layout.alignment == SampleAlignment::Packed || layout.bitsPerSample % 8 != 0
+      || numBytes == 0 || numBytes >= layout.bytesPerSample)
+  {
+    return std::nullopt;
+  }
+
+  auto packed = layout;
+  packed.bytesPerSample = numBytes;
+  packed.alignment = SampleAlignment::Packed;
+  const auto index = FindSampleType(packed);
+  if (!index)
+  {
+    return std::nullopt;
+  }
+  // Little endian samples store their most significant bytes last
+  const auto isPaddingFirst = (layout.alignment == SampleAlignment::High)
+                              == (layout.byteOrder == ByteOrder::LittleEndian);
+  return SampleReader{*index, isPaddingFirst ? layout.bytesPerSample - numBytes : 0};
+}
+
+} // namespace ableton::link_kit
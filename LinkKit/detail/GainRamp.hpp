@@ -0,0 +1,212 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#pragma once
+
+#include "BufferConversion.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace ableton::link_kit
+{
+
+enum class GainRampShape
+{
+  Linear,
+  // Constant ratio per frame, i.e. linear in dB
+  Exponential,
+};
+
+// Gain applied while converting a sink's buffers. The target gain can be set
+// from any thread without locking, the audio thread ramps towards it while
+// scaling blocks of float samples.
+class GainRamp
+{
+public:
+  // Exponential ramps from or to silence start or end at this level
+  static constexpr float kMinExponentialGain = 1e-4f;
+
+  // Lock-free, may be called from any thread
+  void setTarget(const float gain,
+                 const uint32_t numRampFrames,
+                 const GainRampShape shape)
+  {
+    mTarget.store(pack(gain, numRampFrames, shape), std::memory_order_relaxed);
+  }
+
+  // True if samples pass unchanged, i.e. no ramp is in progress or pending
+  // and the gain is one
+  bool isUnity() const
+  {
+    return mNumRemaining == 0 && mGain == 1.0f
+           && unpackGain(mTarget.load(std::memory_order_relaxed)) == 1.0f;
+  }
+
+  // Gain at the end of the last processed block
+  float gain() const
+  {
+    return mGain;
+  }
+
+  // Start ramping if the target changed since the last call. Audio thread only.
+  void update()
+  {
+    const auto target = mTarget.load(std::memory_order_relaxed);
+    if (target == mLastTarget)
+    {
+      return;
+    }
+    mLastTarget = target;
+
+    const auto end = unpackGain(target);
+    const auto numRampFrames = static_cast<uint32_t>(target >> 32) & kFramesMask;
+    if (numRampFrames == 0 || end == mGain)
+    {
+      mGain = end;
+      mNumRemaining = 0;
+      return;
+    }
+
+    mStart = mGain;
+    mEnd = end;
+    mNumRampFrames = numRampFrames;
+    mNumRemaining = numRampFrames;
+
+    const auto isExponential = (target >> 63) != 0;
+    // Exponential ramps can't cross zero, use a linear ramp instead
+    mIsExponential = isExponential && !(mStart < 0.0f && mEnd > 0.0f)
+                     && !(mStart > 0.0f && mEnd < 0.0f);
+    if (mIsExponential)
+    {
+      const auto sign = mStart < 0.0f || mEnd < 0.0f ? -1.0 : 1.0;
+      const auto clamp = [sign](const float gain) {
+        return sign * std::max(std::abs(double{gain}), double{kMinExponentialGain});
+      };
+      mExponentialStart = clamp(mStart);
+      mLogRatio = std::log(clamp(mEnd) / mExponentialStart) / numRampFrames;
+    }
+    else
+    {
+      mSlope = (mEnd - mStart) / static_cast<float>(numRampFrames);
+    }
+  }
+
+  // Scale up to kBlockSize frames of one or two channels in place and advance
+  // the ramp. Audio thread only.
+  void apply(const uint32_t numChannels,
+             const uint32_t numFrames,
+             float* left,
+             float* right)
+  {
+    if (numFrames == 0)
+    {
+      return;
+    }
+
+    if (mNumRemaining == 0)
+    {
+      if (mGain != 1.0f)
+      {
+        scale(numFrames, mGain, left);
+        if (numChannels == 2)
+        {
+          scale(numFrames, mGain, right);
+        }
+      }
+      return;
+    }
+
+    std::array<float, kBlockSize> gains;
+    const auto numRampFrames = std::min(numFrames, mNumRemaining);
+    const auto elapsed = mNumRampFrames - mNumRemaining;
+    if (mIsExponential)
+    {
+      // Re-anchor once per block so rounding errors don't accumulate
+      const auto ratio = std::exp(mLogRatio);
+      auto gain = mExponentialStart * std::exp(mLogRatio * elapsed);
+      for (uint32_t frame = 0; frame < numRampFrames; ++frame)
+      {
+        gain *= ratio;
+        gains[frame] = static_cast<float>(gain);
+      }
+    }
+    else
+    {
+      for (uint32_t frame = 0; frame < numRampFrames; ++frame)
+      {
+        gains[frame] = mStart + mSlope * static_cast<float>(elapsed + frame + 1);
+      }
+    }
+
+    mNumRemaining -= numRampFrames;
+    if (mNumRemaining == 0)
+    {
+      gains[numRampFrames - 1] = mEnd;
+    }
+    mGain = gains[numRampFrames - 1];
+    std::fill(gains.begin() + numRampFrames, gains.begin() + numFrames, mGain);
+
+    scale(numFrames, gains.data(), left);
+    if (numChannels == 2)
+    {
+      scale(numFrames, gains.data(), right);
+    }
+  }
+
+private:
+  static constexpr uint32_t kFramesMask = 0x7FFFFFFF;
+
+  static uint64_t pack(const float gain,
+                       const uint32_t numRampFrames,
+                       const GainRampShape shape)
+  {
+    uint32_t gainBits;
+    std::memcpy(&gainBits, &gain, sizeof(gainBits));
+    const auto shapeBit = shape == GainRampShape::Exponential ? uint64_t{1} << 63 : 0;
+    return shapeBit | uint64_t{std::min(numRampFrames, kFramesMask)} << 32 | gainBits;
+  }
+
+  static float unpackGain(const uint64_t target)
+  {
+    const auto gainBits = static_cast<uint32_t>(target);
+    float gain;
+    std::memcpy(&gain, &gainBits, sizeof(gain));
+    return gain;
+  }
+
+  static void scale(const uint32_t numFrames, const float gain, float* samples)
+  {
+    for (uint32_t frame = 0; frame < numFrames; ++frame)
+    {
+      samples[frame] *= gain;
+    }
+  }
+
+  static void scale(const uint32_t numFrames, const float* gains, float* samples)
+  {
+    for (uint32_t frame = 0; frame < numFrames; ++frame)
+    {
+      samples[frame] *= gains[frame];
+    }
+  }
+
+  static constexpr uint64_t kUnityTarget = 0x3F800000;
+
+  std::atomic<uint64_t> mTarget{kUnityTarget};
+  // Audio thread state
+  uint64_t mLastTarget = kUnityTarget;
+  float mGain = 1.0f;
+  float mStart = 1.0f;
+  float mEnd = 1.0f;
+  float mSlope = 0.0f;
+  double mExponentialStart = 1.0;
+  double mLogRatio = 0.0;
+  uint32_t mNumRampFrames = 0;
+  uint32_t mNumRemaining = 0;
+  bool mIsExponential = false;
+};
+
+} // namespace ableton::link_kit
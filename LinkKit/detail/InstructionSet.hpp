@@ -0,0 +1,76 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#pragma once
+
+#include <initializer_list>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#define LINK_KIT_SIMD_SSE2 1
+#define LINK_KIT_SIMD_AVX2 1
+#define LINK_KIT_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define LINK_KIT_SIMD_NEON 1
+#endif
+
+namespace ableton::link_kit
+{
+
+// Instruction sets conversion kernels are compiled for. Kernels for every
+// instruction set available on the target architecture are built into the
+// library, the one to use is picked at runtime.
+enum class InstructionSet
+{
+  Scalar,
+  Sse2,
+  Avx2,
+  Neon,
+};
+
+// Check whether the CPU we are running on can execute the given instruction set
+inline bool IsSupported(const InstructionSet instructionSet)
+{
+  switch (instructionSet)
+  {
+  case InstructionSet::Scalar:
+    return true;
+#if defined(LINK_KIT_SIMD_SSE2)
+  case InstructionSet::Sse2:
+    return true;
+  case InstructionSet::Avx2:
+    return __builtin_cpu_supports("avx2");
+#endif
+#if defined(LINK_KIT_SIMD_NEON)
+  case InstructionSet::Neon:
+    return true;
+#endif
+  default:
+    return false;
+  }
+}
+
+// Query the CPU for the widest supported instruction set
+inline InstructionSet DetectInstructionSet()
+{
+  for (const auto instructionSet : {InstructionSet::Avx2, InstructionSet::Sse2})
+  {
+    if (IsSupported(instructionSet))
+    {
+      return instructionSet;
+    }
+  }
+  return IsSupported(InstructionSet::Neon) ? InstructionSet::Neon
+                                           : InstructionSet::Scalar;
+}
+
+// The CPU is only queried once, on the first call. Call this from a non
+// realtime thread, e.g. when configuring a sink, before relying on it in the
+// audio thread.
+inline InstructionSet BestInstructionSet()
+{
+  static const auto instructionSet = DetectInstructionSet();
+  return instructionSet;
+}
+
+} // namespace ableton::link_kit
@@ -0,0 +1,422 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#pragma once
+
+#include "BufferConversion.hpp"
+#include "ChannelMap.hpp"
+#include "FormatDescriptor.hpp"
+#include "GainRamp.hpp"
+#include "InstructionSet.hpp"
+#include "LevelMeter.hpp"
+#include "Quantizer.hpp"
+#include "Resampler.hpp"
+#include "SilenceGate.hpp"
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+namespace ableton::link_kit
+{
+
+// Everything a sink needs to convert its input, configured from the client
+// thread and carried across buffers by the audio thread
+struct ConversionState
+{
+  FormatDescriptor format;
+  // Channel map requested by the client, if any
+  std::optional<ChannelMap> requestedMap;
+  // Channel map in effect for the current format
+  ChannelMap map;
+  // Rounding and dither state
+  Quantizer quantizer;
+  // Gain target set from any thread, ramped by the audio thread
+  GainRamp gain;
+  // Sample rate requested by the client, zero to send at the input rate
+  uint32_t targetSampleRate = 0;
+  Resampler resampler;
+  // Offset of the significant bytes in samples padded beyond the type reading
+  // them
+  uint32_t sampleOffset = 0;
+  // Levels of the converted samples, if enabled
+  LevelMeter meter;
+  // Skips converting silent input, if enabled
+  SilenceGate gate;
+};
+
+struct InputBuffer
+{
+  const void* data = nullptr;
+  uint32_t numChannels = 0;
+};
+
+// Input buffers of a conversion. Formats describe buffers with one channel if
+// planar or all channels if interleaved, but any split of the channels across
+// buffers can be converted.
+struct InputBuffers
+{
+  std::array<InputBuffer, ChannelMap::kMaxInputChannels> buffers{};
+  uint32_t numBuffers = 0;
+};
+
+inline uint32_t NumChannels(const InputBuffers& input)
+{
+  uint32_t numChannels = 0;
+  for (uint32_t i = 0; i < input.numBuffers; ++i)
+  {
+    numChannels += input.buffers[i].numChannels;
+  }
+  return numChannels;
+}
+
+// Locate the first numChannels channels of the buffers
+template <typename T>
+InputChannels<T> MakeInputChannels(const FormatDescriptor& format,
+                                   const uint32_t sampleOffset,
+                                   const InputBuffers& input,
+                                   const uint32_t numChannels)
+{
+  InputChannels<T> channels;
+  uint32_t channel = 0;
+  for (uint32_t i = 0; i < input.numBuffers && channel < numChannels; ++i)
+  {
+    const auto& buffer = input.buffers[i];
+    const auto stride = FrameStride(format, buffer.numChannels);
+    const auto* data = static_cast<const uint8_t*>(buffer.data) + sampleOffset;
+    for (uint32_t j = 0; j < buffer.numChannels && channel < numChannels; ++j, ++channel)
+    {
+      channels.data[channel] = data + j * format.sample.bytesPerSample;
+      channels.strides[channel] = stride;
+    }
+  }
+  return channels;
+}
+
+// Converts numFrames of input to interleaved int16_t and returns the number of
+// frames written, which differs from numFrames if the sink resamples. The
+// written frames are metered if the meter of the state is enabled.
+using ConversionKernel = uint32_t (*)(ConversionState& state,
+                                      uint32_t numFrames,
+                                      const InputBuffers& input,
+                                      int16_t* output);
+
+// Whether every input channel read by the channel map converts to samples
+// within the threshold of the silence gate
+using SilenceCheck = bool (*)(const ConversionState& state,
+                              uint32_t numFrames,
+                              const InputBuffers& input);
+
+// Interleaved inputs with up to this many channels get a kernel with the
+// channel count as a compile time constant
+constexpr uint32_t kMaxUnrolledChannels = 8;
+
+namespace kernels
+{
+
+// Meter the frames a kernel just converted, while they are in cache. Returns
+// the number of frames.
+template <typename Isa>
+uint32_t Metered(ConversionState& state, const uint32_t numFrames, const int16_t* output)
+{
+  if (state.meter.isEnabled())
+  {
+    state.meter.process<Isa>(state.map.numOutputChannels, numFrames, output);
+  }
+  return numFrames;
+}
+
+// Any channel map, gain, quantization, sample rate and buffer layout
+template <typename T, typename Isa>
+uint32_t Mapped(ConversionState& state,
+                const uint32_t numFrames,
+                const InputBuffers& input,
+                int16_t* output)
+{
+  const auto& map = state.map;
+  const auto channels =
+    MakeInputChannels<T>(state.format, state.sampleOffset, input, map.numInputChannels);
+  const auto numOutputFrames = CopyBufferMapped<T, Isa>(
+    map, numFrames, channels, output, state.quantizer, state.gain, state.resampler);
+  return Metered<Isa>(state, numOutputFrames, output);
+}
+
+// Default map of packed planar input, sending the first NumOutputChannels
+// buffers. Falls back to the mapped kernel while the gain isn't unity or if the
+// buffers hold more than one channel.
+template <typename T, typename Isa, uint32_t NumOutputChannels>
+uint32_t Planar(ConversionState& state,
+                const uint32_t numFrames,
+                const InputBuffers& input,
+                int16_t* output)
+{
+  const auto& buffers = input.buffers;
+  if (!state.gain.isUnity() || buffers[0].numChannels != 1
+      || buffers[NumOutputChannels - 1].numChannels != 1)
+  {
+    return Mapped<T, Isa>(state, numFrames, input, output);
+  }
+
+  const auto* left = static_cast<const T*>(buffers[0].data);
+  if constexpr (NumOutputChannels == 1)
+  {
+    CopyBufferMono<T, Isa>(numFrames, left, output);
+  }
+  else
+  {
+    const auto* right = static_cast<const T*>(buffers[1].data);
+    CopyBufferStereoNonInterleaved<T, Isa>(numFrames, left, right, output);
+  }
+  return Metered<Isa>(state, numFrames, output);
+}
+
+// Default map of packed interleaved input with NumChannels channels, sending the
+// first one or two. Falls back to the mapped kernel while the gain isn't unity
+// or if the channels are split across buffers.
+template <typename T, typename Isa, uint32_t NumChannels>
+uint32_t Interleaved(ConversionState& state,
+                     const uint32_t numFrames,
+                     const InputBuffers& input,
+                     int16_t* output)
+{
+  const auto& buffer = input.buffers[0];
+  if (!state.gain.isUnity() || buffer.numChannels != NumChannels)
+  {
+    return Mapped<T, Isa>(state, numFrames, input, output);
+  }
+
+  const auto* src = static_cast<const T*>(buffer.data);
+  if constexpr (NumChannels == 1)
+  {
+    CopyBufferMono<T, Isa>(numFrames, src, output);
+  }
+  else if constexpr (NumChannels == 2)
+  {
+    CopyBufferStereoInterleaved<T, Isa>(numFrames, src, output);
+  }
+  else
+  {
+    // Extract the first two channels block by block, the constant stride lets
+    // the compiler unroll the gather
+    std::array<std::array<T, kBlockSize>, 2> block;
+    for (uint32_t begin = 0; begin < numFrames; begin += kBlockSize)
+    {
+      const auto blockSize = std::min(kBlockSize, numFrames - begin);
+      const auto* frames = src + begin * NumChannels;
+      for (uint32_t frame = 0; frame < blockSize; ++frame)
+      {
+        block[0][frame] = frames[frame * NumChannels];
+        block[1][frame] = frames[frame * NumChannels + 1];
+      }
+      Isa::interleave(blockSize, block[0].data(), block[1].data(), output + 2 * begin);
+    }
+  }
+  return Metered<Isa>(state, numFrames, output);
+}
+
+// Packed buffers whose channels are all read are checked in one contiguous pass.
+// Other buffers are checked channel by channel, skipping the channels the map
+// doesn't read, so that they can't keep the gate open.
+template <typename T, typename Isa>
+bool IsSilent(const ConversionState& state,
+              const uint32_t numFrames,
+              const InputBuffers& input)
+{
+  const auto& format = state.format;
+  const auto& map = state.map;
+  const auto threshold = state.gate.threshold();
+  uint32_t first = 0;
+  for (uint32_t i = 0; i < input.numBuffers && first < map.numInputChannels; ++i)
+  {
+    const auto& buffer = input.buffers[i];
+    const auto numChannels = std::min(buffer.numChannels, map.numInputChannels - first);
+    bool isRead = false;
+    bool isAllRead = numChannels == buffer.numChannels;
+    for (uint32_t j = 0; j < numChannels; ++j)
+    {
+      const auto reads = ReadsInput(map, first + j);
+      isRead = isRead || reads;
+      isAllRead = isAllRead && reads;
+    }
+    first += buffer.numChannels;
+    if (!isRead)
+    {
+      continue;
+    }
+
+    const auto stride = FrameStride(format, buffer.numChannels);
+    if (isAllRead && format.sample.bytesPerSample == sizeof(T)
+        && stride == buffer.numChannels * sizeof(T))
+    {
+      if (!Isa::isSilent(
+            numFrames * buffer.numChannels, static_cast<const T*>(buffer.data), threshold))
+      {
+        return false;
+      }
+      continue;
+    }
+
+    const auto* data = static_cast<const uint8_t*>(buffer.data) + state.sampleOffset;
+    for (uint32_t j = 0; j < numChannels; ++j)
+    {
+      if (!ReadsInput(map, first - buffer.numChannels + j))
+      {
+        continue;
+      }
+      const auto* channel = data + j * format.sample.bytesPerSample;
+      for (uint32_t frame = 0; frame < numFrames; ++frame)
+      {
+        const auto sample = detail::LoadSample<T>(channel + size_t{frame} * stride);
+        if (!isa::Scalar::isSilent(1, &sample, threshold))
+        {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+} // namespace kernels
+
+// The kernels instantiated for one sample type and instruction set
+struct KernelSet
+{
+  ConversionKernel mapped;
+  // Indexed by number of output channels - 1
+  std::array<ConversionKernel, ChannelMap::kMaxOutputChannels> planar;
+  // Indexed by number of input channels - 1
+  std::array<ConversionKernel, kMaxUnrolledChannels> interleaved;
+  SilenceCheck isSilent;
+};
+
+namespace detail
+{
+
+template <typename T, typename Isa, uint32_t... Channels>
+constexpr KernelSet MakeKernelSet(std::integer_sequence<uint32_t, Channels...>)
+{
+  return {&kernels::Mapped<T, Isa>,
+          {{&kernels::Planar<T, Isa, 1>, &kernels::Planar<T, Isa, 2>}},
+          {{&kernels::Interleaved<T, Isa, Channels + 1>...}},
+          &kernels::IsSilent<T, Isa>};
+}
+
+template <typename Isa, size_t... Indices>
+constexpr auto MakeKernelTable(std::index_sequence<Indices...>)
+{
+  return std::array<KernelSet, kNumSampleTypes>{{MakeKernelSet<SampleTypeAt<Indices>, Isa>(
+    std::make_integer_sequence<uint32_t, kMaxUnrolledChannels>{})...}};
+}
+
+} // namespace detail
+
+// Kernels for every sample type, in the order of SampleTypes
+template <typename Isa>
+inline constexpr auto kKernelTable =
+  detail::MakeKernelTable<Isa>(std::make_index_sequence<kNumSampleTypes>{});
+
+// Pick the kernel converting the configured format with the configured map,
+// quantization and sample rate. Returns nullptr for unsupported formats.
+inline ConversionKernel SelectKernel(const ConversionState& state,
+                                     const InstructionSet instructionSet)
+{
+  const auto& format = state.format;
+  const auto reader = FindSampleReader(format.sample);
+  if (!reader || format.numChannels == 0
+      || format.numChannels > ChannelMap::kMaxInputChannels)
+  {
+    return nullptr;
+  }
+
+  return WithInstructionSet(instructionSet, [&](auto tag) -> ConversionKernel {
+    const auto& kernels = kKernelTable<decltype(tag)>[reader->index];
+    const auto numBufferChannels = format.isInterleaved ? format.numChannels : 1;
+    // Unrolled kernels step by the size of the type reading the samples
+    const bool isPacked =
+      FindSampleType(format.sample)
+      && FrameStride(format, numBufferChannels)
+           == numBufferChannels * format.sample.bytesPerSample;
+    const bool isDefaultMap = !state.requestedMap;
+    // Only 16-bit input is exact when rounding or dithering
+    const bool isExact = !state.resampler.isActive()
+                         && (state.quantizer.mode() == QuantizationMode::Truncate
+                             || format.sample == LayoutOf<int16_t>());
+    if (!isPacked || !isDefaultMap || !isExact)
+    {
+      return kernels.mapped;
+    }
+    if (!format.isInterleaved)
+    {
+      return kernels.planar[state.map.numOutputChannels - 1];
+    }
+    if (format.numChannels <= kMaxUnrolledChannels)
+    {
+      return kernels.interleaved[format.numChannels - 1];
+    }
+    return kernels.mapped;
+  });
+}
+
+// Set up the channel map and resampler for the configured format and pick the
+// kernel. Allocates, must not be called concurrently with converting.
+inline ConversionKernel ConfigureConversion(ConversionState& state,
+                                            const InstructionSet instructionSet)
+{
+  const auto& format = state.format;
+  const auto numChannels = format.numChannels;
+  if (numChannels == 0 || numChannels > ChannelMap::kMaxInputChannels)
+  {
+    return nullptr;
+  }
+
+  state.map = state.requestedMap && state.requestedMap->numInputChannels <= numChannels
+                ? *state.requestedMap
+                : DefaultChannelMap(numChannels);
+  const auto reader = FindSampleReader(format.sample);
+  state.sampleOffset = reader ? reader->offset : 0;
+
+  // Unsupported ratios leave the resampler inactive, i.e. send at the input rate
+  const auto inputRate = static_cast<uint32_t>(std::lround(format.sampleRate));
+  state.resampler.configure(
+    inputRate, state.targetSampleRate == 0 ? inputRate : state.targetSampleRate);
+
+  return SelectKernel(state, instructionSet);
+}
+
+// Pick the silence check for the configured format. Returns nullptr for
+// unsupported formats.
+inline SilenceCheck SelectSilenceCheck(const ConversionState& state,
+                                       const InstructionSet instructionSet)
+{
+  const auto reader = FindSampleReader(state.format.sample);
+  if (!reader)
+  {
+    return nullptr;
+  }
+  return WithInstructionSet(instructionSet, [&](auto tag) {
+    return kKernelTable<decltype(tag)>[reader->index].isSilent;
+  });
+}
+
+// Check a buffer against the silence gate before converting it. Gated buffers
+// aren't converted, the resampler skips over them so that the timing of the
+// following buffers is unaffected. Returns the number of output frames a gated
+// buffer stands for, or nullopt if the buffer has to be converted.
+inline std::optional<uint32_t> GateSilence(ConversionState& state,
+                                           const SilenceCheck isSilent,
+                                           const uint32_t numFrames,
+                                           const InputBuffers& input)
+{
+  if (state.gate.mode() == SilenceGateMode::Off || isSilent == nullptr)
+  {
+    return std::nullopt;
+  }
+  if (!state.gate.process(isSilent(state, numFrames, input), numFrames))
+  {
+    return std::nullopt;
+  }
+  return state.resampler.skip(numFrames);
+}
+
+} // namespace ableton::link_kit
@@ -0,0 +1,134 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#pragma once
+
+#include "BufferConversion.hpp"
+#include "SingleWriterCounter.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+namespace ableton::link_kit
+{
+
+// Peak, RMS and clipping of the samples a sink sends. The audio thread meters
+// each converted buffer while it is still in cache and publishes running
+// totals. Another thread polls the levels since its previous poll without
+// locking or waiting for the audio thread.
+class LevelMeter
+{
+public:
+  static constexpr uint32_t kMaxChannels = 2;
+
+  struct Levels
+  {
+    uint32_t numChannels = 0;
+    // Frames metered since the previous read
+    uint64_t numFrames = 0;
+    // Linear, 1 is full scale
+    std::array<float, kMaxChannels> peak{};
+    std::array<float, kMaxChannels> rms{};
+    std::array<uint64_t, kMaxChannels> numClippedSamples{};
+  };
+
+  // Lock-free, may be called from any thread
+  void setEnabled(const bool isEnabled)
+  {
+    mIsEnabled.store(isEnabled, std::memory_order_relaxed);
+  }
+
+  bool isEnabled() const
+  {
+    return mIsEnabled.load(std::memory_order_relaxed);
+  }
+
+  // Meter interleaved samples of one or two channels. Audio thread only.
+  template <typename Isa = isa::Native>
+  void process(const uint32_t numChannels, const uint32_t numFrames, const int16_t* samples)
+  {
+    SampleLevels even;
+    SampleLevels odd;
+    Isa::meter(numChannels * numFrames, samples, even, odd);
+    if (numChannels == 1)
+    {
+      publish(0, MergeLevels(even, odd));
+    }
+    else
+    {
+      publish(0, even);
+      publish(1, odd);
+    }
+    mNumChannels.store(numChannels, std::memory_order_relaxed);
+    // Released last, so readers see at least the totals of these frames
+    mNumFrames.add(numFrames, std::memory_order_release);
+  }
+
+  // Levels since the previous call. Wait-free, but must not be called
+  // concurrently with itself. A buffer metered during the call may be counted
+  // in this and the next reading.
+  Levels read()
+  {
+    Levels levels;
+    const auto numFrames = mNumFrames.load(std::memory_order_acquire);
+    levels.numChannels = mNumChannels.load(std::memory_order_relaxed);
+    levels.numFrames = numFrames - mLastNumFrames;
+    mLastNumFrames = numFrames;
+
+    for (uint32_t i = 0; i < kMaxChannels; ++i)
+    {
+      auto& channel = mChannels[i];
+      // Totals wrap around, their differences don't as long as a reading
+      // covers less than 2^34 samples
+      const auto sumOfSquares = channel.sumOfSquares.load();
+      const auto numClipped = channel.numClipped.load();
+      const auto peak = channel.peak.exchange(0, std::memory_order_relaxed);
+
+      levels.peak[i] = static_cast<float>(peak) / 32768.0f;
+      if (levels.numFrames > 0)
+      {
+        const auto meanSquare = static_cast<double>(sumOfSquares - mLastSumOfSquares[i])
+                                / static_cast<double>(levels.numFrames);
+        levels.rms[i] = static_cast<float>(std::sqrt(meanSquare) / 32768.0);
+      }
+      levels.numClippedSamples[i] = numClipped - mLastNumClipped[i];
+      mLastSumOfSquares[i] = sumOfSquares;
+      mLastNumClipped[i] = numClipped;
+    }
+    return levels;
+  }
+
+private:
+  struct Channel
+  {
+    // Largest magnitude since the last read
+    std::atomic<uint32_t> peak{0};
+    // Running totals
+    SingleWriterCounter<> sumOfSquares;
+    SingleWriterCounter<> numClipped;
+  };
+
+  // The peak is reset by the reader, a reset between the load and the store
+  // is overwritten by a value at least as large, so no peak is lost.
+  void publish(const uint32_t index, const SampleLevels& levels)
+  {
+    auto& channel = mChannels[index];
+    const auto peak = static_cast<uint32_t>(std::max(levels.max, -levels.min));
+    const auto lastPeak = channel.peak.load(std::memory_order_relaxed);
+    channel.peak.store(std::max(peak, lastPeak), std::memory_order_relaxed);
+    channel.sumOfSquares.add(levels.sumOfSquares);
+    channel.numClipped.add(levels.numClipped);
+  }
+
+  std::atomic<bool> mIsEnabled{false};
+  std::array<Channel, kMaxChannels> mChannels;
+  std::atomic<uint32_t> mNumChannels{0};
+  SingleWriterCounter<> mNumFrames;
+  // Reader state
+  uint64_t mLastNumFrames = 0;
+  std::array<uint64_t, kMaxChannels> mLastSumOfSquares{};
+  std::array<uint64_t, kMaxChannels> mLastNumClipped{};
+};
+
+} // namespace ableton::link_kit
@@ -0,0 +1,155 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#pragma once
+
+#include "BeatGrid.hpp"
+#include "BufferTimeline.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace ableton::link_kit
+{
+
+// The click of the LinkHut metronome: a high tone on the first beat of the
+// quantum and a low tone on every other beat, 100 ms of a cosine with a
+// decaying sine envelope. Clicks are rendered into wavetables once per sample
+// rate. Each buffer is searched for beats with FindGridEvents, and only frames
+// within a click are touched, so the cost between clicks is the search alone.
+// Clicks start at the same frames and have the same samples as evaluating the
+// timeline for every frame, up to the microsecond resolution of Link's
+// timeline. Like LinkHut, negative beats are silent.
+class Metronome
+{
+public:
+  static constexpr double kHighTone = 1567.98;
+  static constexpr double kLowTone = 1108.73;
+  static constexpr double kClickDuration = 0.1;
+
+  // Allocates the wavetables, don't construct on the audio thread
+  explicit Metronome(const double sampleRate)
+    : mSampleRate(sampleRate)
+    , mHighClick(MakeClick(kHighTone, sampleRate))
+    , mLowClick(MakeClick(kLowTone, sampleRate))
+  {
+  }
+
+  double sampleRate() const
+  {
+    return mSampleRate;
+  }
+
+  // Frames of one click
+  uint32_t clickLength() const
+  {
+    return static_cast<uint32_t>(mHighClick.size());
+  }
+
+  // Amplitude of a click numFrames after its start, as LinkHut computes it
+  static float ClickSample(const double frequency,
+                           const double sampleRate,
+                           const uint32_t numFrames)
+  {
+    constexpr auto kPi = 3.14159265358979323846;
+    const auto seconds = numFrames / sampleRate;
+    return static_cast<float>(std::cos(2 * kPi * seconds * frequency)
+                              * (1 - std::sin(5 * kPi * seconds)));
+  }
+
+  // Stop the current click, e.g. when the transport stops. Audio thread only.
+  void reset()
+  {
+    mpClick = nullptr;
+  }
+
+  // Add the clicks of a buffer to the mono output. The timeline's sample rate
+  // has to match. Audio thread only.
+  void mix(const BufferTimeline& timeline, const uint32_t numFrames, float* output)
+  {
+    for (uint32_t frame = 0; frame < numFrames; frame += kMaxChunkSize)
+    {
+      mixChunk(
+        timeline.advanced(frame), std::min(kMaxChunkSize, numFrames - frame), output + frame);
+    }
+  }
+
+private:
+  // Buffers are searched in chunks short enough that even at the highest
+  // tempo and the lowest sample rates they hold fewer beats than events fit
+  static constexpr uint32_t kMaxChunkSize = 1024;
+  static constexpr uint32_t kMaxNumEvents = 8;
+
+  static std::vector<float> MakeClick(const double frequency, const double sampleRate)
+  {
+    std::vector<float> click;
+    for (uint32_t frame = 0; frame / sampleRate < kClickDuration; ++frame)
+    {
+      click.push_back(ClickSample(frequency, sampleRate, frame));
+    }
+    return click;
+  }
+
+  void mixChunk(const BufferTimeline& timeline, const uint32_t numFrames, float* output)
+  {
+    // Only beats start clicks, the quantum just picks the tone
+    auto beatTimeline = timeline;
+    beatTimeline.quantum = 0.0;
+    std::array<GridEvent, kMaxNumEvents> events;
+    const auto numEvents =
+      FindGridEvents(beatTimeline, numFrames, 1, std::nullopt, events.data(), kMaxNumEvents);
+    // Frames before beat zero are count-in and stay silent
+    const auto audibleFrame = static_cast<uint32_t>(std::clamp(
+      detail::CrossingFrame(timeline.frameAtBeat(0.0)), 0.0, static_cast<double>(numFrames)));
+
+    uint32_t frame = 0;
+    for (uint32_t i = 0; i < numEvents; ++i)
+    {
+      const auto& event = events[i];
+      if (event.beats < 0.0)
+      {
+        continue;
+      }
+      play(output, frame, event.frame, audibleFrame);
+      frame = event.frame;
+      const auto isFirstBeat = std::floor(PhaseOf(event.beats, timeline.quantum)) == 0.0;
+      mpClick = isFirstBeat ? &mHighClick : &mLowClick;
+      mClickFrame = 0;
+    }
+    play(output, frame, numFrames, audibleFrame);
+  }
+
+  // Continue the current click from frame begin until end, leaving frames
+  // before audibleFrame untouched
+  void play(float* output, const uint32_t begin, const uint32_t end, const uint32_t audibleFrame)
+  {
+    if (mpClick == nullptr)
+    {
+      return;
+    }
+
+    const auto& click = *mpClick;
+    const auto numFrames = std::min(end - begin, clickLength() - mClickFrame);
+    const auto numSkipped = std::min(audibleFrame > begin ? audibleFrame - begin : 0, numFrames);
+    const auto* samples = click.data() + mClickFrame;
+    for (uint32_t i = numSkipped; i < numFrames; ++i)
+    {
+      output[begin + i] += samples[i];
+    }
+    mClickFrame += numFrames;
+    if (mClickFrame == clickLength())
+    {
+      mpClick = nullptr;
+    }
+  }
+
+  double mSampleRate;
+  std::vector<float> mHighClick;
+  std::vector<float> mLowClick;
+  // Audio thread state: the playing click, if any, and the next frame of it
+  const std::vector<float>* mpClick = nullptr;
+  uint32_t mClickFrame = 0;
+};
+
+} // namespace ableton::link_kit
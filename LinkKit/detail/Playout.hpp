@@ -0,0 +1,289 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#pragma once
+
+#include "ExpansionTable.hpp"
+#include "FormatDescriptor.hpp"
+#include "InstructionSet.hpp"
+#include "SingleWriterCounter.hpp"
+#include "SpscIndices.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <vector>
+
+namespace ableton::link_kit
+{
+
+// Single producer, single consumer queue of received buffers. All storage is
+// allocated by the constructor, pushing and popping neither allocates nor
+// locks. Info is whatever the producer wants to keep with the samples, e.g.
+// their timing.
+template <typename Info>
+class PlayoutRing
+{
+public:
+  struct Slot
+  {
+    Info info{};
+    uint32_t numFrames = 0;
+    uint32_t numChannels = 0;
+    int16_t* samples = nullptr;
+  };
+
+  PlayoutRing(const uint32_t numSlots, const uint32_t maxNumSamples)
+    : mMaxNumSamples(maxNumSamples)
+    , mSamples(size_t{numSlots} * maxNumSamples)
+    , mSlots(numSlots)
+    , mIndices(numSlots)
+  {
+    for (uint32_t i = 0; i < numSlots; ++i)
+    {
+      mSlots[i].samples = mSamples.data() + size_t{i} * maxNumSamples;
+    }
+  }
+
+  uint32_t numSlots() const
+  {
+    return mIndices.capacity();
+  }
+
+  uint32_t maxNumSamples() const
+  {
+    return mMaxNumSamples;
+  }
+
+  // Copy a buffer into the next free slot. Returns false and drops the buffer
+  // if the ring is full or the buffer doesn't fit a slot. Producer only.
+  bool push(const Info& info,
+            const int16_t* samples,
+            const uint32_t numFrames,
+            const uint32_t numChannels)
+  {
+    const auto index = mIndices.writeSlot();
+    const auto numSamples = uint64_t{numFrames} * numChannels;
+    if (index == mIndices.capacity() || numSamples > mMaxNumSamples)
+    {
+      mNumDropped.add(1);
+      return false;
+    }
+
+    auto& slot = mSlots[index];
+    std::memcpy(slot.samples, samples, numSamples * sizeof(int16_t));
+    slot.info = info;
+    slot.numFrames = numFrames;
+    slot.numChannels = numChannels;
+    mIndices.commitWrite();
+    return true;
+  }
+
+  // Oldest buffer, nullptr if empty. Valid until pop(). Consumer only.
+  const Slot* front() const
+  {
+    const auto index = mIndices.readSlot();
+    return index == mIndices.capacity() ? nullptr : &mSlots[index];
+  }
+
+  // Consumer only
+  void pop()
+  {
+    mIndices.commitRead();
+  }
+
+  // Buffers dropped by push since construction, may be read from any thread
+  uint64_t numDropped() const
+  {
+    return mNumDropped.load();
+  }
+
+private:
+  uint32_t mMaxNumSamples;
+  std::vector<int16_t> mSamples;
+  std::vector<Slot> mSlots;
+  SpscIndices mIndices;
+  SingleWriterCounter<> mNumDropped;
+};
+
+// Plays received buffers into an output format. Buffers are queued by the
+// thread receiving them and rendered in order by the audio thread. Each
+// received frame is scheduled at its beat plus a fixed latency. Small timing
+// differences are absorbed to keep playback continuous. Beyond the tolerance,
+// late frames are skipped and early frames are preceded by silence.
+template <typename Info>
+class AudioPlayout
+{
+public:
+  // Differences between the scheduled and the actual position of a frame up
+  // to this many frames are played through
+  static constexpr uint32_t kSyncTolerance = 64;
+  static constexpr uint32_t kDefaultLatency = 2048;
+
+  AudioPlayout(const uint32_t numSlots, const uint32_t maxNumSamples)
+    : mRing(numSlots, maxNumSamples)
+  {
+  }
+
+  // Set the output format. Returns false if received buffers of either
+  // channel count can't be expanded into it. Must not be called concurrently
+  // with render().
+  bool setFormat(const FormatDescriptor& format, const InstructionSet instructionSet)
+  {
+    mFormat = format;
+    mKernels = {{SelectExpansionKernel(format, 1, instructionSet),
+                 SelectExpansionKernel(format, 2, instructionSet)}};
+    return hasFormat();
+  }
+
+  // Whether received audio can be played into the output format. Without a
+  // format the frame size of the output is unknown, so render() can't even
+  // silence it.
+  bool hasFormat() const
+  {
+    return mKernels[0] != nullptr || mKernels[1] != nullptr;
+  }
+
+  // Frames between the beat a frame was sent at and the beat it is rendered
+  // at. Lock-free, may be called from any thread.
+  void setLatency(const uint32_t numFrames)
+  {
+    mLatency.store(numFrames, std::memory_order_relaxed);
+  }
+
+  // Linear gain applied while rendering. Lock-free, may be called from any
+  // thread.
+  void setGain(const float gain)
+  {
+    mGain.store(gain, std::memory_order_relaxed);
+  }
+
+  // Receiving thread only
+  bool push(const Info& info,
+            const int16_t* samples,
+            const uint32_t numFrames,
+            const uint32_t numChannels)
+  {
+    return mRing.push(info, samples, numFrames, numChannels);
+  }
+
+  const PlayoutRing<Info>& ring() const
+  {
+    return mRing;
+  }
+
+  // Render numFrames into the output, whose first frame is at the given beat.
+  // beginBeats(info) returns the beat of the first frame of a received
+  // buffer, or nullopt if it can't be placed on the timeline, in which case
+  // buffers are played in order as they come. Frames without received audio
+  // are silent. Returns the number of received frames rendered. Writes
+  // nothing and returns 0 without a format. Audio thread only.
+  template <typename BeginBeats>
+  uint32_t render(const uint32_t numFrames,
+                  const OutputBuffers& output,
+                  const double beatsAtRenderBegin,
+                  const double tempo,
+                  BeginBeats&& beginBeats)
+  {
+    if (!hasFormat())
+    {
+      return 0;
+    }
+
+    const auto framesPerBeat = mFormat.sampleRate * 60.0 / tempo;
+    const auto latency = mLatency.load(std::memory_order_relaxed);
+    const auto gain = mGain.load(std::memory_order_relaxed);
+    uint32_t frame = 0;
+    // Output before this frame has been written
+    uint32_t numWritten = 0;
+    uint32_t numPlayed = 0;
+    while (frame < numFrames)
+    {
+      const auto* slot = mRing.front();
+      if (slot == nullptr)
+      {
+        break;
+      }
+      const auto kernel = slot->numChannels == 1 || slot->numChannels == 2
+                            ? mKernels[slot->numChannels - 1]
+                            : nullptr;
+      if (kernel == nullptr || mReadFrame >= slot->numFrames)
+      {
+        mRing.pop();
+        mReadFrame = 0;
+        continue;
+      }
+
+      if (const auto begin = beginBeats(slot->info))
+      {
+        // Frames from the current output frame to where the next received
+        // frame is scheduled
+        const auto offset =
+          (*begin - beatsAtRenderBegin) * framesPerBeat + mReadFrame + latency - frame;
+        if (offset < -static_cast<double>(kSyncTolerance))
+        {
+          mReadFrame += static_cast<uint32_t>(
+            std::min(std::round(-offset), static_cast<double>(slot->numFrames - mReadFrame)));
+          continue;
+        }
+        if (offset > kSyncTolerance)
+        {
+          frame += static_cast<uint32_t>(
+            std::min(std::round(offset), static_cast<double>(numFrames - frame)));
+          continue;
+        }
+      }
+
+      const auto numSlotFrames = std::min(slot->numFrames - mReadFrame, numFrames - frame);
+      silence(output, numWritten, frame - numWritten);
+      kernel(numSlotFrames,
+             slot->samples + size_t{mReadFrame} * slot->numChannels,
+             advance(output, frame),
+             gain);
+      frame += numSlotFrames;
+      numWritten = frame;
+      numPlayed += numSlotFrames;
+      mReadFrame += numSlotFrames;
+    }
+    silence(output, numWritten, numFrames - numWritten);
+    return numPlayed;
+  }
+
+private:
+  // The output buffers advanced by numFrames
+  OutputBuffers advance(const OutputBuffers& output, const uint32_t numFrames) const
+  {
+    const auto stride = FrameStride(mFormat, mFormat.isInterleaved ? mFormat.numChannels : 1);
+    auto result = output;
+    for (uint32_t i = 0; i < result.numBuffers; ++i)
+    {
+      result.buffers[i] = static_cast<uint8_t*>(result.buffers[i]) + size_t{numFrames} * stride;
+    }
+    return result;
+  }
+
+  // All zero bytes are silence in every format there are expansion kernels
+  // for
+  void silence(const OutputBuffers& output, const uint32_t frame, const uint32_t numFrames) const
+  {
+    const auto stride = FrameStride(mFormat, mFormat.isInterleaved ? mFormat.numChannels : 1);
+    const auto buffers = advance(output, frame);
+    for (uint32_t i = 0; i < buffers.numBuffers; ++i)
+    {
+      std::memset(buffers.buffers[i], 0, size_t{numFrames} * stride);
+    }
+  }
+
+  PlayoutRing<Info> mRing;
+  FormatDescriptor mFormat;
+  // Indexed by number of received channels - 1
+  std::array<ExpansionKernel, 2> mKernels{};
+  std::atomic<uint32_t> mLatency{kDefaultLatency};
+  std::atomic<float> mGain{1.0f};
+  // Audio thread state: the first unplayed frame of the front buffer
+  uint32_t mReadFrame = 0;
+};
+
+} // namespace ableton::link_kit
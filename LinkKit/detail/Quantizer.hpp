@@ -0,0 +1,152 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#pragma once
+
+#include "BufferConversion.hpp"
+#include <array>
+#include <cstdint>
+
+namespace ableton::link_kit
+{
+
+// How float samples are reduced to 16 bits
+enum class QuantizationMode
+{
+  // Truncate towards zero, the default conversion
+  Truncate,
+  // Round to nearest
+  Round,
+  // Add triangular (TPDF) dither with a peak amplitude of 1 LSB, then round
+  Dither,
+  // Like Dither, but the dither noise is first order high-pass shaped, which
+  // moves most of its energy to high frequencies
+  ShapedDither,
+};
+
+// Quantizes blocks of float samples to interleaved int16_t. Dither noise comes
+// from independent xorshift generators running in parallel lanes, so noise
+// generation vectorizes along with the conversion. Generator state persists
+// across buffers.
+class Quantizer
+{
+public:
+  static constexpr uint32_t kNumLanes = 8;
+  static constexpr uint32_t kMaxChannels = 2;
+
+  explicit Quantizer(const QuantizationMode mode = QuantizationMode::Truncate)
+    : mMode(mode)
+  {
+    for (uint32_t lane = 0; lane < kNumLanes; ++lane)
+    {
+      mState[lane] = 0x9E3779B9u * (lane + 1);
+    }
+  }
+
+  QuantizationMode mode() const
+  {
+    return mMode;
+  }
+
+  // Quantize up to kBlockSize frames of one or two channels. Dither is added
+  // to the input in place.
+  template <typename Isa>
+  void quantize(const uint32_t numChannels,
+                const uint32_t numFrames,
+                float* left,
+                float* right,
+                int16_t* output)
+  {
+    if (mMode == QuantizationMode::Truncate)
+    {
+      write<Isa, rounding::Truncate>(numChannels, numFrames, left, right, output);
+      return;
+    }
+
+    if (mMode != QuantizationMode::Round)
+    {
+      addDither(0, numFrames, left);
+      if (numChannels == 2)
+      {
+        addDither(1, numFrames, right);
+      }
+    }
+    write<Isa, rounding::Nearest>(numChannels, numFrames, left, right, output);
+  }
+
+private:
+  template <typename Isa, typename Rounding>
+  static void write(const uint32_t numChannels,
+                    const uint32_t numFrames,
+                    const float* left,
+                    const float* right,
+                    int16_t* output)
+  {
+    if (numChannels == 1)
+    {
+      Isa::template convert<float, Rounding>(numFrames, left, output);
+    }
+    else
+    {
+      Isa::template interleave<float, Rounding>(numFrames, left, right, output);
+    }
+  }
+
+  // Advance all generators until at least numSamples values are produced
+  void generate(const uint32_t numSamples, uint32_t* output)
+  {
+    for (uint32_t i = 0; i < numSamples; i += kNumLanes)
+    {
+      for (uint32_t lane = 0; lane < kNumLanes; ++lane)
+      {
+        auto x = mState[lane];
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        mState[lane] = x;
+        output[i + lane] = x;
+      }
+    }
+  }
+
+  void addDither(const uint32_t channel, const uint32_t numFrames, float* samples)
+  {
+    // Scale signed 16 and 32 bit random values to [-0.5, 0.5) LSB, i.e.
+    // 2^-16 * 2^-15 and 2^-32 * 2^-15 in normalized float samples
+    constexpr float kScale16 = 1.0f / 2147483648.0f;
+    constexpr float kScale32 = 1.0f / 140737488355328.0f;
+
+    std::array<uint32_t, kBlockSize + kNumLanes> random;
+    generate(numFrames, random.data());
+
+    if (mMode == QuantizationMode::Dither)
+    {
+      // The sum of two uniform values has a triangular distribution
+      for (uint32_t frame = 0; frame < numFrames; ++frame)
+      {
+        const auto a = static_cast<int16_t>(random[frame] & 0xFFFF);
+        const auto b = static_cast<int16_t>(random[frame] >> 16);
+        samples[frame] += static_cast<float>(a + b) * kScale16;
+      }
+    }
+    else
+    {
+      // The difference of consecutive uniform values is triangular as well,
+      // with a (1 - z^-1) spectrum
+      auto previous = mPrevious[channel];
+      for (uint32_t frame = 0; frame < numFrames; ++frame)
+      {
+        const auto current =
+          static_cast<float>(static_cast<int32_t>(random[frame])) * kScale32;
+        samples[frame] += current - previous;
+        previous = current;
+      }
+      mPrevious[channel] = previous;
+    }
+  }
+
+  QuantizationMode mMode;
+  std::array<uint32_t, kNumLanes> mState;
+  std::array<float, kMaxChannels> mPrevious{};
+};
+
+} // namespace ableton::link_kit
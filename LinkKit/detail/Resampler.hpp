@@ -0,0 +1,244 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#pragma once
+
+#include "BufferConversion.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace ableton::link_kit
+{
+
+// Polyphase FIR resampler reducing the sample rate of one or two channels by a
+// rational ratio L/M. Each output sample is the dot product of kNumTaps input
+// samples with the coefficients of one of L phases of a windowed sinc
+// lowpass. Input is processed in blocks of up to kBlockSize frames, the last
+// kNumTaps - 1 input frames and the output phase are kept across blocks.
+//
+// Configuring allocates the coefficient table and must not happen in the
+// audio thread. A default constructed resampler is inactive.
+class Resampler
+{
+public:
+  static constexpr uint32_t kNumTaps = 32;
+  static constexpr uint32_t kMaxPhases = 1024;
+  static constexpr uint32_t kMaxChannels = 2;
+  // Passband as a fraction of the output Nyquist frequency
+  static constexpr double kBandwidth = 0.9;
+
+  // Set up conversion from inputRate to outputRate. Equal rates deactivate
+  // the resampler. Returns false and deactivates it if the output rate is
+  // higher than the input rate or the reduced ratio needs too many phases.
+  bool configure(const uint32_t inputRate, const uint32_t outputRate)
+  {
+    mCoefficients.clear();
+    mInputRate = inputRate;
+    mOutputRate = inputRate;
+    reset();
+
+    if (inputRate == 0 || outputRate == 0 || outputRate > inputRate)
+    {
+      return false;
+    }
+    if (outputRate == inputRate)
+    {
+      return true;
+    }
+
+    const auto divisor = std::gcd(inputRate, outputRate);
+    const auto numPhases = outputRate / divisor;
+    if (numPhases > kMaxPhases)
+    {
+      return false;
+    }
+
+    mOutputRate = outputRate;
+    mNumPhases = numPhases;
+    mStep = inputRate / divisor;
+    mCoefficients.resize(numPhases * kNumTaps);
+
+    const auto cutoff = kBandwidth * outputRate / inputRate;
+    constexpr auto kPi = 3.14159265358979323846;
+    constexpr auto kHalfLength = kNumTaps / 2.0;
+    for (uint32_t phase = 0; phase < numPhases; ++phase)
+    {
+      auto* coefficients = &mCoefficients[phase * kNumTaps];
+      double sum = 0.0;
+      for (uint32_t tap = 0; tap < kNumTaps; ++tap)
+      {
+        // Distance of the input sample from the output sample, in input
+        // samples
+        const auto x =
+          kHalfLength - 1.0 + static_cast<double>(phase) / numPhases - tap;
+        const auto sinc =
+          x == 0.0 ? 1.0 : std::sin(kPi * cutoff * x) / (kPi * cutoff * x);
+        const auto u = x / kHalfLength;
+        const auto window = 0.42 + 0.5 * std::cos(kPi * u) + 0.08 * std::cos(2.0 * kPi * u);
+        const auto coefficient = sinc * window;
+        coefficients[tap] = static_cast<float>(coefficient);
+        sum += coefficient;
+      }
+      // Unity gain at DC for every phase
+      for (uint32_t tap = 0; tap < kNumTaps; ++tap)
+      {
+        coefficients[tap] = static_cast<float>(coefficients[tap] / sum);
+      }
+    }
+    return true;
+  }
+
+  // Clear the filter history
+  void reset()
+  {
+    for (auto& history : mHistory)
+    {
+      history.fill(0.0f);
+    }
+    mIndex = 0;
+    mPhase = 0;
+  }
+
+  // Advance over numFrames of silent input as if it had been processed,
+  // without filtering it. Clears the history and returns the number of output
+  // frames processing would have produced.
+  uint32_t skip(const uint32_t numFrames)
+  {
+    if (!isActive())
+    {
+      return numFrames;
+    }
+
+    // Positions in units of 1 / mNumPhases input frames
+    const auto position = uint64_t{mIndex} * mNumPhases + mPhase;
+    const auto end = uint64_t{numFrames} * mNumPhases;
+    const auto numOutputFrames = position < end ? (end - position + mStep - 1) / mStep : 0;
+    const auto next = position + numOutputFrames * mStep - end;
+    mIndex = static_cast<uint32_t>(next / mNumPhases);
+    mPhase = static_cast<uint32_t>(next % mNumPhases);
+    for (auto& history : mHistory)
+    {
+      history.fill(0.0f);
+    }
+    return static_cast<uint32_t>(numOutputFrames);
+  }
+
+  bool isActive() const
+  {
+    return !mCoefficients.empty();
+  }
+
+  uint32_t inputRate() const
+  {
+    return mInputRate;
+  }
+
+  uint32_t outputRate() const
+  {
+    return mOutputRate;
+  }
+
+  // Position of the next output frame in input frames, relative to the first
+  // frame of the next input block. Negative because of the filter delay.
+  double nextOutputOffset() const
+  {
+    if (!isActive())
+    {
+      return 0.0;
+    }
+    return static_cast<double>(mIndex) + static_cast<double>(mPhase) / mNumPhases
+           - kNumTaps / 2.0;
+  }
+
+  // Upper bound of the output frames produced from the given number of input
+  // frames
+  uint32_t maxNumOutputFrames(const uint32_t numInputFrames) const
+  {
+    if (!isActive())
+    {
+      return numInputFrames;
+    }
+    return static_cast<uint32_t>((uint64_t{numInputFrames} * mNumPhases + mStep - 1) / mStep);
+  }
+
+  // Resample up to kBlockSize frames of one or two channels. Writes at most
+  // maxNumOutputFrames(numFrames) frames and returns the number of frames
+  // written.
+  uint32_t process(const uint32_t numChannels,
+                   const uint32_t numFrames,
+                   const float* left,
+                   const float* right,
+                   float* outputLeft,
+                   float* outputRight)
+  {
+    const float* inputs[kMaxChannels] = {left, right};
+    float* outputs[kMaxChannels] = {outputLeft, outputRight};
+    for (uint32_t channel = 0; channel < numChannels; ++channel)
+    {
+      std::copy_n(inputs[channel], numFrames, mHistory[channel].begin() + kNumTaps - 1);
+    }
+
+    const auto indexStep = mStep / mNumPhases;
+    const auto phaseStep = mStep % mNumPhases;
+    uint32_t numOutputFrames = 0;
+    while (mIndex < numFrames)
+    {
+      const auto* coefficients = &mCoefficients[mPhase * kNumTaps];
+      for (uint32_t channel = 0; channel < numChannels; ++channel)
+      {
+        outputs[channel][numOutputFrames] =
+          dot(coefficients, mHistory[channel].data() + mIndex);
+      }
+      ++numOutputFrames;
+
+      mIndex += indexStep;
+      mPhase += phaseStep;
+      if (mPhase >= mNumPhases)
+      {
+        mPhase -= mNumPhases;
+        ++mIndex;
+      }
+    }
+    mIndex -= numFrames;
+
+    for (uint32_t channel = 0; channel < numChannels; ++channel)
+    {
+      auto& history = mHistory[channel];
+      std::copy_n(history.begin() + numFrames, kNumTaps - 1, history.begin());
+    }
+    return numOutputFrames;
+  }
+
+private:
+  // Independent partial sums let the compiler vectorize the reduction
+  static float dot(const float* coefficients, const float* samples)
+  {
+    constexpr uint32_t kNumSums = 8;
+    std::array<float, kNumSums> sums{};
+    for (uint32_t tap = 0; tap < kNumTaps; tap += kNumSums)
+    {
+      for (uint32_t i = 0; i < kNumSums; ++i)
+      {
+        sums[i] += coefficients[tap + i] * samples[tap + i];
+      }
+    }
+    return ((sums[0] + sums[4]) + (sums[1] + sums[5]))
+           + ((sums[2] + sums[6]) + (sums[3] + sums[7]));
+  }
+
+  std::vector<float> mCoefficients;
+  std::array<std::array<float, kNumTaps - 1 + kBlockSize>, kMaxChannels> mHistory{};
+  uint32_t mInputRate = 0;
+  uint32_t mOutputRate = 0;
+  uint32_t mNumPhases = 1;
+  uint32_t mStep = 1;
+  // Window start of the next output frame in input frames relative to the
+  // history, and its phase
+  uint32_t mIndex = 0;
+  uint32_t mPhase = 0;
+};
+
+} // namespace ableton::link_kit
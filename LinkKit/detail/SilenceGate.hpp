@@ -0,0 +1,73 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+namespace ableton::link_kit
+{
+
+enum class SilenceGateMode
+{
+  Off,
+  // Gated buffers aren't sent
+  Suppress,
+  // Gated buffers are sent as silence without converting them, so receivers
+  // keep getting a continuous stream
+  SendSilence,
+};
+
+// Decides when a sink stops converting silent input. Parameters can be set
+// from any thread without locking. The audio thread checks each buffer against
+// the threshold and reports whether it is silent, buffers are gated once the
+// input has been silent for the hold time.
+class SilenceGate
+{
+public:
+  // Threshold is the largest linear sample magnitude considered silent.
+  // Lock-free, may be called from any thread.
+  void setParameters(const float threshold,
+                     const uint32_t numHoldFrames,
+                     const SilenceGateMode mode)
+  {
+    // Compared against the converted 16-bit samples, anything below one LSB
+    // is sent as zero anyway
+    const auto scaled = std::clamp(threshold * 32768.0f, 0.0f, 32767.0f);
+    const auto threshold16 = static_cast<uint64_t>(scaled);
+    mParameters.store(uint64_t{numHoldFrames} << 32 | threshold16 << 2
+                        | static_cast<uint64_t>(mode),
+                      std::memory_order_relaxed);
+  }
+
+  SilenceGateMode mode() const
+  {
+    return static_cast<SilenceGateMode>(mParameters.load(std::memory_order_relaxed) & 3);
+  }
+
+  // Largest 16-bit sample magnitude considered silent
+  int16_t threshold() const
+  {
+    return static_cast<int16_t>((mParameters.load(std::memory_order_relaxed) >> 2) & 0x7FFF);
+  }
+
+  // Whether a buffer of numFrames is gated, given whether all its samples are
+  // within the threshold. Audio thread only.
+  bool process(const bool isSilent, const uint32_t numFrames)
+  {
+    const auto parameters = mParameters.load(std::memory_order_relaxed);
+    const auto numHoldFrames = static_cast<uint32_t>(parameters >> 32);
+    const auto isGated = isSilent && mNumSilentFrames >= numHoldFrames;
+    mNumSilentFrames = isSilent ? mNumSilentFrames + numFrames : 0;
+    return isGated;
+  }
+
+private:
+  // Hold frames in the upper 32 bits, then the 15-bit threshold and the mode
+  std::atomic<uint64_t> mParameters{0};
+  // Audio thread state
+  uint64_t mNumSilentFrames = 0;
+};
+
+} // namespace ableton::link_kit
@@ -0,0 +1,35 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace ableton::link_kit
+{
+
+// Running total written by one thread, e.g. the audio thread, and read by any
+// number of threads. As no other thread writes it, the writer adds with a plain
+// load and store instead of a read-modify-write, which would cost a locked
+// instruction on x86 and a retry loop on ARM. Both sides are wait-free.
+template <typename T = uint64_t>
+class SingleWriterCounter
+{
+public:
+  // Writer only. A release add also publishes the writes before it to readers
+  // loading with acquire.
+  void add(const T amount, const std::memory_order order = std::memory_order_relaxed)
+  {
+    mValue.store(mValue.load(std::memory_order_relaxed) + amount, order);
+  }
+
+  T load(const std::memory_order order = std::memory_order_relaxed) const
+  {
+    return mValue.load(order);
+  }
+
+private:
+  std::atomic<T> mValue{0};
+};
+
+} // namespace ableton::link_kit
@@ -0,0 +1,48 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#pragma once
+
+#include "KernelTable.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace ableton::link_kit
+{
+
+// Sinks are sized on the thread configuring them, so that the audio thread
+// never has to grow them. The size follows from the largest buffer the host
+// renders, which Core Audio announces as the maximum frames per slice.
+
+// Frames per buffer assumed until the host announces its maximum, the slice
+// size iOS renders with while the screen is locked
+constexpr uint32_t kDefaultMaxNumFrames = 4096;
+
+// Factor on the announced maximum, for hosts exceeding it
+constexpr uint32_t kSinkCapacityHeadroom = 2;
+
+// Samples the conversion writes at most for a buffer of numFrames input
+// frames, after the channel map and sample rate conversion
+inline uint64_t MaxNumOutputSamples(const ConversionState& state, const uint32_t numFrames)
+{
+  return uint64_t{state.resampler.maxNumOutputFrames(numFrames)} * state.map.numOutputChannels;
+}
+
+// Whether a buffer of numFrames input frames fits a sink holding maxNumSamples
+inline bool FitsSink(const ConversionState& state,
+                     const uint32_t numFrames,
+                     const uint32_t maxNumSamples)
+{
+  return MaxNumOutputSamples(state, numFrames) <= maxNumSamples;
+}
+
+// Samples to request from a sink receiving buffers of up to maxNumFrames input
+// frames, including headroom
+inline uint32_t SinkCapacity(const ConversionState& state, const uint32_t maxNumFrames)
+{
+  const auto numSamples = MaxNumOutputSamples(state, maxNumFrames) * kSinkCapacityHeadroom;
+  return static_cast<uint32_t>(
+    std::min(numSamples, uint64_t{std::numeric_limits<uint32_t>::max()}));
+}
+
+} // namespace ableton::link_kit
@@ -0,0 +1,89 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#pragma once
+
+#include "SingleWriterCounter.hpp"
+#include <array>
+#include <cstdint>
+
+namespace ableton::link_kit
+{
+
+// What became of the buffers committed to a sink. The audio thread counts
+// each outcome, any other thread may read the totals without locking.
+class SinkStats
+{
+public:
+  enum Counter : uint32_t
+  {
+    kCommittedBuffers,
+    kFramesSent,
+    kBytesSent,
+    // Link refused a retained buffer
+    kFailedCommits,
+    // No buffer could be retained, because no peer receives the sink or all
+    // buffers are in use. Link doesn't tell the two apart.
+    kNoBuffer,
+    // No kernel for the format, or fewer input channels than it describes
+    kUnsupportedFormat,
+    // More samples than retained buffers hold
+    kOversized,
+    // Suppressed by the silence gate
+    kGated,
+    // Too short to yield a frame after sample rate conversion. The resampler
+    // keeps the input for the next buffer.
+    kNoOutput,
+    kNumCounters,
+  };
+
+  using Totals = std::array<uint64_t, kNumCounters>;
+
+  // Audio thread only
+  void add(const Counter counter, const uint64_t amount = 1)
+  {
+    mTotals[counter].add(amount);
+  }
+
+  // Count a committed buffer of 16-bit samples. Audio thread only.
+  void addCommit(const bool isCommitted, const uint32_t numFrames, const uint32_t numChannels)
+  {
+    if (!isCommitted)
+    {
+      add(kFailedCommits);
+      return;
+    }
+    add(kCommittedBuffers);
+    add(kFramesSent, numFrames);
+    add(kBytesSent, uint64_t{numFrames} * numChannels * sizeof(int16_t));
+  }
+
+  // Count a converted buffer, false if it yielded no frames to commit. Audio
+  // thread only.
+  bool addConversion(const uint32_t numOutputFrames)
+  {
+    if (numOutputFrames == 0)
+    {
+      add(kNoOutput);
+      return false;
+    }
+    return true;
+  }
+
+  // Totals since construction. Lock-free and read only, any number of threads
+  // may read at once. A buffer counted during the call may be missing from
+  // some of the totals.
+  Totals totals() const
+  {
+    Totals totals;
+    for (uint32_t i = 0; i < kNumCounters; ++i)
+    {
+      totals[i] = mTotals[i].load();
+    }
+    return totals;
+  }
+
+private:
+  std::array<SingleWriterCounter<>, kNumCounters> mTotals;
+};
+
+} // namespace ableton::link_kit
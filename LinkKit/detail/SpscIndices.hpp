@@ -0,0 +1,71 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#pragma once
+
+#include "SingleWriterCounter.hpp"
+#include <cstdint>
+
+namespace ableton::link_kit
+{
+
+// Slot indices of a single producer, single consumer ring. The ring's owner
+// keeps the slots, this only tracks which of them the producer may fill and
+// the consumer may read. Filling or reading a slot happens between asking for
+// its index and committing it, the release stores publish the slot contents
+// to the other thread. Wait-free: nothing locks, allocates or retries.
+class SpscIndices
+{
+public:
+  explicit SpscIndices(const uint32_t capacity)
+    : mCapacity(capacity)
+  {
+  }
+
+  uint32_t capacity() const
+  {
+    return mCapacity;
+  }
+
+  // Slot to fill next, capacity() if all slots are in use. Producer only.
+  uint32_t writeSlot() const
+  {
+    const auto write = mWrite.load();
+    if (write - mRead.load(std::memory_order_acquire) == mCapacity)
+    {
+      return mCapacity;
+    }
+    return static_cast<uint32_t>(write % mCapacity);
+  }
+
+  // Hand the filled slot to the consumer. Producer only.
+  void commitWrite()
+  {
+    mWrite.add(1, std::memory_order_release);
+  }
+
+  // Oldest filled slot, capacity() if there is none. Consumer only.
+  uint32_t readSlot() const
+  {
+    const auto read = mRead.load();
+    if (read == mWrite.load(std::memory_order_acquire))
+    {
+      return mCapacity;
+    }
+    return static_cast<uint32_t>(read % mCapacity);
+  }
+
+  // Hand the read slot back to the producer. Consumer only.
+  void commitRead()
+  {
+    mRead.add(1, std::memory_order_release);
+  }
+
+private:
+  uint32_t mCapacity;
+  // Counts of filled and read slots, on separate cache lines so that the
+  // threads don't contend
+  alignas(64) SingleWriterCounter<> mWrite;
+  alignas(64) SingleWriterCounter<> mRead;
+};
+
+} // namespace ableton::link_kit
@@ -0,0 +1,152 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#pragma once
+
+#include "SingleWriterCounter.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace ableton::link_kit
+{
+
+// Distribution of the durations of a hot path, e.g. a call made once per audio
+// callback. Buckets double in width, so a fixed number of them covers
+// nanoseconds to seconds with enough resolution to tell p99 from p999. The
+// audio thread records without locking, any other thread may take snapshots of
+// the running totals at any time.
+class TimingHistogram
+{
+public:
+  // Bucket 0 counts durations under 1 ns, bucket i durations from 2^(i-1) up
+  // to 2^i ns and the last bucket all longer ones
+  static constexpr uint32_t kNumBuckets = 32;
+
+  struct Snapshot
+  {
+    std::array<uint64_t, kNumBuckets> counts{};
+    uint64_t count = 0;
+    uint64_t totalNanoseconds = 0;
+    uint64_t maxNanoseconds = 0;
+  };
+
+  static uint32_t BucketOf(const uint64_t nanoseconds)
+  {
+    const auto width =
+      nanoseconds == 0 ? 0u : 64u - static_cast<uint32_t>(__builtin_clzll(nanoseconds));
+    return std::min(width, kNumBuckets - 1);
+  }
+
+  // First duration past the bucket
+  static uint64_t BucketEnd(const uint32_t bucket)
+  {
+    return bucket + 1 < kNumBuckets ? uint64_t{1} << bucket
+                                    : std::numeric_limits<uint64_t>::max();
+  }
+
+  // Recording is disabled by default. Lock-free, may be called from any
+  // thread.
+  void setEnabled(const bool isEnabled)
+  {
+    mIsEnabled.store(isEnabled, std::memory_order_relaxed);
+  }
+
+  bool isEnabled() const
+  {
+    return mIsEnabled.load(std::memory_order_relaxed);
+  }
+
+  // Audio thread only
+  void record(const uint64_t nanoseconds)
+  {
+    mCounts[BucketOf(nanoseconds)].add(1);
+    mTotalNanoseconds.add(nanoseconds);
+    if (nanoseconds > mMaxNanoseconds.load(std::memory_order_relaxed))
+    {
+      mMaxNanoseconds.store(nanoseconds, std::memory_order_relaxed);
+    }
+  }
+
+  // Totals since construction. Lock-free and read only, any number of threads
+  // may take snapshots at once. A duration recorded during the call may be
+  // missing from some of the totals.
+  Snapshot snapshot() const
+  {
+    Snapshot snapshot;
+    for (uint32_t i = 0; i < kNumBuckets; ++i)
+    {
+      snapshot.counts[i] = mCounts[i].load();
+      snapshot.count += snapshot.counts[i];
+    }
+    snapshot.totalNanoseconds = mTotalNanoseconds.load();
+    snapshot.maxNanoseconds = mMaxNanoseconds.load(std::memory_order_relaxed);
+    return snapshot;
+  }
+
+private:
+  std::array<SingleWriterCounter<>, kNumBuckets> mCounts;
+  SingleWriterCounter<> mTotalNanoseconds;
+  std::atomic<uint64_t> mMaxNanoseconds{0};
+  std::atomic<bool> mIsEnabled{false};
+};
+
+// Upper bound of the duration below which the given fraction of the recorded
+// durations lie, e.g. 0.99 for p99. Accurate to the bucket width, i.e. within a
+// factor of two, and never more than the longest duration. Zero if nothing was
+// recorded.
+inline uint64_t TimingQuantile(const TimingHistogram::Snapshot& snapshot, const double quantile)
+{
+  if (snapshot.count == 0)
+  {
+    return 0;
+  }
+  const auto rank = std::max(
+    uint64_t{1},
+    static_cast<uint64_t>(std::ceil(std::clamp(quantile, 0.0, 1.0) * snapshot.count)));
+  uint64_t numBelow = 0;
+  for (uint32_t i = 0; i < TimingHistogram::kNumBuckets; ++i)
+  {
+    numBelow += snapshot.counts[i];
+    if (numBelow >= rank)
+    {
+      return std::min(TimingHistogram::BucketEnd(i), snapshot.maxNanoseconds);
+    }
+  }
+  return snapshot.maxNanoseconds;
+}
+
+// Records the time until it goes out of scope, if the histogram is enabled
+class ScopedTiming
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit ScopedTiming(TimingHistogram& histogram)
+    : mpHistogram(histogram.isEnabled() ? &histogram : nullptr)
+    , mBegin(mpHistogram != nullptr ? Clock::now() : Clock::time_point{})
+  {
+  }
+
+  ~ScopedTiming()
+  {
+    if (mpHistogram != nullptr)
+    {
+      const auto duration = Clock::now() - mBegin;
+      mpHistogram->record(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+    }
+  }
+
+  ScopedTiming(const ScopedTiming&) = delete;
+  ScopedTiming& operator=(const ScopedTiming&) = delete;
+
+private:
+  TimingHistogram* mpHistogram;
+  Clock::time_point mBegin;
+};
+
+} // namespace ableton::link_kit
@@ -0,0 +1,73 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace ableton::link_kit
+{
+
+// Hands the latest version of a fixed size state from one writer thread to one
+// reader thread, e.g. settings from a UI thread to the audio thread. Unlike a
+// queue, intermediate versions are skipped and the writer never has to wait
+// for the reader. The writer fills the back buffer and swaps it with the
+// middle one, the reader swaps the middle one with the front buffer if it
+// holds a newer state. Both are wait-free and never see a partially written
+// state. States are copied as bytes, so they have to be trivially copyable.
+class TripleBuffer
+{
+public:
+  // All buffers start out zeroed
+  explicit TripleBuffer(const uint32_t stateSize)
+    : mStateSize(stateSize)
+    , mStorage(size_t{3} * stateSize)
+  {
+  }
+
+  uint32_t stateSize() const
+  {
+    return mStateSize;
+  }
+
+  // Publish a new state of stateSize bytes. Writer only.
+  void write(const void* state)
+  {
+    std::memcpy(buffer(mBack), state, mStateSize);
+    mBack = mMiddle.exchange(mBack | kIsNew, std::memory_order_acq_rel) & kIndexMask;
+  }
+
+  // Copy the latest published state. Returns whether it was published since
+  // the previous read. Reader only.
+  bool read(void* state)
+  {
+    const auto isNew = (mMiddle.load(std::memory_order_relaxed) & kIsNew) != 0;
+    if (isNew)
+    {
+      mFront = mMiddle.exchange(mFront, std::memory_order_acq_rel) & kIndexMask;
+    }
+    std::memcpy(state, buffer(mFront), mStateSize);
+    return isNew;
+  }
+
+private:
+  // The middle index and whether the writer put a new state there
+  static constexpr uint32_t kIndexMask = 3;
+  static constexpr uint32_t kIsNew = 4;
+
+  uint8_t* buffer(const uint32_t index)
+  {
+    return mStorage.data() + size_t{index} * mStateSize;
+  }
+
+  uint32_t mStateSize;
+  std::vector<uint8_t> mStorage;
+  // Each buffer is owned by one side at a time
+  alignas(64) uint32_t mBack = 0;
+  alignas(64) std::atomic<uint32_t> mMiddle{1};
+  alignas(64) uint32_t mFront = 2;
+};
+
+} // namespace ableton::link_kit
@@ -0,0 +1,142 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#include "BeatGrid.hpp"
+#include <ableton/test/CatchWrapper.hpp>
+#include <array>
+#include <vector>
+
+namespace ableton::link_kit
+{
+
+namespace
+{
+
+// 120 bpm at 48 kHz is 24000 frames per beat, a 48 kHz host clock makes one
+// tick per frame
+BufferTimeline timelineAt(const double beatsAtBufferBegin, const double quantum = 4.0)
+{
+  return MakeBufferTimeline(beatsAtBufferBegin, 120.0, 1000000, 48000.0, 48000.0, quantum);
+}
+
+std::vector<GridEvent> findEvents(const BufferTimeline& timeline,
+                                  const uint32_t numFrames,
+                                  const uint32_t subdivisionsPerBeat,
+                                  const std::optional<TransportChange>& transport = {},
+                                  const uint32_t maxNumEvents = 64)
+{
+  std::vector<GridEvent> events(maxNumEvents);
+  events.resize(FindGridEvents(
+    timeline, numFrames, subdivisionsPerBeat, transport, events.data(), maxNumEvents));
+  return events;
+}
+
+} // namespace
+
+TEST_CASE("Beat Grid", "[grid]")
+{
+  SECTION("Beats within a buffer", "[grid]")
+  {
+    // Beats 4, 5 and 6 in a buffer starting half a beat before beat 4
+    const auto events = findEvents(timelineAt(3.5), 70000, 1);
+    REQUIRE(events.size() == 3);
+    CHECK(events[0].frame == 12000);
+    CHECK(events[0].flags == (kGridSubdivision | kGridBeat | kGridQuantum));
+    CHECK(events[0].beats == 4.0);
+    CHECK(events[1].frame == 36000);
+    CHECK(events[1].flags == (kGridSubdivision | kGridBeat));
+    CHECK(events[2].frame == 60000);
+    CHECK(events[2].beats == 6.0);
+  }
+
+  SECTION("Subdivisions", "[grid]")
+  {
+    const auto events = findEvents(timelineAt(0.1), 24000, 4);
+    REQUIRE(events.size() == 4);
+    CHECK(events[0].frame == 3600);
+    CHECK(events[0].flags == kGridSubdivision);
+    CHECK(events[3].frame == 21600);
+    CHECK(events[3].flags == (kGridSubdivision | kGridBeat));
+    CHECK(events[3].beats == 1.0);
+  }
+
+  SECTION("Fractional quanta", "[grid]")
+  {
+    const auto events = findEvents(timelineAt(2.1, 2.5), 24000, 1);
+    REQUIRE(events.size() == 2);
+    CHECK(events[0].frame == 9600);
+    CHECK(events[0].flags == kGridQuantum);
+    CHECK(events[0].beats == 2.5);
+    CHECK(events[1].frame == 21600);
+    CHECK(events[1].flags == (kGridSubdivision | kGridBeat));
+  }
+
+  SECTION("Crossings land in exactly one buffer", "[grid]")
+  {
+    // Crossings between frames are at the following frame, a grid line on
+    // the first frame belongs to the buffer
+    auto events = findEvents(timelineAt(2.0), 256, 1);
+    REQUIRE(events.size() == 1);
+    CHECK(events[0].frame == 0);
+    CHECK(findEvents(timelineAt(2.0 - 256.0 / 24000.0), 256, 1).empty());
+    events = findEvents(timelineAt(2.0 - 0.5 / 24000.0), 256, 1);
+    REQUIRE(events.size() == 1);
+    CHECK(events[0].frame == 1);
+
+    // Consecutive buffers see every crossing once
+    uint32_t numBeats = 0;
+    for (uint32_t buffer = 0; buffer < 1000; ++buffer)
+    {
+      for (const auto& event : findEvents(timelineAt(-1.0 + buffer * 97.0 / 24000.0), 97, 1))
+      {
+        numBeats += (event.flags & kGridBeat) != 0;
+      }
+    }
+    CHECK(numBeats == 5);
+  }
+
+  SECTION("Negative beats", "[grid]")
+  {
+    const auto events = findEvents(timelineAt(-1.25), 24000, 1);
+    REQUIRE(events.size() == 1);
+    CHECK(events[0].frame == 6000);
+    CHECK(events[0].beats == -1.0);
+    CHECK(events[0].flags == (kGridSubdivision | kGridBeat));
+  }
+
+  SECTION("Transport changes", "[grid]")
+  {
+    auto events = findEvents(timelineAt(0.1), 24000, 1, TransportChange{true, 1000100});
+    REQUIRE(events.size() == 2);
+    CHECK(events[0].frame == 100);
+    CHECK(events[0].flags == kGridTransportStart);
+    CHECK(events[0].beats == Approx(0.1 + 100.0 / 24000.0));
+    CHECK(events[1].frame == 21600);
+
+    // Transport changes on a grid line share its event
+    events = findEvents(timelineAt(0.1), 24000, 1, TransportChange{false, 1021600});
+    REQUIRE(events.size() == 1);
+    CHECK(events[0].flags == (kGridSubdivision | kGridBeat | kGridTransportStop));
+    CHECK(events[0].beats == 1.0);
+
+    // Changes outside the buffer aren't events
+    CHECK(findEvents(timelineAt(0.1), 256, 1, TransportChange{true, 999999}).empty());
+    CHECK(findEvents(timelineAt(0.1), 256, 1, TransportChange{true, 1000256}).empty());
+    events = findEvents(timelineAt(0.1), 256, 1, TransportChange{true, 1000255});
+    REQUIRE(events.size() == 1);
+    CHECK(events[0].frame == 255);
+  }
+
+  SECTION("Events are limited to the capacity", "[grid]")
+  {
+    const auto events = findEvents(timelineAt(0.0), 48000, 8, {}, 3);
+    REQUIRE(events.size() == 3);
+    CHECK(events[2].frame == 6000);
+  }
+
+  SECTION("Empty buffers have no events", "[grid]")
+  {
+    CHECK(findEvents(timelineAt(1.0), 0, 1).empty());
+  }
+}
+
+} // namespace ableton::link_kit
@@ -2,13 +2,196 @@
 
 #include "BufferConversion.hpp"
 #include <ableton/test/CatchWrapper.hpp>
+#include <ableton/util/FloatIntConversion.hpp>
+#include <algorithm>
 #include <limits>
 #include <cmath>
+#include <cstring>
+#include <random>
 #include <vector>
 
 namespace ableton::link_kit
 {
 
+namespace
+{
+
+template <typename Isa, typename T>
+void checkKernelMatchesScalar(const std::vector<T>& input)
+{
+  const auto numSamples = static_cast<uint32_t>(input.size());
+  const auto numFrames = numSamples / 2;
+  std::vector<int16_t> expected(numSamples);
+  std::vector<int16_t> output(numSamples);
+
+  CopyBufferMono<T, isa::Scalar>(numSamples, input.data(), expected.data());
+  CopyBufferMono<T, Isa>(numSamples, input.data(), output.data());
+  CHECK(std::equal(output.begin(), output.end(), expected.begin()));
+
+  CopyBufferStereoInterleaved<T, isa::Scalar>(numFrames, input.data(), expected.data());
+  CopyBufferStereoInterleaved<T, Isa>(numFrames, input.data(), output.data());
+  CHECK(std::equal(output.begin(), output.end(), expected.begin()));
+
+  const auto* left = input.data();
+  const auto* right = input.data() + numFrames;
+  CopyBufferStereoNonInterleaved<T, isa::Scalar>(
+    numFrames, left, right, expected.data());
+  CopyBufferStereoNonInterleaved<T, Isa>(numFrames, left, right, output.data());
+  CHECK(std::equal(output.begin(), output.end(), expected.begin()));
+
+  // Every length up to a few vectors, to cover all tail sizes
+  for (uint32_t length = 0; length < 64 && length <= numFrames; ++length)
+  {
+    std::fill(expected.begin(), expected.end(), 0);
+    std::fill(output.begin(), output.end(), 0);
+    CopyBufferStereoNonInterleaved<T, isa::Scalar>(
+      length, left, right, expected.data());
+    CopyBufferStereoNonInterleaved<T, Isa>(length, left, right, output.data());
+    CHECK(std::equal(output.begin(), output.end(), expected.begin()));
+  }
+}
+
+template <typename T>
+void checkKernelsMatchScalar(const std::vector<T>& input)
+{
+  for (const auto instructionSet :
+       {InstructionSet::Sse2, InstructionSet::Avx2, InstructionSet::Neon})
+  {
+    if (IsSupported(instructionSet))
+    {
+      WithInstructionSet(instructionSet, [&](auto tag) {
+        checkKernelMatchesScalar<decltype(tag)>(input);
+      });
+    }
+  }
+}
+
+// All values of a 16-bit type, plus a few to leave a tail for the vector loops
+template <typename T>
+std::vector<T> exhaustiveInput()
+{
+  std::vector<T> input(65536 + 7);
+  for (std::size_t i = 0; i < input.size(); ++i)
+  {
+    input[i] = static_cast<T>(i);
+  }
+  return input;
+}
+
+template <typename T>
+std::vector<T> sampledInput(std::vector<T> input)
+{
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<uint32_t> bits(0, 255);
+  const auto numEdgeCases = input.size();
+  input.resize(numEdgeCases + (1 << 18) + 5);
+  for (std::size_t i = numEdgeCases; i < input.size(); ++i)
+  {
+    uint8_t bytes[sizeof(T)];
+    for (auto& byte : bytes)
+    {
+      byte = static_cast<uint8_t>(bits(rng));
+    }
+    std::memcpy(&input[i], bytes, sizeof(T));
+  }
+  return input;
+}
+
+template <typename T>
+BigEndian<T> toBigEndian(const T input)
+{
+  // Byte swapping is its own inverse
+  return {FromBigEndian(BigEndian<T>{input})};
+}
+
+PackedInt24 packInt24(const int32_t input)
+{
+  const auto value = static_cast<uint32_t>(input);
+  return {{static_cast<uint8_t>(value),
+           static_cast<uint8_t>(value >> 8),
+           static_cast<uint8_t>(value >> 16)}};
+}
+
+// Float edge cases and uniform samples around the audio range
+template <typename T>
+std::vector<T> floatInput()
+{
+  std::vector<T> input = {0.0,
+                          -0.0,
+                          1.0,
+                          -1.0,
+                          0.5,
+                          -0.5,
+                          32767.0 / 32768.0,
+                          -32767.0 / 32768.0,
+                          1.0 / 32768.0,
+                          -1.0 / 32768.0,
+                          1e30,
+                          -1e30,
+                          std::numeric_limits<T>::max(),
+                          std::numeric_limits<T>::lowest(),
+                          std::numeric_limits<T>::infinity(),
+                          -std::numeric_limits<T>::infinity(),
+                          std::numeric_limits<T>::quiet_NaN()};
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<T> audio(-1.5, 1.5);
+  std::generate_n(std::back_inserter(input), 1 << 18, [&] { return audio(rng); });
+  return input;
+}
+
+// Expand with the vector loops and compare bitwise against the scalar loops
+template <typename Isa, typename U>
+void checkExpansionMatchesScalar(const std::vector<int16_t>& input, const float gain)
+{
+  const auto numSamples = static_cast<uint32_t>(input.size());
+  const auto numFrames = numSamples / 2;
+  const auto scale = ExpansionScale<U>(gain);
+  std::vector<U> expected(numSamples);
+  std::vector<U> output(numSamples);
+  const auto isEqual = [&] {
+    return std::memcmp(output.data(), expected.data(), numSamples * sizeof(U)) == 0;
+  };
+
+  isa::Scalar::expand(numSamples, input.data(), expected.data(), scale);
+  Isa::expand(numSamples, input.data(), output.data(), scale);
+  CHECK(isEqual());
+
+  isa::Scalar::deinterleave(
+    numFrames, input.data(), expected.data(), expected.data() + numFrames, scale);
+  Isa::deinterleave(numFrames, input.data(), output.data(), output.data() + numFrames, scale);
+  CHECK(isEqual());
+
+  // Every length up to a few vectors, to cover all tail sizes
+  for (uint32_t length = 0; length < 64 && length <= numFrames; ++length)
+  {
+    std::fill(expected.begin(), expected.end(), U{});
+    std::fill(output.begin(), output.end(), U{});
+    isa::Scalar::deinterleave(
+      length, input.data(), expected.data(), expected.data() + length, scale);
+    Isa::deinterleave(length, input.data(), output.data(), output.data() + length, scale);
+    Isa::expand(length, input.data(), output.data() + 2 * length, scale);
+    isa::Scalar::expand(length, input.data(), expected.data() + 2 * length, scale);
+    CHECK(isEqual());
+  }
+}
+
+template <typename U>
+void checkExpansionsMatchScalar(const std::vector<int16_t>& input, const float gain)
+{
+  for (const auto instructionSet :
+       {InstructionSet::Sse2, InstructionSet::Avx2, InstructionSet::Neon})
+  {
+    if (IsSupported(instructionSet))
+    {
+      WithInstructionSet(instructionSet, [&](auto tag) {
+        checkExpansionMatchesScalar<decltype(tag), U>(input, gain);
+      });
+    }
+  }
+}
+
+} // namespace
+
 TEST_CASE("Type Conversion Tests", "[conversion]")
 {
 
@@ -109,6 +292,78 @@ TEST_CASE("Type Conversion Tests", "[conversion]")
     }
   }
 
+  SECTION("Float conversion matches util::floatToInt16", "[conversion][float]")
+  {
+    // Negative samples are scaled by 2^15, positive samples by 2^15 - 1
+    CHECK(ConvertFloat(0.5f) == 16383);
+    CHECK(ConvertFloat(-0.5f) == -16384);
+    for (const auto value : floatInput<float>())
+    {
+      if (!std::isnan(value))
+      {
+        CHECK(ConvertFloat(value) == util::floatToInt16(value));
+      }
+    }
+  }
+
+  SECTION("Packed Int24 conversion keeps the upper two bytes", "[conversion][int24]")
+  {
+    CHECK(ConvertPackedInt24(packInt24(0)) == 0);
+    CHECK(ConvertPackedInt24(packInt24(0x123456)) == 0x1234);
+    CHECK(ConvertPackedInt24(packInt24(-1)) == -1);
+    CHECK(ConvertPackedInt24(packInt24(0x7FFFFF)) == std::numeric_limits<int16_t>::max());
+    CHECK(ConvertPackedInt24(packInt24(-0x800000)) == std::numeric_limits<int16_t>::min());
+    CHECK(ToFloat(packInt24(0x400000)) == 0.5f);
+    CHECK(ToFloat(packInt24(-0x800000)) == -1.0f);
+  }
+
+  SECTION("Low aligned Int24 conversion ignores the high byte", "[conversion][int24]")
+  {
+    CHECK(ConvertLowAlignedInt24({0x00123456}) == 0x1234);
+    CHECK(ConvertLowAlignedInt24({0x12FEDCBA}) == (int16_t)0xFEDC);
+    CHECK(ConvertLowAlignedInt24({(int32_t)0xFF800000}) == std::numeric_limits<int16_t>::min());
+    CHECK(ConvertLowAlignedInt24({0x007FFFFF}) == std::numeric_limits<int16_t>::max());
+    CHECK(ToFloat(LowAlignedInt24{0x00400000}) == 0.5f);
+    CHECK(ToFloat(LowAlignedInt24{0x7FC00000}) == -0.5f);
+  }
+
+  SECTION("Fixed 8.24 conversion saturates", "[conversion][fixed824]")
+  {
+    CHECK(ConvertFixed824({0}) == 0);
+    CHECK(ConvertFixed824({1 << 23}) == 16384);
+    CHECK(ConvertFixed824({-(1 << 23)}) == -16384);
+    CHECK(ConvertFixed824({1 << 24}) == std::numeric_limits<int16_t>::max());
+    CHECK(ConvertFixed824({-(1 << 24)}) == std::numeric_limits<int16_t>::min());
+    CHECK(ConvertFixed824({std::numeric_limits<int32_t>::max()}) == 32767);
+    CHECK(ConvertFixed824({std::numeric_limits<int32_t>::min()}) == -32768);
+    CHECK(ToFloat(Fixed824{1 << 23}) == 0.5f);
+    CHECK(ToFloat(Fixed824{-(3 << 24)}) == -3.0f);
+  }
+
+  SECTION("Float64 conversion matches Float32", "[conversion][float64]")
+  {
+    for (const auto value : floatInput<float>())
+    {
+      CHECK(ConvertFloat64(value) == ConvertFloat(value));
+    }
+    CHECK(ConvertFloat64(std::numeric_limits<double>::max()) == 32767);
+    CHECK(ConvertFloat64(std::numeric_limits<double>::lowest()) == -32768);
+    CHECK(ToFloat(0.25) == 0.25f);
+  }
+
+  SECTION("Big endian conversion swaps bytes", "[conversion][bigendian]")
+  {
+    CHECK(FromBigEndian(BigEndian<int16_t>{0x3412}) == 0x1234);
+    CHECK(FromBigEndian(BigEndian<int32_t>{0x78563412}) == 0x12345678);
+    CHECK(Convert(toBigEndian<int16_t>(-1234)) == -1234);
+    CHECK(Convert(toBigEndian<int32_t>(0x12345678)) == 0x1234);
+    CHECK(Convert(toBigEndian(0.5f)) == 16383);
+    CHECK(Convert(toBigEndian(-1.0f)) == -32768);
+    CHECK(ToFloat(toBigEndian<int16_t>(-16384)) == -0.5f);
+    CHECK(ToFloat(toBigEndian<int32_t>(0x40000000)) == 0.5f);
+    CHECK(ToFloat(toBigEndian(0.75f)) == 0.75f);
+  }
+
   SECTION("Conversion symmetry", "[conversion][symmetry]")
   {
     // Int32 symmetry
@@ -524,4 +779,280 @@ TEST_CASE("Buffer Copy Tests", "[buffer][copy]")
     CHECK(output[2] == std::numeric_limits<int16_t>::max());
   }
 }
+
+TEST_CASE("Vector Kernel Tests", "[buffer][copy][simd]")
+{
+  SECTION("Int16 kernels match scalar conversion", "[simd][int16]")
+  {
+    checkKernelsMatchScalar(exhaustiveInput<int16_t>());
+  }
+
+  SECTION("UInt16 kernels match scalar conversion", "[simd][uint16]")
+  {
+    checkKernelsMatchScalar(exhaustiveInput<uint16_t>());
+  }
+
+  SECTION("Int32 kernels match scalar conversion", "[simd][int32]")
+  {
+    checkKernelsMatchScalar(sampledInput<int32_t>({0,
+                                                   1,
+                                                   -1,
+                                                   0xFFFF,
+                                                   0x10000,
+                                                   -0x10000,
+                                                   -0x10001,
+                                                   std::numeric_limits<int32_t>::min(),
+                                                   std::numeric_limits<int32_t>::max()}));
+  }
+
+  SECTION("UInt32 kernels match scalar conversion", "[simd][uint32]")
+  {
+    checkKernelsMatchScalar(sampledInput<uint32_t>({0,
+                                                    1,
+                                                    0xFFFF,
+                                                    0x10000,
+                                                    0x7FFFFFFF,
+                                                    0x80000000,
+                                                    0x80010000,
+                                                    std::numeric_limits<uint32_t>::max()}));
+  }
+
+  SECTION("Float kernels match scalar conversion", "[simd][float]")
+  {
+    auto input = sampledInput<float>({0.0f,
+                                      -0.0f,
+                                      1.0f,
+                                      -1.0f,
+                                      0.5f,
+                                      -0.5f,
+                                      32767.0f / 32768.0f,
+                                      -32767.0f / 32768.0f,
+                                      1.0f / 32768.0f,
+                                      -1.0f / 32768.0f,
+                                      1e-40f,
+                                      -1e-40f,
+                                      1e30f,
+                                      -1e30f,
+                                      std::numeric_limits<float>::max(),
+                                      std::numeric_limits<float>::lowest(),
+                                      std::numeric_limits<float>::infinity(),
+                                      -std::numeric_limits<float>::infinity(),
+                                      std::numeric_limits<float>::quiet_NaN()});
+
+    // Random bit patterns rarely hit the audio range, add uniform samples
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> audio(-1.5f, 1.5f);
+    std::generate_n(std::back_inserter(input), 1 << 18, [&] { return audio(rng); });
+
+    checkKernelsMatchScalar(input);
+  }
+
+  SECTION("Float64 kernels match scalar conversion", "[simd][float64]")
+  {
+    checkKernelsMatchScalar(floatInput<double>());
+  }
+
+  SECTION("Packed Int24 kernels match scalar conversion", "[simd][int24]")
+  {
+    checkKernelsMatchScalar(sampledInput<PackedInt24>(
+      {packInt24(0), packInt24(-1), packInt24(0x7FFFFF), packInt24(-0x800000)}));
+  }
+
+  SECTION("Low aligned Int24 kernels match scalar conversion", "[simd][int24]")
+  {
+    checkKernelsMatchScalar(sampledInput<LowAlignedInt24>(
+      {{0}, {-1}, {0x007FFFFF}, {0x00800000}, {(int32_t)0xFF7FFFFF}}));
+  }
+
+  SECTION("Fixed 8.24 kernels match scalar conversion", "[simd][fixed824]")
+  {
+    checkKernelsMatchScalar(sampledInput<Fixed824>({{0},
+                                                    {1 << 24},
+                                                    {-(1 << 24)},
+                                                    {(1 << 24) - 1},
+                                                    {std::numeric_limits<int32_t>::min()},
+                                                    {std::numeric_limits<int32_t>::max()}}));
+  }
+
+  SECTION("Big endian Int16 kernels match scalar conversion", "[simd][bigendian]")
+  {
+    std::vector<BigEndian<int16_t>> input;
+    for (const auto value : exhaustiveInput<int16_t>())
+    {
+      input.push_back(toBigEndian(value));
+    }
+    checkKernelsMatchScalar(input);
+  }
+
+  SECTION("Big endian Int32 kernels match scalar conversion", "[simd][bigendian]")
+  {
+    checkKernelsMatchScalar(sampledInput<BigEndian<int32_t>>(
+      {toBigEndian<int32_t>(0x12345678), toBigEndian(std::numeric_limits<int32_t>::min())}));
+  }
+
+  SECTION("Big endian Float kernels match scalar conversion", "[simd][bigendian]")
+  {
+    std::vector<BigEndian<float>> input;
+    for (const auto value : floatInput<float>())
+    {
+      input.push_back(toBigEndian(value));
+    }
+    checkKernelsMatchScalar(input);
+  }
+
+  SECTION("Downmix accumulation matches scalar", "[simd][downmix]")
+  {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> values(-1.0f, 1.0f);
+    const auto random = [&] { return values(rng); };
+    std::vector<float> input(67);
+    std::vector<float> sums(2 * input.size());
+    std::generate(input.begin(), input.end(), random);
+    std::generate(sums.begin(), sums.end(), random);
+    const auto numFrames = static_cast<uint32_t>(input.size());
+
+    for (const auto instructionSet :
+         {InstructionSet::Sse2, InstructionSet::Avx2, InstructionSet::Neon})
+    {
+      if (!IsSupported(instructionSet))
+      {
+        continue;
+      }
+      WithInstructionSet(instructionSet, [&](auto tag) {
+        using Isa = decltype(tag);
+        for (const uint32_t numOutputChannels : {1u, 2u})
+        {
+          // Every length up to a few vectors, to cover all tail sizes
+          for (uint32_t length = 0; length <= numFrames; ++length)
+          {
+            auto expected = sums;
+            auto output = sums;
+            isa::Scalar::accumulate(numOutputChannels,
+                                    length,
+                                    input.data(),
+                                    0.7071f,
+                                    -0.5f,
+                                    expected.data(),
+                                    expected.data() + numFrames);
+            Isa::accumulate(numOutputChannels,
+                            length,
+                            input.data(),
+                            0.7071f,
+                            -0.5f,
+                            output.data(),
+                            output.data() + numFrames);
+            CHECK(std::memcmp(output.data(), expected.data(), sums.size() * sizeof(float)) == 0);
+          }
+        }
+      });
+    }
+  }
+}
+
+TEST_CASE("Expansion Tests", "[expansion]")
+{
+  const auto input = exhaustiveInput<int16_t>();
+
+  SECTION("Float round trip is exact", "[expansion][float]")
+  {
+    const auto scale = ExpansionScale<float>(1.0f);
+    for (const auto sample : input)
+    {
+      const auto expanded = ExpandFloat(sample, scale);
+      CHECK(expanded == static_cast<float>(sample) / (sample < 0 ? 32768.0f : 32767.0f));
+      CHECK(ConvertFloat(expanded) == sample);
+    }
+  }
+
+  SECTION("Int32 round trip is exact", "[expansion][int32]")
+  {
+    const auto scale = ExpansionScale<int32_t>(1.0f);
+    for (const auto sample : input)
+    {
+      const auto expanded = ExpandInt32(sample, scale);
+      CHECK(expanded == static_cast<int32_t>(sample) * 65536);
+      CHECK(ConvertInt32(expanded) == sample);
+    }
+  }
+
+  SECTION("Gain is applied while expanding", "[expansion][gain]")
+  {
+    CHECK(ExpandFloat(-16384, ExpansionScale<float>(0.5f)) == -0.25f);
+    CHECK(ExpandFloat(32767, ExpansionScale<float>(0.5f)) == 0.5f);
+    CHECK(ExpandFloat(-32768, ExpansionScale<float>(2.0f)) == -2.0f);
+    CHECK(ExpandFloat(1000, ExpansionScale<float>(0.0f)) == 0.0f);
+    CHECK(ExpandInt32(16384, ExpansionScale<int32_t>(0.5f)) == 1 << 29);
+    CHECK(ExpandInt32(-3, ExpansionScale<int32_t>(-1.0f)) == 3 * 65536);
+  }
+
+  SECTION("Int32 expansion saturates", "[expansion][int32]")
+  {
+    const auto scale = ExpansionScale<int32_t>(4.0f);
+    CHECK(ExpandInt32(32767, scale) == 2147483520);
+    CHECK(ExpandInt32(-32768, scale) == std::numeric_limits<int32_t>::min());
+    CHECK(ExpandInt32(8191, scale) == 8191 * 262144);
+  }
+
+  SECTION("Vector loops match the scalar loops", "[expansion][simd]")
+  {
+    for (const auto gain : {1.0f, 0.5f, 0.0f, -1.0f, 3.7f, 70000.0f})
+    {
+      checkExpansionsMatchScalar<float>(input, gain);
+      checkExpansionsMatchScalar<int32_t>(input, gain);
+    }
+  }
+}
+
+TEST_CASE("Instruction Set Dispatch", "[buffer][simd][dispatch]")
+{
+  SECTION("Best instruction set is supported", "[simd][dispatch]")
+  {
+    CHECK(IsSupported(BestInstructionSet()));
+    CHECK(BestInstructionSet() == DetectInstructionSet());
+  }
+
+  SECTION("Scalar is always supported", "[simd][dispatch]")
+  {
+    CHECK(IsSupported(InstructionSet::Scalar));
+  }
+
+  SECTION("Dispatch selects the matching kernel", "[simd][dispatch]")
+  {
+    using CopyFn = void (*)(uint32_t, const float*, int16_t*);
+    const auto select = [](const InstructionSet instructionSet) {
+      return WithInstructionSet(instructionSet, [](auto tag) -> CopyFn {
+        return &CopyBufferMono<float, decltype(tag)>;
+      });
+    };
+
+    CHECK(select(InstructionSet::Scalar) == &CopyBufferMono<float, isa::Scalar>);
+#if defined(LINK_KIT_SIMD_SSE2)
+    CHECK(select(InstructionSet::Sse2) == &CopyBufferMono<float, isa::Sse2>);
+    CHECK(select(InstructionSet::Avx2) == &CopyBufferMono<float, isa::Avx2>);
+#endif
+#if defined(LINK_KIT_SIMD_NEON)
+    CHECK(select(InstructionSet::Neon) == &CopyBufferMono<float, isa::Neon>);
+#endif
+  }
+
+  SECTION("Best kernel matches scalar conversion", "[simd][dispatch]")
+  {
+    std::vector<float> input(1027);
+    for (std::size_t i = 0; i < input.size(); ++i)
+    {
+      input[i] = std::sin(static_cast<float>(i) * 0.01f) * 1.2f;
+    }
+    std::vector<int16_t> expected(input.size());
+    std::vector<int16_t> output(input.size());
+    const auto numSamples = static_cast<uint32_t>(input.size());
+
+    CopyBufferMono<float, isa::Scalar>(numSamples, input.data(), expected.data());
+    WithInstructionSet(BestInstructionSet(), [&](auto tag) {
+      CopyBufferMono<float, decltype(tag)>(numSamples, input.data(), output.data());
+    });
+
+    CHECK(output == expected);
+  }
+}
+
 } // namespace ableton::link_kit
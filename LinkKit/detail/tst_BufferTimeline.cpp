@@ -0,0 +1,74 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#include "BufferTimeline.hpp"
+#include <ableton/test/CatchWrapper.hpp>
+
+namespace ableton::link_kit
+{
+
+TEST_CASE("Phase", "[timeline]")
+{
+  CHECK(PhaseOf(5.5, 4.0) == 1.5);
+  CHECK(PhaseOf(4.0, 4.0) == 0.0);
+  CHECK(PhaseOf(-1.0, 4.0) == 3.0);
+  CHECK(PhaseOf(-4.0, 4.0) == 0.0);
+  CHECK(PhaseOf(3.0, 0.0) == 0.0);
+}
+
+TEST_CASE("Buffer Timeline", "[timeline]")
+{
+  // 120 bpm at 48 kHz is 24000 frames per beat, a 24 MHz host clock makes
+  // 500 ticks per frame
+  const auto timeline = MakeBufferTimeline(3.5, 120.0, 1000000, 24e6, 48000.0, 4.0);
+
+  SECTION("Beats", "[timeline]")
+  {
+    CHECK(timeline.beatAtFrame(0) == 3.5);
+    CHECK(timeline.beatAtFrame(12000) == Approx(4.0));
+    CHECK(timeline.beatAtFrame(-24000) == Approx(2.5));
+  }
+
+  SECTION("Phase wraps at the quantum", "[timeline]")
+  {
+    CHECK(timeline.phaseAtFrame(0) == 3.5);
+    CHECK(timeline.phaseAtFrame(6000) == Approx(3.75));
+    CHECK(timeline.phaseAtFrame(18000) == Approx(0.25));
+    CHECK(timeline.phaseAtFrame(24000 * 9) == Approx(0.5));
+  }
+
+  SECTION("Host time", "[timeline]")
+  {
+    CHECK(timeline.hostTimeAtFrame(0) == 1000000);
+    CHECK(timeline.hostTimeAtFrame(256) == 1128000);
+    CHECK(timeline.hostTimeAtFrame(0.4) == 1000200);
+  }
+
+  SECTION("Frames of beats", "[timeline]")
+  {
+    CHECK(timeline.frameAtBeat(3.5) == 0.0);
+    CHECK(timeline.frameAtBeat(4.0) == Approx(12000.0));
+    CHECK(timeline.frameAtBeat(3.0) == Approx(-12000.0));
+    for (const auto frame : {1.0, 17.0, 511.0})
+    {
+      CHECK(timeline.frameAtBeat(timeline.beatAtFrame(frame)) == Approx(frame));
+    }
+  }
+
+  SECTION("Advanced timelines continue the buffer", "[timeline]")
+  {
+    const auto next = timeline.advanced(18000);
+    CHECK(next.beatAtFrame(0) == Approx(timeline.beatAtFrame(18000)));
+    CHECK(next.phaseAtFrame(0) == Approx(0.25));
+    CHECK(next.hostTimeAtFrame(10) == timeline.hostTimeAtFrame(18010));
+    CHECK(next.quantum == timeline.quantum);
+  }
+
+  SECTION("Frames of host times", "[timeline]")
+  {
+    CHECK(timeline.frameAtHostTime(1000000) == 0.0);
+    CHECK(timeline.frameAtHostTime(1128000) == 256.0);
+    CHECK(timeline.frameAtHostTime(999750) == -0.5);
+  }
+}
+
+} // namespace ableton::link_kit
@@ -0,0 +1,279 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#include "ChannelMap.hpp"
+#include <ableton/test/CatchWrapper.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace ableton::link_kit
+{
+
+namespace
+{
+
+constexpr uint32_t kNumInputChannels = 8;
+constexpr uint32_t kNumFrames = 203;
+
+// Interleaved test signal with a distinct ramp per channel
+template <typename T>
+std::vector<T> makeInterleaved()
+{
+  std::vector<T> input(kNumFrames * kNumInputChannels);
+  for (uint32_t frame = 0; frame < kNumFrames; ++frame)
+  {
+    for (uint32_t channel = 0; channel < kNumInputChannels; ++channel)
+    {
+      const auto value =
+        std::sin(static_cast<float>(frame) * 0.05f * static_cast<float>(channel + 1));
+      if constexpr (std::is_same_v<T, float>)
+      {
+        input[frame * kNumInputChannels + channel] = 0.9f * value;
+      }
+      else
+      {
+        input[frame * kNumInputChannels + channel] = static_cast<T>(30000.0f * value);
+      }
+    }
+  }
+  return input;
+}
+
+template <typename T>
+InputChannels<T> interleavedChannels(const std::vector<T>& input)
+{
+  InputChannels<T> channels;
+  for (uint32_t channel = 0; channel < kNumInputChannels; ++channel)
+  {
+    channels.data[channel] = input.data() + channel;
+  }
+  channels.strides.fill(kNumInputChannels * sizeof(T));
+  return channels;
+}
+
+template <typename T>
+std::vector<std::vector<T>> deinterleave(const std::vector<T>& input)
+{
+  std::vector<std::vector<T>> planar(kNumInputChannels, std::vector<T>(kNumFrames));
+  for (uint32_t frame = 0; frame < kNumFrames; ++frame)
+  {
+    for (uint32_t channel = 0; channel < kNumInputChannels; ++channel)
+    {
+      planar[channel][frame] = input[frame * kNumInputChannels + channel];
+    }
+  }
+  return planar;
+}
+
+template <typename T>
+InputChannels<T> planarChannels(const std::vector<std::vector<T>>& planar)
+{
+  InputChannels<T> channels;
+  for (uint32_t channel = 0; channel < kNumInputChannels; ++channel)
+  {
+    channels.data[channel] = planar[channel].data();
+  }
+  return channels;
+}
+
+template <typename Fn>
+void forEachSupportedInstructionSet(Fn fn)
+{
+  for (const auto instructionSet : {InstructionSet::Scalar,
+                                    InstructionSet::Sse2,
+                                    InstructionSet::Avx2,
+                                    InstructionSet::Neon})
+  {
+    if (IsSupported(instructionSet))
+    {
+      WithInstructionSet(instructionSet, fn);
+    }
+  }
+}
+
+} // namespace
+
+TEST_CASE("Channel Map Construction", "[channelmap]")
+{
+  SECTION("Selection routes input channels", "[channelmap]")
+  {
+    const uint32_t inputs[] = {5, 2};
+    const auto map = MakeChannelSelection(inputs, 2);
+    REQUIRE(map);
+    CHECK(map->isRouting);
+    CHECK(map->numInputChannels == 6);
+    CHECK(map->numOutputChannels == 2);
+    CHECK(map->sources[0] == 5);
+    CHECK(map->sources[1] == 2);
+  }
+
+  SECTION("Invalid selections are rejected", "[channelmap]")
+  {
+    const uint32_t inputs[] = {0, 1, 2};
+    CHECK_FALSE(MakeChannelSelection(inputs, 0));
+    CHECK_FALSE(MakeChannelSelection(inputs, 3));
+    const uint32_t outOfRange[] = {ChannelMap::kMaxInputChannels};
+    CHECK_FALSE(MakeChannelSelection(outOfRange, 1));
+  }
+
+  SECTION("Unity matrix is detected as routing", "[channelmap]")
+  {
+    const float gains[] = {0, 0, 1, 0, //
+                           1, 0, 0, 0};
+    const auto map = MakeChannelMatrix(gains, 4, 2);
+    REQUIRE(map);
+    CHECK(map->isRouting);
+    CHECK(map->sources[0] == 2);
+    CHECK(map->sources[1] == 0);
+  }
+
+  SECTION("Mixing matrix is not routing", "[channelmap]")
+  {
+    const float gains[] = {0.5f, 0.5f, 0, 0};
+    const auto map = MakeChannelMatrix(gains, 4, 1);
+    REQUIRE(map);
+    CHECK_FALSE(map->isRouting);
+  }
+
+  SECTION("Invalid matrices are rejected", "[channelmap]")
+  {
+    const float gains[] = {1, 1, 1};
+    CHECK_FALSE(MakeChannelMatrix(gains, 0, 1));
+    CHECK_FALSE(MakeChannelMatrix(gains, 1, 3));
+    CHECK_FALSE(MakeChannelMatrix(gains, ChannelMap::kMaxInputChannels + 1, 1));
+  }
+
+  SECTION("Default map", "[channelmap]")
+  {
+    CHECK(DefaultChannelMap(1).numOutputChannels == 1);
+    CHECK(DefaultChannelMap(2).numOutputChannels == 2);
+    const auto map = DefaultChannelMap(8);
+    CHECK(map.isRouting);
+    CHECK(map.numOutputChannels == 2);
+    CHECK(map.sources[0] == 0);
+    CHECK(map.sources[1] == 1);
+  }
+}
+
+TEST_CASE("Mapped Buffer Copy", "[channelmap][buffer][copy]")
+{
+  SECTION("Select channels from interleaved Int16", "[channelmap][int16]")
+  {
+    const auto input = makeInterleaved<int16_t>();
+    const uint32_t inputs[] = {5, 2};
+    const auto map = *MakeChannelSelection(inputs, 2);
+
+    forEachSupportedInstructionSet([&](auto tag) {
+      std::vector<int16_t> output(kNumFrames * 2);
+      CopyBufferMapped<int16_t, decltype(tag)>(
+        map, kNumFrames, interleavedChannels(input), output.data());
+      for (uint32_t frame = 0; frame < kNumFrames; ++frame)
+      {
+        CHECK(output[2 * frame] == input[frame * kNumInputChannels + 5]);
+        CHECK(output[2 * frame + 1] == input[frame * kNumInputChannels + 2]);
+      }
+    });
+  }
+
+  SECTION("Select channel from planar Float32", "[channelmap][float32]")
+  {
+    const auto planar = deinterleave(makeInterleaved<float>());
+    const uint32_t inputs[] = {7};
+    const auto map = *MakeChannelSelection(inputs, 1);
+
+    forEachSupportedInstructionSet([&](auto tag) {
+      std::vector<int16_t> output(kNumFrames);
+      CopyBufferMapped<float, decltype(tag)>(
+        map, kNumFrames, planarChannels(planar), output.data());
+      for (uint32_t frame = 0; frame < kNumFrames; ++frame)
+      {
+        CHECK(output[frame] == ConvertFloat(planar[7][frame]));
+      }
+    });
+  }
+
+  SECTION("Selection matches plain conversion for Int32", "[channelmap][int32]")
+  {
+    const auto input = makeInterleaved<int32_t>();
+    const uint32_t inputs[] = {3, 4};
+    const auto map = *MakeChannelSelection(inputs, 2);
+
+    std::vector<int16_t> output(kNumFrames * 2);
+    CopyBufferMapped<int32_t>(map, kNumFrames, interleavedChannels(input), output.data());
+    for (uint32_t frame = 0; frame < kNumFrames; ++frame)
+    {
+      CHECK(output[2 * frame] == ConvertInt32(input[frame * kNumInputChannels + 3]));
+      CHECK(output[2 * frame + 1] == ConvertInt32(input[frame * kNumInputChannels + 4]));
+    }
+  }
+
+  SECTION("Downmix to mono", "[channelmap][downmix]")
+  {
+    const auto input = makeInterleaved<float>();
+    std::vector<float> gains(kNumInputChannels, 1.0f / kNumInputChannels);
+    const auto map = *MakeChannelMatrix(gains.data(), kNumInputChannels, 1);
+
+    forEachSupportedInstructionSet([&](auto tag) {
+      std::vector<int16_t> output(kNumFrames);
+      CopyBufferMapped<float, decltype(tag)>(
+        map, kNumFrames, interleavedChannels(input), output.data());
+      for (uint32_t frame = 0; frame < kNumFrames; ++frame)
+      {
+        float sum = 0.0f;
+        for (uint32_t channel = 0; channel < kNumInputChannels; ++channel)
+        {
+          sum += gains[channel] * input[frame * kNumInputChannels + channel];
+        }
+        CHECK(std::abs(output[frame] - ConvertFloat(sum)) <= 1);
+      }
+    });
+  }
+
+  SECTION("Downmix planar Int16 to stereo", "[channelmap][downmix]")
+  {
+    const auto planar = deinterleave(makeInterleaved<int16_t>());
+    // Even channels left, odd channels right
+    std::vector<float> gains(2 * kNumInputChannels, 0.0f);
+    for (uint32_t channel = 0; channel < kNumInputChannels; ++channel)
+    {
+      gains[(channel % 2) * kNumInputChannels + channel] = 0.25f;
+    }
+    const auto map = *MakeChannelMatrix(gains.data(), kNumInputChannels, 2);
+
+    forEachSupportedInstructionSet([&](auto tag) {
+      std::vector<int16_t> output(kNumFrames * 2);
+      CopyBufferMapped<int16_t, decltype(tag)>(
+        map, kNumFrames, planarChannels(planar), output.data());
+      for (uint32_t frame = 0; frame < kNumFrames; ++frame)
+      {
+        for (uint32_t side = 0; side < 2; ++side)
+        {
+          float sum = 0.0f;
+          for (uint32_t channel = side; channel < kNumInputChannels; channel += 2)
+          {
+            sum += 0.25f * ToFloat(planar[channel][frame]);
+          }
+          CHECK(std::abs(output[2 * frame + side] - ConvertFloat(sum)) <= 1);
+        }
+      }
+    });
+  }
+
+  SECTION("Downmix clips at full scale", "[channelmap][downmix]")
+  {
+    const std::vector<float> input(kNumFrames * kNumInputChannels, 0.5f);
+    std::vector<float> gains(kNumInputChannels, 1.0f);
+    const auto map = *MakeChannelMatrix(gains.data(), kNumInputChannels, 1);
+
+    std::vector<int16_t> output(kNumFrames);
+    CopyBufferMapped<float>(map, kNumFrames, interleavedChannels(input), output.data());
+    for (const auto sample : output)
+    {
+      CHECK(sample == std::numeric_limits<int16_t>::max());
+    }
+  }
+}
+
+} // namespace ableton::link_kit
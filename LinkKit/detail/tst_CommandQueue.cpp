@@ -0,0 +1,95 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#include "CommandQueue.hpp"
+#include <ableton/test/CatchWrapper.hpp>
+#include <thread>
+
+namespace ableton::link_kit
+{
+
+namespace
+{
+
+struct Command
+{
+  uint32_t type;
+  double value;
+};
+
+} // namespace
+
+TEST_CASE("Command Queue", "[queue]")
+{
+  SECTION("Commands come out in order", "[queue]")
+  {
+    CommandQueue queue(sizeof(Command), 4);
+    Command command{};
+    CHECK_FALSE(queue.pop(&command));
+
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+      const Command pushed{i, i * 0.5};
+      CHECK(queue.push(&pushed));
+    }
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+      REQUIRE(queue.pop(&command));
+      CHECK(command.type == i);
+      CHECK(command.value == i * 0.5);
+    }
+    CHECK_FALSE(queue.pop(&command));
+  }
+
+  SECTION("Full queues drop commands", "[queue]")
+  {
+    CommandQueue queue(sizeof(Command), 2);
+    const Command pushed{7, 1.0};
+    CHECK(queue.push(&pushed));
+    CHECK(queue.push(&pushed));
+    CHECK_FALSE(queue.push(&pushed));
+
+    Command command{};
+    CHECK(queue.pop(&command));
+    CHECK(queue.push(&pushed));
+  }
+
+  SECTION("Concurrent pushes and pops", "[queue]")
+  {
+    constexpr uint32_t kNumCommands = 100000;
+    CommandQueue queue(sizeof(Command), 16);
+    std::thread producer([&] {
+      for (uint32_t i = 0; i < kNumCommands;)
+      {
+        const Command command{i, i * 2.0};
+        if (queue.push(&command))
+        {
+          ++i;
+        }
+        else
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    uint32_t numReceived = 0;
+    uint32_t numMismatches = 0;
+    while (numReceived < kNumCommands)
+    {
+      Command command{};
+      if (queue.pop(&command))
+      {
+        numMismatches += command.type != numReceived || command.value != numReceived * 2.0;
+        ++numReceived;
+      }
+      else
+      {
+        std::this_thread::yield();
+      }
+    }
+    producer.join();
+    CHECK(numMismatches == 0);
+  }
+}
+
+} // namespace ableton::link_kit
@@ -0,0 +1,83 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#include "EventMailbox.hpp"
+#include <ableton/test/CatchWrapper.hpp>
+#include <thread>
+
+namespace ableton::link_kit
+{
+
+TEST_CASE("Event Mailbox", "[mailbox]")
+{
+  EventMailbox mailbox(120.0);
+
+  SECTION("Starts without changes", "[mailbox]")
+  {
+    const auto events = mailbox.poll();
+    CHECK(events.changes == 0);
+    CHECK(events.tempo == 120.0);
+    CHECK(events.numPeers == 0);
+    CHECK_FALSE(events.isPlaying);
+  }
+
+  SECTION("Bursts are coalesced into the latest values", "[mailbox]")
+  {
+    CHECK(mailbox.postTempo(121.0));
+    CHECK_FALSE(mailbox.postTempo(122.0));
+    CHECK_FALSE(mailbox.postNumPeers(2));
+    CHECK_FALSE(mailbox.postTempo(123.0));
+
+    auto events = mailbox.poll();
+    CHECK(events.changes == (EventMailbox::kTempo | EventMailbox::kNumPeers));
+    CHECK(events.tempo == 123.0);
+    CHECK(events.numPeers == 2);
+    CHECK(mailbox.poll().changes == 0);
+
+    CHECK(mailbox.postIsPlaying(true));
+    events = mailbox.poll();
+    CHECK(events.changes == EventMailbox::kIsPlaying);
+    CHECK(events.isPlaying);
+    CHECK(events.tempo == 123.0);
+  }
+
+  SECTION("Concurrent posts and polls", "[mailbox]")
+  {
+    constexpr uint32_t kNumEvents = 100000;
+    // Tempos count up from the initial 120 bpm
+    constexpr double kFinalTempo = 120.0 + kNumEvents;
+    uint32_t numWakeups = 0;
+    std::thread producer([&] {
+      for (uint32_t i = 1; i <= kNumEvents; ++i)
+      {
+        numWakeups += mailbox.postTempo(120.0 + i);
+        numWakeups += mailbox.postNumPeers(i);
+        if (i % 64 == 0)
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    // Values only move forward, and every wakeup is matched by a poll
+    // with changes
+    uint32_t numPolls = 0;
+    uint32_t numOutOfOrder = 0;
+    double tempo = 0.0;
+    uint64_t numPeers = 0;
+    while (numPeers < kNumEvents || tempo < kFinalTempo)
+    {
+      const auto events = mailbox.poll();
+      numPolls += events.changes != 0;
+      numOutOfOrder += events.tempo < tempo || events.numPeers < numPeers;
+      tempo = events.tempo;
+      numPeers = events.numPeers;
+      std::this_thread::yield();
+    }
+    producer.join();
+    numPolls += mailbox.poll().changes != 0;
+    CHECK(numOutOfOrder == 0);
+    CHECK(numWakeups == numPolls);
+  }
+}
+
+} // namespace ableton::link_kit
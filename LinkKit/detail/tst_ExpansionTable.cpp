@@ -0,0 +1,120 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#include "ExpansionTable.hpp"
+#include "tst_Fixtures.hpp"
+#include <ableton/test/CatchWrapper.hpp>
+#include <vector>
+
+namespace ableton::link_kit
+{
+
+namespace
+{
+
+constexpr uint32_t kNumFrames = 333;
+
+std::vector<int16_t> rampInput(const uint32_t numSamples)
+{
+  std::vector<int16_t> input(numSamples);
+  for (uint32_t i = 0; i < numSamples; ++i)
+  {
+    input[i] = static_cast<int16_t>(i * 97 - 20000);
+  }
+  return input;
+}
+
+} // namespace
+
+TEST_CASE("Expansion Table", "[expansion][kernels]")
+{
+  const auto& table = kExpansionTable<isa::Scalar>;
+  const auto float32 = LayoutOf<float>();
+  const auto int32 = LayoutOf<int32_t>();
+
+  SECTION("Formats pick their kernels", "[expansion][kernels]")
+  {
+    const auto select = [](const FormatDescriptor& format, const uint32_t numInputChannels) {
+      return SelectExpansionKernel(format, numInputChannels, InstructionSet::Scalar);
+    };
+    CHECK(select(makeFormat(float32, 1, false), 1) == table[0].contiguous[0]);
+    CHECK(select(makeFormat(float32, 2, true), 2) == table[0].contiguous[1]);
+    CHECK(select(makeFormat(float32, 2, false), 2) == table[0].deinterleave);
+    CHECK(select(makeFormat(float32, 2, false), 1) == table[0].duplicate);
+    CHECK(select(makeFormat(int32, 2, false), 2) == table[1].deinterleave);
+    CHECK(select(makeFormat(int32, 1, true), 1) == table[1].contiguous[0]);
+  }
+
+  SECTION("Unsupported formats have no kernel", "[expansion][kernels]")
+  {
+    const auto select = [](const FormatDescriptor& format, const uint32_t numInputChannels) {
+      return SelectExpansionKernel(format, numInputChannels, InstructionSet::Scalar);
+    };
+    CHECK(select(makeFormat(LayoutOf<int16_t>(), 2, true), 2) == nullptr);
+    CHECK(select(makeFormat(LayoutOf<double>(), 2, true), 2) == nullptr);
+    CHECK(select(makeFormat(float32, 2, true), 1) == nullptr);
+    CHECK(select(makeFormat(float32, 1, true), 2) == nullptr);
+    CHECK(select(makeFormat(float32, 6, true), 2) == nullptr);
+    CHECK(select(makeFormat(float32, 2, true), 0) == nullptr);
+
+    auto padded = makeFormat(float32, 2, true);
+    padded.bytesPerFrame = 12;
+    CHECK(select(padded, 2) == nullptr);
+  }
+
+  SECTION("Planar stereo output", "[expansion][kernels]")
+  {
+    const auto input = rampInput(2 * kNumFrames);
+    for (const auto instructionSet : {InstructionSet::Scalar, BestInstructionSet()})
+    {
+      const auto kernel =
+        SelectExpansionKernel(makeFormat(float32, 2, false), 2, instructionSet);
+      std::vector<float> left(kNumFrames);
+      std::vector<float> right(kNumFrames);
+      OutputBuffers output;
+      output.buffers = {left.data(), right.data()};
+      output.numBuffers = 2;
+      kernel(kNumFrames, input.data(), output, 0.5f);
+      for (uint32_t frame = 0; frame < kNumFrames; ++frame)
+      {
+        CHECK(left[frame] == 0.5f * ToFloat(input[2 * frame]));
+        CHECK(right[frame] == 0.5f * ToFloat(input[2 * frame + 1]));
+      }
+    }
+  }
+
+  SECTION("Mono into planar stereo output", "[expansion][kernels]")
+  {
+    const auto input = rampInput(kNumFrames);
+    const auto kernel =
+      SelectExpansionKernel(makeFormat(int32, 2, false), 1, BestInstructionSet());
+    std::vector<int32_t> left(kNumFrames);
+    std::vector<int32_t> right(kNumFrames);
+    OutputBuffers output;
+    output.buffers = {left.data(), right.data()};
+    output.numBuffers = 2;
+    kernel(kNumFrames, input.data(), output, 1.0f);
+    for (uint32_t frame = 0; frame < kNumFrames; ++frame)
+    {
+      CHECK(left[frame] == input[frame] * 65536);
+      CHECK(right[frame] == input[frame] * 65536);
+    }
+  }
+
+  SECTION("Interleaved stereo output", "[expansion][kernels]")
+  {
+    const auto input = rampInput(2 * kNumFrames);
+    const auto kernel =
+      SelectExpansionKernel(makeFormat(float32, 2, true), 2, BestInstructionSet());
+    std::vector<float> samples(2 * kNumFrames);
+    OutputBuffers output;
+    output.buffers[0] = samples.data();
+    output.numBuffers = 1;
+    kernel(kNumFrames, input.data(), output, 1.0f);
+    for (uint32_t i = 0; i < 2 * kNumFrames; ++i)
+    {
+      CHECK(ConvertFloat(samples[i]) == input[i]);
+    }
+  }
+}
+
+} // namespace ableton::link_kit
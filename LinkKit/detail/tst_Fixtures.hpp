@@ -0,0 +1,26 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#pragma once
+
+#include "FormatDescriptor.hpp"
+#include <cstdint>
+
+// Fixtures shared by the tests in this directory
+
+namespace ableton::link_kit
+{
+
+inline FormatDescriptor makeFormat(const SampleLayout& sample,
+                                   const uint32_t numChannels,
+                                   const bool isInterleaved,
+                                   const double sampleRate = 48000.0)
+{
+  FormatDescriptor format;
+  format.sample = sample;
+  format.numChannels = numChannels;
+  format.isInterleaved = isInterleaved;
+  format.sampleRate = sampleRate;
+  return format;
+}
+
+} // namespace ableton::link_kit
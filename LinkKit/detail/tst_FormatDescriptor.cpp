@@ -0,0 +1,126 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#include "FormatDescriptor.hpp"
+#include <ableton/test/CatchWrapper.hpp>
+#include <utility>
+
+namespace ableton::link_kit
+{
+
+namespace
+{
+
+template <size_t Index>
+void checkLayoutMapsToItsType()
+{
+  CHECK(FindSampleType(LayoutOf<SampleTypeAt<Index>>()) == Index);
+}
+
+template <size_t... Indices>
+void checkLayoutsMapToTheirTypes(std::index_sequence<Indices...>)
+{
+  (checkLayoutMapsToItsType<Indices>(), ...);
+}
+
+} // namespace
+
+TEST_CASE("Format Descriptor", "[format]")
+{
+  SECTION("Every sample type reads its own layout", "[format]")
+  {
+    checkLayoutsMapToTheirTypes(std::make_index_sequence<kNumSampleTypes>{});
+  }
+
+  SECTION("Layouts are unique", "[format]")
+  {
+    for (size_t i = 0; i < kSampleTypeTable.size(); ++i)
+    {
+      for (size_t j = i + 1; j < kSampleTypeTable.size(); ++j)
+      {
+        CHECK_FALSE(kSampleTypeTable[i].layout == kSampleTypeTable[j].layout);
+      }
+    }
+  }
+
+  SECTION("Mapping is available at compile time", "[format]")
+  {
+    static_assert(*FindSampleType(LayoutOf<float>()) == 9);
+    static_assert(!FindSampleType(SampleLayout{}));
+  }
+
+  SECTION("High aligned 24-bit samples are read as 32-bit samples", "[format]")
+  {
+    const SampleLayout layout{24, 4, 0, SampleEncoding::SignedInteger,
+                              ByteOrder::LittleEndian, SampleAlignment::High};
+    CHECK(FindSampleType(layout) == FindSampleType(LayoutOf<int32_t>()));
+  }
+
+  SECTION("Unsupported layouts", "[format]")
+  {
+    // 8-bit
+    CHECK_FALSE(FindSampleType({8, 1, 0, SampleEncoding::SignedInteger}));
+    // Unsigned 24-bit
+    CHECK_FALSE(FindSampleType({24, 3, 0, SampleEncoding::UnsignedInteger}));
+    // Big endian 24-bit
+    CHECK_FALSE(
+      FindSampleType({24, 3, 0, SampleEncoding::SignedInteger, ByteOrder::BigEndian}));
+    // Big endian 8.24 fixed point
+    CHECK_FALSE(
+      FindSampleType({32, 4, 24, SampleEncoding::SignedInteger, ByteOrder::BigEndian}));
+    // Big endian unsigned 16-bit
+    CHECK_FALSE(
+      FindSampleType({16, 2, 0, SampleEncoding::UnsignedInteger, ByteOrder::BigEndian}));
+    // Half precision float
+    CHECK_FALSE(FindSampleType({16, 2, 0, SampleEncoding::Float}));
+    // 64-bit integer
+    CHECK_FALSE(FindSampleType({64, 8, 0, SampleEncoding::SignedInteger}));
+    // Big endian double
+    CHECK_FALSE(FindSampleType({64, 8, 0, SampleEncoding::Float, ByteOrder::BigEndian}));
+  }
+}
+
+TEST_CASE("Sample Readers", "[format]")
+{
+  SECTION("Known layouts are read without offset", "[format]")
+  {
+    const auto reader = FindSampleReader(LayoutOf<PackedInt24>());
+    REQUIRE(reader);
+    CHECK(reader->index == FindSampleType(LayoutOf<PackedInt24>()));
+    CHECK(reader->offset == 0);
+  }
+
+  SECTION("Padded samples are read at their significant bytes", "[format]")
+  {
+    const auto int16 = FindSampleType(LayoutOf<int16_t>());
+    const auto bigEndianInt16 = FindSampleType(LayoutOf<BigEndian<int16_t>>());
+    const auto read = [](const ByteOrder byteOrder, const SampleAlignment alignment) {
+      return FindSampleReader(
+        {16, 4, 0, SampleEncoding::SignedInteger, byteOrder, alignment});
+    };
+
+    CHECK(read(ByteOrder::LittleEndian, SampleAlignment::High)->index == int16);
+    CHECK(read(ByteOrder::LittleEndian, SampleAlignment::High)->offset == 2);
+    CHECK(read(ByteOrder::LittleEndian, SampleAlignment::Low)->offset == 0);
+    CHECK(read(ByteOrder::BigEndian, SampleAlignment::High)->index == bigEndianInt16);
+    CHECK(read(ByteOrder::BigEndian, SampleAlignment::High)->offset == 0);
+    CHECK(read(ByteOrder::BigEndian, SampleAlignment::Low)->offset == 2);
+
+    const auto float32 = FindSampleReader({32, 8, 0, SampleEncoding::Float,
+                                           ByteOrder::LittleEndian, SampleAlignment::High});
+    REQUIRE(float32);
+    CHECK(float32->index == FindSampleType(LayoutOf<float>()));
+    CHECK(float32->offset == 4);
+  }
+
+  SECTION("Unreadable padded samples", "[format]")
+  {
+    // 20-bit samples
+    CHECK_FALSE(FindSampleReader({20, 4, 0, SampleEncoding::SignedInteger,
+                                  ByteOrder::LittleEndian, SampleAlignment::High}));
+    // Big endian 24-bit samples
+    CHECK_FALSE(FindSampleReader({24, 4, 0, SampleEncoding::SignedInteger,
+                                  ByteOrder::BigEndian, SampleAlignment::Low}));
+  }
+}
+
+} // namespace ableton::link_kit
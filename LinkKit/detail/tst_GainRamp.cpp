@@ -0,0 +1,212 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#include "ChannelMap.hpp"
+#include "GainRamp.hpp"
+#include <ableton/test/CatchWrapper.hpp>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace ableton::link_kit
+{
+
+namespace
+{
+
+// Run a ramp over a buffer of ones in blocks, returning the gain per frame
+std::vector<float> rampGains(GainRamp& gain, const uint32_t numFrames)
+{
+  std::vector<float> gains(numFrames, 1.0f);
+  gain.update();
+  for (uint32_t begin = 0; begin < numFrames; begin += kBlockSize)
+  {
+    const auto blockSize = std::min(kBlockSize, numFrames - begin);
+    gain.apply(1, blockSize, gains.data() + begin, nullptr);
+  }
+  return gains;
+}
+
+} // namespace
+
+TEST_CASE("Gain Ramp", "[gain]")
+{
+  SECTION("Unity by default", "[gain]")
+  {
+    GainRamp gain;
+    CHECK(gain.isUnity());
+    gain.update();
+    CHECK(gain.isUnity());
+    CHECK(gain.gain() == 1.0f);
+  }
+
+  SECTION("Pending target is not unity", "[gain]")
+  {
+    GainRamp gain;
+    gain.setTarget(0.5f, 0, GainRampShape::Linear);
+    CHECK_FALSE(gain.isUnity());
+  }
+
+  SECTION("Immediate gain change", "[gain]")
+  {
+    GainRamp gain;
+    gain.setTarget(0.25f, 0, GainRampShape::Linear);
+    for (const auto value : rampGains(gain, 100))
+    {
+      CHECK(value == 0.25f);
+    }
+  }
+
+  SECTION("Linear ramp", "[gain]")
+  {
+    constexpr uint32_t kRampFrames = 300;
+    GainRamp gain;
+    gain.setTarget(0.0f, kRampFrames, GainRampShape::Linear);
+    const auto gains = rampGains(gain, 2 * kRampFrames);
+    for (uint32_t frame = 0; frame < kRampFrames; ++frame)
+    {
+      const auto expected = 1.0f - static_cast<float>(frame + 1) / kRampFrames;
+      CHECK(gains[frame] == Approx(expected).margin(1e-6));
+    }
+    for (uint32_t frame = kRampFrames - 1; frame < 2 * kRampFrames; ++frame)
+    {
+      CHECK(gains[frame] == 0.0f);
+    }
+    CHECK(gain.gain() == 0.0f);
+  }
+
+  SECTION("Exponential ramp has a constant ratio", "[gain]")
+  {
+    constexpr uint32_t kRampFrames = 1000;
+    GainRamp gain;
+    gain.setTarget(0.01f, kRampFrames, GainRampShape::Exponential);
+    const auto gains = rampGains(gain, kRampFrames + 10);
+    const auto ratio = std::pow(0.01, 1.0 / kRampFrames);
+    for (uint32_t frame = 1; frame < kRampFrames; ++frame)
+    {
+      CHECK(gains[frame] / gains[frame - 1] == Approx(ratio).epsilon(1e-5));
+    }
+    CHECK(gains[kRampFrames - 1] == 0.01f);
+    CHECK(gains[kRampFrames + 9] == 0.01f);
+  }
+
+  SECTION("Exponential ramp to silence", "[gain]")
+  {
+    GainRamp gain;
+    gain.setTarget(0.0f, 500, GainRampShape::Exponential);
+    const auto gains = rampGains(gain, 500);
+    CHECK(gains[498] == Approx(GainRamp::kMinExponentialGain).epsilon(0.02));
+    CHECK(gains[499] == 0.0f);
+  }
+
+  SECTION("Exponential ramp across zero is linear", "[gain]")
+  {
+    GainRamp gain;
+    gain.setTarget(-1.0f, 100, GainRampShape::Exponential);
+    const auto gains = rampGains(gain, 100);
+    CHECK(gains[49] == Approx(0.0f).margin(1e-6));
+    CHECK(gains[99] == -1.0f);
+  }
+
+  SECTION("Retargeting continues from the current gain", "[gain]")
+  {
+    GainRamp gain;
+    gain.setTarget(0.0f, 4 * kBlockSize, GainRampShape::Linear);
+    const auto first = rampGains(gain, kBlockSize);
+    gain.setTarget(1.0f, 4 * kBlockSize, GainRampShape::Linear);
+    const auto second = rampGains(gain, 8 * kBlockSize);
+    CHECK(std::abs(second[0] - first.back()) < 0.01f);
+    for (size_t frame = 1; frame < second.size(); ++frame)
+    {
+      CHECK(second[frame] >= second[frame - 1]);
+    }
+    CHECK(second.back() == 1.0f);
+    CHECK(gain.isUnity());
+  }
+
+  SECTION("Stereo channels get the same gain", "[gain]")
+  {
+    GainRamp gain;
+    gain.setTarget(0.5f, 40, GainRampShape::Linear);
+    gain.update();
+    std::vector<float> left(kBlockSize, 1.0f);
+    std::vector<float> right(kBlockSize, -1.0f);
+    gain.apply(2, kBlockSize, left.data(), right.data());
+    for (uint32_t frame = 0; frame < kBlockSize; ++frame)
+    {
+      CHECK(left[frame] == -right[frame]);
+    }
+  }
+
+  SECTION("Target is set from another thread", "[gain]")
+  {
+    GainRamp gain;
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+      for (int i = 0; i < 1000; ++i)
+      {
+        gain.setTarget(i % 2 ? 0.5f : 0.25f, 32, GainRampShape::Exponential);
+      }
+      gain.setTarget(0.75f, 0, GainRampShape::Linear);
+      done = true;
+    });
+    std::vector<float> block(kBlockSize, 1.0f);
+    while (!done)
+    {
+      gain.update();
+      gain.apply(1, kBlockSize, block.data(), nullptr);
+      for (const auto value : block)
+      {
+        CHECK((value >= 0.24f && value <= 1.0f));
+      }
+      std::fill(block.begin(), block.end(), 1.0f);
+    }
+    writer.join();
+    gain.update();
+    CHECK(gain.gain() == 0.75f);
+  }
+}
+
+TEST_CASE("Mapped Buffer Copy With Gain", "[gain][channelmap]")
+{
+  constexpr uint32_t kNumFrames = 333;
+  std::vector<int16_t> input(kNumFrames * 2);
+  for (uint32_t sample = 0; sample < input.size(); ++sample)
+  {
+    input[sample] = static_cast<int16_t>(sample * 97 - 30000);
+  }
+  InputChannels<int16_t> channels;
+  channels.data[0] = input.data();
+  channels.data[1] = input.data() + 1;
+  channels.strides.fill(2 * sizeof(int16_t));
+  const auto map = DefaultChannelMap(2);
+
+  SECTION("Constant gain", "[gain][channelmap]")
+  {
+    GainRamp gain;
+    gain.setTarget(0.5f, 0, GainRampShape::Linear);
+    Quantizer quantizer;
+    std::vector<int16_t> output(kNumFrames * 2);
+    CopyBufferMapped(map, kNumFrames, channels, output.data(), quantizer, gain);
+    for (uint32_t sample = 0; sample < output.size(); ++sample)
+    {
+      CHECK(output[sample] == ConvertFloat(0.5f * ToFloat(input[sample])));
+    }
+  }
+
+  SECTION("Unity gain after a ramp is exact", "[gain][channelmap]")
+  {
+    GainRamp gain;
+    gain.setTarget(0.5f, 0, GainRampShape::Linear);
+    gain.update();
+    gain.setTarget(1.0f, 100, GainRampShape::Linear);
+    Quantizer quantizer;
+    std::vector<int16_t> output(kNumFrames * 2);
+    CopyBufferMapped(map, kNumFrames, channels, output.data(), quantizer, gain);
+    CHECK(gain.isUnity());
+    CopyBufferMapped(map, kNumFrames, channels, output.data(), quantizer, gain);
+    CHECK(output == input);
+  }
+}
+
+} // namespace ableton::link_kit
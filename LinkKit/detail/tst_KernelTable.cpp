@@ -0,0 +1,406 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#include "KernelTable.hpp"
+#include "tst_Fixtures.hpp"
+#include <ableton/test/CatchWrapper.hpp>
+#include <cstring>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ableton::link_kit
+{
+
+namespace
+{
+
+constexpr uint32_t kNumFrames = 333;
+
+template <typename T>
+constexpr bool kIsFloat = LayoutOf<T>().encoding == SampleEncoding::Float;
+
+// Samples in the audio range for float types, random bits otherwise
+template <typename T>
+std::vector<T> randomSamples(const size_t size)
+{
+  std::mt19937 rng(7);
+  std::vector<T> samples(size);
+  for (auto& sample : samples)
+  {
+    if constexpr (std::is_same_v<T, BigEndian<float>>)
+    {
+      std::uniform_real_distribution<float> values(-1.1f, 1.1f);
+      sample = {FromBigEndian(BigEndian<float>{values(rng)})};
+    }
+    else if constexpr (kIsFloat<T>)
+    {
+      std::uniform_real_distribution<T> values(-1.1, 1.1);
+      sample = values(rng);
+    }
+    else
+    {
+      uint8_t bytes[sizeof(T)];
+      for (auto& byte : bytes)
+      {
+        byte = static_cast<uint8_t>(rng());
+      }
+      std::memcpy(&sample, bytes, sizeof(T));
+    }
+  }
+  return samples;
+}
+
+// Convert with the kernel picked for the state and compare against the scalar
+// conversion of the first one or two channels
+template <typename T>
+void checkDefaultMap(const InstructionSet instructionSet,
+                     const uint32_t numChannels,
+                     const bool isInterleaved)
+{
+  ConversionState state;
+  state.format = makeFormat(LayoutOf<T>(), numChannels, isInterleaved);
+  const auto kernel = ConfigureConversion(state, instructionSet);
+  REQUIRE(kernel != nullptr);
+
+  const auto samples = randomSamples<T>(numChannels * kNumFrames);
+  InputBuffers input;
+  if (isInterleaved)
+  {
+    input.buffers[0] = {samples.data(), numChannels};
+    input.numBuffers = 1;
+  }
+  else
+  {
+    for (uint32_t channel = 0; channel < numChannels; ++channel)
+    {
+      input.buffers[channel] = {samples.data() + channel * kNumFrames, 1};
+    }
+    input.numBuffers = numChannels;
+  }
+  const auto sampleAt = [&](const uint32_t frame, const uint32_t channel) {
+    return isInterleaved ? samples[frame * numChannels + channel]
+                         : samples[channel * kNumFrames + frame];
+  };
+
+  const auto numOutputChannels = numChannels == 1 ? 1u : 2u;
+  std::vector<int16_t> output(numOutputChannels * kNumFrames);
+  CHECK(kernel(state, kNumFrames, input, output.data()) == kNumFrames);
+  for (uint32_t frame = 0; frame < kNumFrames; ++frame)
+  {
+    for (uint32_t channel = 0; channel < numOutputChannels; ++channel)
+    {
+      CHECK(output[frame * numOutputChannels + channel]
+            == Convert<T>(sampleAt(frame, channel)));
+    }
+  }
+}
+
+template <size_t... Indices>
+void checkAllSampleTypes(const InstructionSet instructionSet,
+                         const uint32_t numChannels,
+                         const bool isInterleaved,
+                         std::index_sequence<Indices...>)
+{
+  (checkDefaultMap<SampleTypeAt<Indices>>(instructionSet, numChannels, isInterleaved),
+   ...);
+}
+
+std::vector<InstructionSet> supportedInstructionSets()
+{
+  std::vector<InstructionSet> instructionSets;
+  for (const auto instructionSet : {InstructionSet::Scalar,
+                                    InstructionSet::Sse2,
+                                    InstructionSet::Avx2,
+                                    InstructionSet::Neon})
+  {
+    if (IsSupported(instructionSet))
+    {
+      instructionSets.push_back(instructionSet);
+    }
+  }
+  return instructionSets;
+}
+
+} // namespace
+
+TEST_CASE("Kernel Table", "[kernels]")
+{
+  const auto& table = kKernelTable<isa::Scalar>;
+  const auto float32 = *FindSampleType(LayoutOf<float>());
+
+  SECTION("Every kernel is instantiated", "[kernels]")
+  {
+    for (const auto& kernels : table)
+    {
+      CHECK(kernels.mapped != nullptr);
+      for (const auto kernel : kernels.planar)
+      {
+        CHECK(kernel != nullptr);
+      }
+      for (const auto kernel : kernels.interleaved)
+      {
+        CHECK(kernel != nullptr);
+      }
+    }
+  }
+
+  SECTION("Default map picks the unrolled kernels", "[kernels]")
+  {
+    ConversionState state;
+    for (uint32_t numChannels = 1; numChannels <= kMaxUnrolledChannels; ++numChannels)
+    {
+      state.format = makeFormat(LayoutOf<float>(), numChannels, true);
+      CHECK(ConfigureConversion(state, InstructionSet::Scalar)
+            == table[float32].interleaved[numChannels - 1]);
+    }
+    state.format = makeFormat(LayoutOf<float>(), kMaxUnrolledChannels + 1, true);
+    CHECK(ConfigureConversion(state, InstructionSet::Scalar) == table[float32].mapped);
+
+    state.format = makeFormat(LayoutOf<float>(), 1, false);
+    CHECK(ConfigureConversion(state, InstructionSet::Scalar) == table[float32].planar[0]);
+    state.format = makeFormat(LayoutOf<float>(), 6, false);
+    CHECK(ConfigureConversion(state, InstructionSet::Scalar) == table[float32].planar[1]);
+  }
+
+  SECTION("Requested maps, rounding and resampling pick the mapped kernel", "[kernels]")
+  {
+    ConversionState state;
+    state.format = makeFormat(LayoutOf<float>(), 2, true);
+
+    const uint32_t swapped[] = {1, 0};
+    state.requestedMap = MakeChannelSelection(swapped, 2);
+    CHECK(ConfigureConversion(state, InstructionSet::Scalar) == table[float32].mapped);
+    state.requestedMap = std::nullopt;
+
+    state.quantizer = Quantizer{QuantizationMode::Round};
+    CHECK(ConfigureConversion(state, InstructionSet::Scalar) == table[float32].mapped);
+    // Rounding doesn't change 16-bit input
+    const auto int16 = *FindSampleType(LayoutOf<int16_t>());
+    state.format = makeFormat(LayoutOf<int16_t>(), 2, true);
+    CHECK(ConfigureConversion(state, InstructionSet::Scalar)
+          == table[int16].interleaved[1]);
+    state.quantizer = Quantizer{};
+
+    state.format.sampleRate = 96000.0;
+    state.targetSampleRate = 48000;
+    CHECK(ConfigureConversion(state, InstructionSet::Scalar) == table[int16].mapped);
+    CHECK(state.resampler.isActive());
+  }
+
+  SECTION("Unsupported formats have no kernel", "[kernels]")
+  {
+    ConversionState state;
+    CHECK(ConfigureConversion(state, InstructionSet::Scalar) == nullptr);
+    state.format = makeFormat({8, 1, 0, SampleEncoding::SignedInteger}, 2, true);
+    CHECK(ConfigureConversion(state, InstructionSet::Scalar) == nullptr);
+    state.format = makeFormat(LayoutOf<float>(), 0, true);
+    CHECK(ConfigureConversion(state, InstructionSet::Scalar) == nullptr);
+    state.format =
+      makeFormat(LayoutOf<float>(), ChannelMap::kMaxInputChannels + 1, true);
+    CHECK(ConfigureConversion(state, InstructionSet::Scalar) == nullptr);
+  }
+}
+
+TEST_CASE("Kernels Convert The Default Map", "[kernels]")
+{
+  for (const auto instructionSet : supportedInstructionSets())
+  {
+    for (const uint32_t numChannels : {1u, 2u, 3u, 6u, 8u, 11u})
+    {
+      for (const bool isInterleaved : {true, false})
+      {
+        checkAllSampleTypes(instructionSet,
+                            numChannels,
+                            isInterleaved,
+                            std::make_index_sequence<kNumSampleTypes>{});
+      }
+    }
+  }
+}
+
+TEST_CASE("Unrolled Kernels Fall Back While The Gain Isn't Unity", "[kernels]")
+{
+  constexpr uint32_t kNumChannels = 4;
+  ConversionState state;
+  state.format = makeFormat(LayoutOf<int16_t>(), kNumChannels, true);
+  const auto kernel = ConfigureConversion(state, InstructionSet::Scalar);
+  REQUIRE(kernel == kKernelTable<isa::Scalar>[0].interleaved[kNumChannels - 1]);
+
+  const auto samples = randomSamples<int16_t>(kNumChannels * kNumFrames);
+  InputBuffers input;
+  input.buffers[0] = {samples.data(), kNumChannels};
+  input.numBuffers = 1;
+
+  state.gain.setTarget(0.5f, 0, GainRampShape::Linear);
+  std::vector<int16_t> output(2 * kNumFrames);
+  kernel(state, kNumFrames, input, output.data());
+  for (uint32_t frame = 0; frame < kNumFrames; ++frame)
+  {
+    for (uint32_t channel = 0; channel < 2; ++channel)
+    {
+      CHECK(output[2 * frame + channel]
+            == ConvertFloat(0.5f * ToFloat(samples[frame * kNumChannels + channel])));
+    }
+  }
+}
+
+TEST_CASE("Padded And Split Buffers", "[kernels]")
+{
+  SECTION("Samples padded to a wider container", "[kernels]")
+  {
+    for (const auto byteOrder : {ByteOrder::LittleEndian, ByteOrder::BigEndian})
+    {
+      for (const auto alignment : {SampleAlignment::High, SampleAlignment::Low})
+      {
+        ConversionState state;
+        state.format = makeFormat(
+          {16, 4, 0, SampleEncoding::SignedInteger, byteOrder, alignment}, 2, true);
+        const auto kernel = ConfigureConversion(state, InstructionSet::Scalar);
+        const auto index =
+          *FindSampleType({16, 2, 0, SampleEncoding::SignedInteger, byteOrder});
+        REQUIRE(kernel == kKernelTable<isa::Scalar>[index].mapped);
+
+        // Significant bytes hold the sample index, the padding is garbage
+        std::vector<uint8_t> bytes(2 * kNumFrames * 4, 0xAB);
+        for (uint32_t sample = 0; sample < 2 * kNumFrames; ++sample)
+        {
+          const auto value = static_cast<uint16_t>(sample * 97 - 20000);
+          const auto offset = sample * 4 + state.sampleOffset;
+          const bool isBigEndian = byteOrder == ByteOrder::BigEndian;
+          bytes[offset + (isBigEndian ? 1 : 0)] = static_cast<uint8_t>(value);
+          bytes[offset + (isBigEndian ? 0 : 1)] = static_cast<uint8_t>(value >> 8);
+        }
+        InputBuffers input;
+        input.buffers[0] = {bytes.data(), 2};
+        input.numBuffers = 1;
+
+        std::vector<int16_t> output(2 * kNumFrames);
+        CHECK(kernel(state, kNumFrames, input, output.data()) == kNumFrames);
+        for (uint32_t sample = 0; sample < 2 * kNumFrames; ++sample)
+        {
+          CHECK(output[sample] == static_cast<int16_t>(sample * 97 - 20000));
+        }
+      }
+    }
+  }
+
+  SECTION("Padding between frames", "[kernels]")
+  {
+    ConversionState state;
+    state.format = makeFormat(LayoutOf<float>(), 2, true);
+    state.format.bytesPerFrame = 12;
+    const auto kernel = ConfigureConversion(state, InstructionSet::Scalar);
+    REQUIRE(kernel == kKernelTable<isa::Scalar>[9].mapped);
+
+    const auto samples = randomSamples<float>(3 * kNumFrames);
+    InputBuffers input;
+    input.buffers[0] = {samples.data(), 2};
+    input.numBuffers = 1;
+    std::vector<int16_t> output(2 * kNumFrames);
+    kernel(state, kNumFrames, input, output.data());
+    for (uint32_t frame = 0; frame < kNumFrames; ++frame)
+    {
+      CHECK(output[2 * frame] == Convert<float>(samples[3 * frame]));
+      CHECK(output[2 * frame + 1] == Convert<float>(samples[3 * frame + 1]));
+    }
+  }
+
+  SECTION("Channels split across buffers", "[kernels]")
+  {
+    // A stereo buffer followed by a mono buffer, sending channels 2 and 0
+    const auto stereo = randomSamples<int32_t>(2 * kNumFrames);
+    const auto mono = randomSamples<int32_t>(kNumFrames);
+    InputBuffers input;
+    input.buffers[0] = {stereo.data(), 2};
+    input.buffers[1] = {mono.data(), 1};
+    input.numBuffers = 2;
+    CHECK(NumChannels(input) == 3);
+
+    for (const bool isInterleaved : {true, false})
+    {
+      ConversionState state;
+      state.format = makeFormat(LayoutOf<int32_t>(), 3, isInterleaved);
+      const uint32_t selection[] = {2, 0};
+      state.requestedMap = MakeChannelSelection(selection, 2);
+      const auto kernel = ConfigureConversion(state, InstructionSet::Scalar);
+
+      std::vector<int16_t> output(2 * kNumFrames);
+      kernel(state, kNumFrames, input, output.data());
+      for (uint32_t frame = 0; frame < kNumFrames; ++frame)
+      {
+        CHECK(output[2 * frame] == Convert<int32_t>(mono[frame]));
+        CHECK(output[2 * frame + 1] == Convert<int32_t>(stereo[2 * frame]));
+      }
+    }
+  }
+
+  SECTION("Unrolled kernels fall back for unexpected buffers", "[kernels]")
+  {
+    const auto samples = randomSamples<int16_t>(2 * kNumFrames);
+    InputBuffers input;
+    input.buffers[0] = {samples.data(), 2};
+    input.numBuffers = 1;
+
+    // Planar stereo delivered as one interleaved buffer
+    ConversionState planar;
+    planar.format = makeFormat(LayoutOf<int16_t>(), 2, false);
+    const auto kernel = ConfigureConversion(planar, InstructionSet::Scalar);
+    REQUIRE(kernel == kKernelTable<isa::Scalar>[0].planar[1]);
+    std::vector<int16_t> output(2 * kNumFrames);
+    kernel(planar, kNumFrames, input, output.data());
+    CHECK(output == samples);
+
+    // Interleaved six channels delivered as a stereo buffer and four more
+    const auto surround = randomSamples<int16_t>(4 * kNumFrames);
+    input.buffers[1] = {surround.data(), 4};
+    input.numBuffers = 2;
+    ConversionState interleaved;
+    interleaved.format = makeFormat(LayoutOf<int16_t>(), 6, true);
+    const auto unrolled = ConfigureConversion(interleaved, InstructionSet::Scalar);
+    REQUIRE(unrolled == kKernelTable<isa::Scalar>[0].interleaved[5]);
+    std::fill(output.begin(), output.end(), 0);
+    unrolled(interleaved, kNumFrames, input, output.data());
+    CHECK(output == samples);
+  }
+}
+
+TEST_CASE("Kernels Meter The Converted Frames", "[kernels]")
+{
+  const auto samples = randomSamples<float>(2 * kNumFrames);
+  InputBuffers input;
+  input.buffers[0] = {samples.data(), 2};
+  input.numBuffers = 1;
+
+  for (const auto instructionSet : supportedInstructionSets())
+  {
+    for (const auto gain : {1.0f, 0.5f})
+    {
+      ConversionState state;
+      state.format = makeFormat(LayoutOf<float>(), 2, true);
+      state.gain.setTarget(gain, 0, GainRampShape::Linear);
+      const auto kernel = ConfigureConversion(state, instructionSet);
+      std::vector<int16_t> output(2 * kNumFrames);
+
+      kernel(state, kNumFrames, input, output.data());
+      CHECK(state.meter.read().numFrames == 0);
+
+      state.meter.setEnabled(true);
+      kernel(state, kNumFrames, input, output.data());
+      const auto levels = state.meter.read();
+
+      LevelMeter expected;
+      expected.process<isa::Scalar>(2, kNumFrames, output.data());
+      const auto expectedLevels = expected.read();
+      CHECK(levels.numFrames == kNumFrames);
+      CHECK(levels.numChannels == 2);
+      CHECK(levels.peak == expectedLevels.peak);
+      CHECK(levels.rms == expectedLevels.rms);
+      CHECK(levels.numClippedSamples == expectedLevels.numClippedSamples);
+      // The samples range up to 1.1, so some clip at unity gain
+      CHECK((levels.numClippedSamples[0] > 0) == (gain == 1.0f));
+    }
+  }
+}
+
+} // namespace ableton::link_kit
@@ -0,0 +1,195 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#include "LevelMeter.hpp"
+#include <ableton/test/CatchWrapper.hpp>
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace ableton::link_kit
+{
+
+namespace
+{
+
+std::vector<int16_t> randomSamples(const size_t size)
+{
+  std::mt19937 rng(11);
+  std::uniform_int_distribution<int32_t> values(-32768, 32767);
+  std::vector<int16_t> samples(size);
+  for (auto& sample : samples)
+  {
+    sample = static_cast<int16_t>(values(rng));
+  }
+  // Some clipped samples on both channels
+  for (size_t i = 0; i < size; i += 37)
+  {
+    samples[i] = i % 3 == 0 ? -32768 : 32767;
+  }
+  return samples;
+}
+
+void checkEqual(const SampleLevels& lhs, const SampleLevels& rhs)
+{
+  CHECK(lhs.max == rhs.max);
+  CHECK(lhs.min == rhs.min);
+  CHECK(lhs.sumOfSquares == rhs.sumOfSquares);
+  CHECK(lhs.numClipped == rhs.numClipped);
+}
+
+} // namespace
+
+TEST_CASE("Level Meter", "[meter]")
+{
+  SECTION("Vector loops match the scalar loop", "[meter]")
+  {
+    const auto samples = randomSamples(1001);
+    for (const auto numSamples : {0u, 1u, 7u, 16u, 31u, 64u, 333u, 1001u})
+    {
+      SampleLevels even;
+      SampleLevels odd;
+      isa::Scalar::meter(numSamples, samples.data(), even, odd);
+
+      for (const auto instructionSet : {InstructionSet::Sse2,
+                                        InstructionSet::Avx2,
+                                        InstructionSet::Neon})
+      {
+        if (!IsSupported(instructionSet))
+        {
+          continue;
+        }
+        WithInstructionSet(instructionSet, [&](auto tag) {
+          SampleLevels vectorEven;
+          SampleLevels vectorOdd;
+          decltype(tag)::meter(numSamples, samples.data(), vectorEven, vectorOdd);
+          checkEqual(vectorEven, even);
+          checkEqual(vectorOdd, odd);
+        });
+      }
+    }
+  }
+
+  SECTION("Full scale samples", "[meter]")
+  {
+    const std::vector<int16_t> samples(128, -32768);
+    SampleLevels even;
+    SampleLevels odd;
+    isa::Native::meter(128, samples.data(), even, odd);
+    CHECK(even.min == -32768);
+    CHECK(even.sumOfSquares == 64 * (uint64_t{1} << 30));
+    CHECK(even.numClipped == 64);
+    CHECK(odd.numClipped == 64);
+  }
+
+  SECTION("Disabled by default", "[meter]")
+  {
+    LevelMeter meter;
+    CHECK_FALSE(meter.isEnabled());
+    meter.setEnabled(true);
+    CHECK(meter.isEnabled());
+  }
+
+  SECTION("Stereo levels", "[meter]")
+  {
+    // Left is a square wave at half scale, right is silent
+    constexpr uint32_t kNumFrames = 500;
+    std::vector<int16_t> samples(2 * kNumFrames, 0);
+    for (uint32_t frame = 0; frame < kNumFrames; ++frame)
+    {
+      samples[2 * frame] = frame % 2 == 0 ? 16384 : -16384;
+    }
+
+    LevelMeter meter;
+    meter.process(2, kNumFrames, samples.data());
+    const auto levels = meter.read();
+    CHECK(levels.numChannels == 2);
+    CHECK(levels.numFrames == kNumFrames);
+    CHECK(levels.peak[0] == 0.5f);
+    CHECK(levels.rms[0] == Approx(0.5f));
+    CHECK(levels.peak[1] == 0.0f);
+    CHECK(levels.rms[1] == 0.0f);
+    CHECK(levels.numClippedSamples[0] == 0);
+  }
+
+  SECTION("Mono levels", "[meter]")
+  {
+    constexpr uint32_t kNumFrames = 4800;
+    std::vector<int16_t> samples(kNumFrames);
+    for (uint32_t frame = 0; frame < kNumFrames; ++frame)
+    {
+      samples[frame] = static_cast<int16_t>(
+        std::lround(32767.0 * std::sin(2.0 * M_PI * 100.0 * frame / 48000.0)));
+    }
+
+    LevelMeter meter;
+    meter.process(1, kNumFrames, samples.data());
+    const auto levels = meter.read();
+    CHECK(levels.numChannels == 1);
+    CHECK(levels.peak[0] == Approx(1.0f).margin(1e-4));
+    CHECK(levels.rms[0] == Approx(1.0 / std::sqrt(2.0)).margin(1e-4));
+    CHECK(levels.numClippedSamples[0] == 10);
+  }
+
+  SECTION("Readings cover the frames since the previous reading", "[meter]")
+  {
+    const std::vector<int16_t> loud(64, 32767);
+    const std::vector<int16_t> quiet(64, 64);
+
+    LevelMeter meter;
+    meter.process(2, 32, loud.data());
+    meter.process(2, 32, quiet.data());
+    auto levels = meter.read();
+    CHECK(levels.numFrames == 64);
+    CHECK(levels.peak[0] == Approx(32767.0f / 32768.0f));
+    CHECK(levels.numClippedSamples[0] == 32);
+    CHECK(levels.numClippedSamples[1] == 32);
+
+    meter.process(2, 32, quiet.data());
+    levels = meter.read();
+    CHECK(levels.numFrames == 32);
+    CHECK(levels.peak[0] == 64.0f / 32768.0f);
+    CHECK(levels.rms[1] == 64.0f / 32768.0f);
+    CHECK(levels.numClippedSamples[0] == 0);
+
+    levels = meter.read();
+    CHECK(levels.numFrames == 0);
+    CHECK(levels.peak[0] == 0.0f);
+    CHECK(levels.rms[0] == 0.0f);
+  }
+
+  SECTION("Concurrent reads don't lose frames or clipped samples", "[meter]")
+  {
+    constexpr uint32_t kNumBuffers = 20000;
+    std::vector<int16_t> samples(256, 100);
+    samples[10] = 32767;
+
+    LevelMeter meter;
+    std::atomic<bool> isDone{false};
+    uint64_t numFrames = 0;
+    uint64_t numClipped = 0;
+    std::thread reader([&] {
+      while (!isDone.load())
+      {
+        const auto levels = meter.read();
+        numFrames += levels.numFrames;
+        numClipped += levels.numClippedSamples[0];
+      }
+    });
+    for (uint32_t i = 0; i < kNumBuffers; ++i)
+    {
+      meter.process(2, 128, samples.data());
+    }
+    isDone = true;
+    reader.join();
+    const auto levels = meter.read();
+    numFrames += levels.numFrames;
+    numClipped += levels.numClippedSamples[0];
+
+    CHECK(numFrames == 128 * kNumBuffers);
+    CHECK(numClipped == kNumBuffers);
+  }
+}
+
+} // namespace ableton::link_kit
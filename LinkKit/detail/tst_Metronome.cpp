@@ -0,0 +1,139 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#include "Metronome.hpp"
+#include <ableton/test/CatchWrapper.hpp>
+#include <vector>
+
+namespace ableton::link_kit
+{
+
+namespace
+{
+
+struct Session
+{
+  double tempo;
+  double sampleRate;
+  double quantum;
+  // Beat at the first rendered frame
+  double beats;
+};
+
+// LinkHut's per-sample metronome: a click starts where the phase of a one beat
+// quantum wraps, the tone follows the phase in the quantum and negative beats
+// are silent
+std::vector<float> renderPerSample(const Session& session, const uint32_t numFrames)
+{
+  const auto timeline =
+    MakeBufferTimeline(session.beats, session.tempo, 0, 1e9, session.sampleRate, session.quantum);
+  const auto clickLength = Metronome(session.sampleRate).clickLength();
+  std::vector<float> output(numFrames);
+  std::optional<uint32_t> lastClick;
+  for (uint32_t frame = 0; frame < numFrames; ++frame)
+  {
+    const auto beats = timeline.beatAtFrame(frame);
+    if (beats < 0.0)
+    {
+      continue;
+    }
+    if (PhaseOf(beats, 1.0) < PhaseOf(timeline.beatAtFrame(frame - 1.0), 1.0))
+    {
+      lastClick = frame;
+    }
+    if (lastClick && frame - *lastClick < clickLength)
+    {
+      const auto frequency = std::floor(PhaseOf(beats, session.quantum)) == 0.0
+                               ? Metronome::kHighTone
+                               : Metronome::kLowTone;
+      output[frame] = Metronome::ClickSample(frequency, session.sampleRate, frame - *lastClick);
+    }
+  }
+  return output;
+}
+
+std::vector<float> renderBuffers(const Session& session,
+                                 const uint32_t numFrames,
+                                 const uint32_t bufferSize)
+{
+  const auto timeline =
+    MakeBufferTimeline(session.beats, session.tempo, 0, 1e9, session.sampleRate, session.quantum);
+  Metronome metronome(session.sampleRate);
+  std::vector<float> output(numFrames);
+  for (uint32_t frame = 0; frame < numFrames; frame += bufferSize)
+  {
+    metronome.mix(
+      timeline.advanced(frame), std::min(bufferSize, numFrames - frame), output.data() + frame);
+  }
+  return output;
+}
+
+uint32_t numMismatches(const std::vector<float>& lhs, const std::vector<float>& rhs)
+{
+  uint32_t count = 0;
+  for (size_t i = 0; i < lhs.size(); ++i)
+  {
+    count += std::abs(lhs[i] - rhs[i]) > 1e-6f;
+  }
+  return count;
+}
+
+} // namespace
+
+TEST_CASE("Metronome", "[metronome]")
+{
+  SECTION("Clicks have the duration of LinkHut's", "[metronome]")
+  {
+    CHECK(Metronome(48000.0).clickLength() == 4800);
+    CHECK(Metronome(44100.0).clickLength() == 4410);
+  }
+
+  SECTION("Wavetables match rendering every sample", "[metronome]")
+  {
+    const std::vector<Session> sessions = {
+      {120.0, 48000.0, 4.0, 0.3 / 24000.0},
+      {121.0, 44100.0, 4.0, 0.0},
+      // Count-in beats and a click cut off by the next beat
+      {999.0, 48000.0, 3.0, -2.1},
+      {20.0, 96000.0, 1.0, 0.5},
+    };
+    for (const auto& session : sessions)
+    {
+      const auto numFrames = static_cast<uint32_t>(10 * session.sampleRate);
+      const auto expected = renderPerSample(session, numFrames);
+      CHECK(numMismatches(renderBuffers(session, numFrames, 256), expected) == 0);
+      CHECK(numMismatches(renderBuffers(session, numFrames, 97), expected) == 0);
+      CHECK(numMismatches(renderBuffers(session, numFrames, 4096), expected) == 0);
+    }
+  }
+
+  SECTION("The first beat of the quantum is high", "[metronome]")
+  {
+    const auto output = renderBuffers({120.0, 48000.0, 2.0, 0.0}, 48000, 512);
+    CHECK(output[1] == Metronome::ClickSample(Metronome::kHighTone, 48000.0, 1));
+    CHECK(output[24001] == Metronome::ClickSample(Metronome::kLowTone, 48000.0, 1));
+  }
+
+  SECTION("Mixing adds to the output", "[metronome]")
+  {
+    const auto timeline = MakeBufferTimeline(0.0, 120.0, 0, 1e9, 48000.0, 4.0);
+    Metronome metronome(48000.0);
+    std::vector<float> output(8000, 0.5f);
+    metronome.mix(timeline, 8000, output.data());
+    CHECK(output[0] == 0.5f + Metronome::ClickSample(Metronome::kHighTone, 48000.0, 0));
+    CHECK(output[7999] == 0.5f);
+  }
+
+  SECTION("Reset stops the click", "[metronome]")
+  {
+    const auto timeline = MakeBufferTimeline(0.0, 120.0, 0, 1e9, 48000.0, 4.0);
+    Metronome metronome(48000.0);
+    std::vector<float> output(256);
+    metronome.mix(timeline, 256, output.data());
+    metronome.reset();
+    std::fill(output.begin(), output.end(), 0.0f);
+    metronome.mix(timeline.advanced(256), 256, output.data());
+    CHECK(output == std::vector<float>(256, 0.0f));
+  }
+}
+
+} // namespace ableton::link_kit
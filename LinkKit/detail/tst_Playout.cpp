@@ -0,0 +1,286 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#include "Playout.hpp"
+#include "tst_Fixtures.hpp"
+#include <ableton/test/CatchWrapper.hpp>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace ableton::link_kit
+{
+
+namespace
+{
+
+// Beat of the first frame of a received buffer, if known
+struct TestInfo
+{
+  std::optional<double> beginBeats;
+};
+
+constexpr double kTempo = 120.0;
+constexpr double kFramesPerBeat = 24000.0;
+
+std::vector<int16_t> rampInput(const uint32_t numSamples, const int16_t first)
+{
+  std::vector<int16_t> input(numSamples);
+  for (uint32_t i = 0; i < numSamples; ++i)
+  {
+    input[i] = static_cast<int16_t>(first + i);
+  }
+  return input;
+}
+
+// Render mono float output, with -1 marking frames that weren't written
+struct MonoRender
+{
+  std::vector<float> samples;
+  uint32_t numPlayed;
+};
+
+MonoRender render(AudioPlayout<TestInfo>& playout,
+                  const uint32_t numFrames,
+                  const double beatsAtRenderBegin)
+{
+  MonoRender result{std::vector<float>(numFrames, -1.0f), 0};
+  OutputBuffers output;
+  output.buffers[0] = result.samples.data();
+  output.numBuffers = 1;
+  result.numPlayed = playout.render(numFrames,
+                                    output,
+                                    beatsAtRenderBegin,
+                                    kTempo,
+                                    [](const TestInfo& info) { return info.beginBeats; });
+  return result;
+}
+
+float expanded(const int16_t sample)
+{
+  return ToFloat(sample);
+}
+
+} // namespace
+
+TEST_CASE("Playout Ring", "[playout]")
+{
+  SECTION("Buffers come out in order", "[playout]")
+  {
+    PlayoutRing<int> ring(4, 8);
+    CHECK(ring.front() == nullptr);
+    const auto first = rampInput(8, 100);
+    const auto second = rampInput(3, 200);
+    CHECK(ring.push(1, first.data(), 4, 2));
+    CHECK(ring.push(2, second.data(), 3, 1));
+
+    auto* slot = ring.front();
+    REQUIRE(slot != nullptr);
+    CHECK(slot->info == 1);
+    CHECK(slot->numFrames == 4);
+    CHECK(slot->numChannels == 2);
+    CHECK(std::vector<int16_t>(slot->samples, slot->samples + 8) == first);
+    ring.pop();
+
+    slot = ring.front();
+    REQUIRE(slot != nullptr);
+    CHECK(slot->info == 2);
+    CHECK(std::vector<int16_t>(slot->samples, slot->samples + 3) == second);
+    ring.pop();
+    CHECK(ring.front() == nullptr);
+  }
+
+  SECTION("Buffers are dropped if full or too large", "[playout]")
+  {
+    PlayoutRing<int> ring(2, 8);
+    const auto samples = rampInput(16, 0);
+    CHECK_FALSE(ring.push(0, samples.data(), 8, 2));
+    CHECK(ring.push(1, samples.data(), 8, 1));
+    CHECK(ring.push(2, samples.data(), 4, 2));
+    CHECK_FALSE(ring.push(3, samples.data(), 1, 1));
+    CHECK(ring.numDropped() == 2);
+
+    ring.pop();
+    CHECK(ring.push(4, samples.data(), 1, 1));
+    CHECK(ring.front()->info == 2);
+  }
+
+  SECTION("Concurrent pushes and pops", "[playout]")
+  {
+    constexpr uint32_t kNumBuffers = 10000;
+    PlayoutRing<uint32_t> ring(8, 64);
+    std::thread producer([&] {
+      std::vector<int16_t> samples(64);
+      for (uint32_t i = 0; i < kNumBuffers;)
+      {
+        std::fill(samples.begin(), samples.end(), static_cast<int16_t>(i));
+        if (ring.push(i, samples.data(), 1 + i % 64, 1))
+        {
+          ++i;
+        }
+        else
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    uint32_t numReceived = 0;
+    uint32_t numMismatches = 0;
+    while (numReceived < kNumBuffers)
+    {
+      if (const auto* slot = ring.front())
+      {
+        const auto expected = static_cast<int16_t>(numReceived);
+        numMismatches += slot->info != numReceived || slot->numFrames != 1 + numReceived % 64
+                         || slot->samples[0] != expected
+                         || slot->samples[slot->numFrames - 1] != expected;
+        ring.pop();
+        ++numReceived;
+      }
+      else
+      {
+        std::this_thread::yield();
+      }
+    }
+    producer.join();
+    CHECK(numMismatches == 0);
+  }
+}
+
+TEST_CASE("Unconfigured Audio Playout", "[playout]")
+{
+  AudioPlayout<TestInfo> playout(8, 1024);
+  CHECK_FALSE(playout.hasFormat());
+  const auto samples = rampInput(100, 1);
+  playout.push({}, samples.data(), 100, 1);
+
+  // The output is left to the caller, who knows its size
+  auto result = render(playout, 64, 0.0);
+  CHECK(result.numPlayed == 0);
+  CHECK(result.samples == std::vector<float>(64, -1.0f));
+
+  // An unsupported format doesn't count as one
+  auto format = makeFormat(LayoutOf<float>(), 1, true);
+  format.sample.bytesPerSample = 3;
+  CHECK_FALSE(playout.setFormat(format, InstructionSet::Scalar));
+  CHECK_FALSE(playout.hasFormat());
+
+  REQUIRE(playout.setFormat(makeFormat(LayoutOf<float>(), 1, true), InstructionSet::Scalar));
+  CHECK(playout.hasFormat());
+  playout.setLatency(0);
+  result = render(playout, 64, 0.0);
+  CHECK(result.numPlayed == 64);
+  CHECK(result.samples[0] == expanded(1));
+}
+
+TEST_CASE("Audio Playout", "[playout]")
+{
+  AudioPlayout<TestInfo> playout(8, 1024);
+  REQUIRE(playout.setFormat(makeFormat(LayoutOf<float>(), 1, true), InstructionSet::Scalar));
+  playout.setLatency(0);
+
+  SECTION("Untimed buffers play in order", "[playout]")
+  {
+    const auto first = rampInput(100, 0);
+    const auto second = rampInput(100, 100);
+    playout.push({}, first.data(), 100, 1);
+    playout.push({}, second.data(), 100, 1);
+
+    auto result = render(playout, 150, 0.0);
+    CHECK(result.numPlayed == 150);
+    for (uint32_t i = 0; i < 150; ++i)
+    {
+      CHECK(result.samples[i] == expanded(static_cast<int16_t>(i)));
+    }
+
+    result = render(playout, 100, 0.0);
+    CHECK(result.numPlayed == 50);
+    CHECK(result.samples[49] == expanded(199));
+    CHECK(result.samples[50] == 0.0f);
+    CHECK(result.samples[99] == 0.0f);
+  }
+
+  SECTION("Empty ring renders silence", "[playout]")
+  {
+    const auto result = render(playout, 64, 0.0);
+    CHECK(result.numPlayed == 0);
+    CHECK(result.samples == std::vector<float>(64, 0.0f));
+  }
+
+  SECTION("Early buffers are preceded by silence", "[playout]")
+  {
+    const auto samples = rampInput(100, 1);
+    playout.push({1.0 + 300.0 / kFramesPerBeat}, samples.data(), 100, 1);
+    const auto result = render(playout, 512, 1.0);
+    CHECK(result.numPlayed == 100);
+    CHECK(result.samples[299] == 0.0f);
+    CHECK(result.samples[300] == expanded(1));
+    CHECK(result.samples[399] == expanded(100));
+    CHECK(result.samples[400] == 0.0f);
+  }
+
+  SECTION("Latency delays buffers", "[playout]")
+  {
+    playout.setLatency(200);
+    const auto samples = rampInput(100, 1);
+    playout.push({1.0 + 100.0 / kFramesPerBeat}, samples.data(), 100, 1);
+    const auto result = render(playout, 512, 1.0);
+    CHECK(result.samples[299] == 0.0f);
+    CHECK(result.samples[300] == expanded(1));
+  }
+
+  SECTION("Late frames are skipped", "[playout]")
+  {
+    const auto samples = rampInput(500, 0);
+    playout.push({1.0 - 200.0 / kFramesPerBeat}, samples.data(), 500, 1);
+    const auto result = render(playout, 512, 1.0);
+    CHECK(result.numPlayed == 300);
+    CHECK(result.samples[0] == expanded(200));
+    CHECK(result.samples[299] == expanded(499));
+  }
+
+  SECTION("Small timing differences play through", "[playout]")
+  {
+    // Consecutive buffers a few frames off their schedule stay contiguous
+    const auto first = rampInput(100, 0);
+    const auto second = rampInput(100, 100);
+    playout.push({1.0 + 10.0 / kFramesPerBeat}, first.data(), 100, 1);
+    playout.push({1.0 + 95.0 / kFramesPerBeat}, second.data(), 100, 1);
+    const auto result = render(playout, 200, 1.0);
+    CHECK(result.numPlayed == 200);
+    for (uint32_t i = 0; i < 200; ++i)
+    {
+      CHECK(result.samples[i] == expanded(static_cast<int16_t>(i)));
+    }
+  }
+
+  SECTION("Buffers without a kernel are dropped", "[playout]")
+  {
+    REQUIRE(playout.setFormat(makeFormat(LayoutOf<float>(), 2, false), InstructionSet::Scalar));
+
+    const auto samples = rampInput(12, 0);
+    playout.push({}, samples.data(), 4, 3);
+    playout.push({}, samples.data(), 4, 2);
+    std::vector<float> left(4);
+    std::vector<float> right(4);
+    OutputBuffers output;
+    output.buffers = {left.data(), right.data()};
+    output.numBuffers = 2;
+    CHECK(playout.render(4, output, 0.0, kTempo, [](const TestInfo&) {
+      return std::optional<double>{};
+    }) == 4);
+    CHECK(left[1] == expanded(2));
+    CHECK(right[1] == expanded(3));
+  }
+
+  SECTION("Gain is applied while rendering", "[playout]")
+  {
+    playout.setGain(0.5f);
+    const auto samples = rampInput(4, 1000);
+    playout.push({}, samples.data(), 4, 1);
+    const auto result = render(playout, 4, 0.0);
+    CHECK(result.samples[3] == 0.5f * expanded(1003));
+  }
+}
+
+} // namespace ableton::link_kit
@@ -0,0 +1,215 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#include "ChannelMap.hpp"
+#include "Quantizer.hpp"
+#include <ableton/test/CatchWrapper.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+namespace ableton::link_kit
+{
+
+namespace
+{
+
+constexpr uint32_t kNumFrames = 4099;
+
+template <typename Fn>
+void forEachSupportedInstructionSet(Fn fn)
+{
+  for (const auto instructionSet : {InstructionSet::Scalar,
+                                    InstructionSet::Sse2,
+                                    InstructionSet::Avx2,
+                                    InstructionSet::Neon})
+  {
+    if (IsSupported(instructionSet))
+    {
+      WithInstructionSet(instructionSet, fn);
+    }
+  }
+}
+
+template <typename Isa>
+std::vector<int16_t> quantizeMono(const QuantizationMode mode, const std::vector<float>& input)
+{
+  Quantizer quantizer{mode};
+  InputChannels<float> channels;
+  channels.data[0] = input.data();
+  const uint32_t inputs[] = {0};
+  std::vector<int16_t> output(input.size());
+  CopyBufferMapped<float, Isa>(*MakeChannelSelection(inputs, 1),
+                               static_cast<uint32_t>(input.size()),
+                               channels,
+                               output.data(),
+                               quantizer);
+  return output;
+}
+
+std::vector<float> makeRamp()
+{
+  std::vector<float> input(kNumFrames);
+  for (uint32_t frame = 0; frame < kNumFrames; ++frame)
+  {
+    input[frame] = -1.0f + 2.0f * static_cast<float>(frame) / kNumFrames;
+  }
+  return input;
+}
+
+double mean(const std::vector<int16_t>& samples)
+{
+  double sum = 0.0;
+  for (const auto sample : samples)
+  {
+    sum += sample;
+  }
+  return sum / static_cast<double>(samples.size());
+}
+
+} // namespace
+
+TEST_CASE("Quantizer", "[quantizer]")
+{
+  SECTION("Truncate matches plain conversion", "[quantizer]")
+  {
+    const auto input = makeRamp();
+    forEachSupportedInstructionSet([&](auto tag) {
+      const auto output = quantizeMono<decltype(tag)>(QuantizationMode::Truncate, input);
+      for (uint32_t frame = 0; frame < kNumFrames; ++frame)
+      {
+        CHECK(output[frame] == ConvertFloat(input[frame]));
+      }
+    });
+  }
+
+  SECTION("Round matches scalar rounding", "[quantizer]")
+  {
+    const auto input = makeRamp();
+    forEachSupportedInstructionSet([&](auto tag) {
+      const auto output = quantizeMono<decltype(tag)>(QuantizationMode::Round, input);
+      for (uint32_t frame = 0; frame < kNumFrames; ++frame)
+      {
+        CHECK(output[frame] == RoundFloat(input[frame]));
+      }
+    });
+  }
+
+  SECTION("Int16 routing is unaffected by rounding", "[quantizer]")
+  {
+    std::vector<int16_t> input(kNumFrames);
+    for (uint32_t frame = 0; frame < kNumFrames; ++frame)
+    {
+      input[frame] = static_cast<int16_t>(frame * 16 - 32768);
+    }
+    InputChannels<int16_t> channels;
+    channels.data[0] = input.data();
+    const uint32_t inputs[] = {0};
+    Quantizer quantizer{QuantizationMode::Dither};
+    std::vector<int16_t> output(kNumFrames);
+    CopyBufferMapped(
+      *MakeChannelSelection(inputs, 1), kNumFrames, channels, output.data(), quantizer);
+    CHECK(output == input);
+  }
+
+  const auto ditherModes = {QuantizationMode::Dither, QuantizationMode::ShapedDither};
+
+  SECTION("Dither preserves sub-LSB levels on average", "[quantizer][dither]")
+  {
+    // A constant of 0.3 LSB truncates and rounds to zero
+    const std::vector<float> input(kNumFrames * 16, 0.3f / 32768.0f);
+    for (const auto mode : ditherModes)
+    {
+      const auto output = quantizeMono<isa::Scalar>(mode, input);
+      CHECK(std::abs(mean(output) - 0.3) < 0.02);
+    }
+  }
+
+  SECTION("Dither stays within one LSB", "[quantizer][dither]")
+  {
+    const auto input = makeRamp();
+    for (const auto mode : ditherModes)
+    {
+      const auto output = quantizeMono<isa::Scalar>(mode, input);
+      for (uint32_t frame = 0; frame < kNumFrames; ++frame)
+      {
+        CHECK(std::abs(output[frame] - RoundFloat(input[frame])) <= 1);
+      }
+    }
+  }
+
+  SECTION("Dither is identical on every instruction set", "[quantizer][dither]")
+  {
+    const auto input = makeRamp();
+    for (const auto mode : ditherModes)
+    {
+      const auto expected = quantizeMono<isa::Scalar>(mode, input);
+      forEachSupportedInstructionSet([&](auto tag) {
+        CHECK(quantizeMono<decltype(tag)>(mode, input) == expected);
+      });
+    }
+  }
+
+  SECTION("Dither saturates at full scale", "[quantizer][dither]")
+  {
+    const std::vector<float> input = {1.0f, 2.0f, -1.0f, -2.0f};
+    for (const auto mode : ditherModes)
+    {
+      const auto output = quantizeMono<isa::Scalar>(mode, input);
+      CHECK(output[0] >= 32766);
+      CHECK(output[1] == std::numeric_limits<int16_t>::max());
+      CHECK(output[2] <= -32767);
+      CHECK(output[3] == std::numeric_limits<int16_t>::min());
+    }
+  }
+
+  SECTION("Shaped dither noise is high-pass", "[quantizer][dither]")
+  {
+    // Quantize a constant halfway between two values, so the output only
+    // depends on the dither noise
+    const std::vector<float> input(kNumFrames * 16, 0.5f / 32768.0f);
+    for (const auto mode : ditherModes)
+    {
+      const auto output = quantizeMono<isa::Scalar>(mode, input);
+      const auto average = mean(output);
+      double variance = 0.0;
+      double covariance = 0.0;
+      for (size_t i = 1; i < output.size(); ++i)
+      {
+        variance += (output[i] - average) * (output[i] - average);
+        covariance += (output[i] - average) * (output[i - 1] - average);
+      }
+      const auto correlation = covariance / variance;
+      if (mode == QuantizationMode::Dither)
+      {
+        CHECK(std::abs(correlation) < 0.05);
+      }
+      else
+      {
+        CHECK(correlation < -0.3);
+      }
+    }
+  }
+
+  SECTION("Dither state carries across buffers", "[quantizer][dither]")
+  {
+    const auto input = makeRamp();
+    const auto expected = quantizeMono<isa::Scalar>(QuantizationMode::ShapedDither, input);
+
+    Quantizer quantizer{QuantizationMode::ShapedDither};
+    InputChannels<float> channels;
+    const uint32_t inputs[] = {0};
+    const auto map = *MakeChannelSelection(inputs, 1);
+    std::vector<int16_t> output(kNumFrames);
+    // Split at block boundaries so the generators advance identically
+    const uint32_t split = 5 * kBlockSize;
+    channels.data[0] = input.data();
+    CopyBufferMapped<float, isa::Scalar>(map, split, channels, output.data(), quantizer);
+    channels.data[0] = input.data() + split;
+    CopyBufferMapped<float, isa::Scalar>(
+      map, kNumFrames - split, channels, output.data() + split, quantizer);
+    CHECK(output == expected);
+  }
+}
+
+} // namespace ableton::link_kit
@@ -0,0 +1,220 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#include "ChannelMap.hpp"
+#include "Resampler.hpp"
+#include <ableton/test/CatchWrapper.hpp>
+#include <cmath>
+#include <vector>
+
+namespace ableton::link_kit
+{
+
+namespace
+{
+
+constexpr double kPi = 3.14159265358979323846;
+
+std::vector<float> sine(const double frequency, const double sampleRate, const size_t size)
+{
+  std::vector<float> samples(size);
+  for (size_t i = 0; i < size; ++i)
+  {
+    samples[i] = static_cast<float>(std::sin(2.0 * kPi * frequency * i / sampleRate));
+  }
+  return samples;
+}
+
+// Resample a mono signal in blocks of the given size
+std::vector<float> resample(Resampler& resampler,
+                            const std::vector<float>& input,
+                            const uint32_t blockSize)
+{
+  std::vector<float> output;
+  std::array<float, kBlockSize> block;
+  for (size_t begin = 0; begin < input.size(); begin += blockSize)
+  {
+    const auto size =
+      static_cast<uint32_t>(std::min<size_t>(blockSize, input.size() - begin));
+    const auto numOutput =
+      resampler.process(1, size, input.data() + begin, nullptr, block.data(), nullptr);
+    CHECK(numOutput <= resampler.maxNumOutputFrames(size));
+    output.insert(output.end(), block.begin(), block.begin() + numOutput);
+  }
+  return output;
+}
+
+double rms(const std::vector<float>& samples, const size_t begin)
+{
+  double sum = 0.0;
+  for (size_t i = begin; i < samples.size(); ++i)
+  {
+    sum += samples[i] * samples[i];
+  }
+  return std::sqrt(sum / static_cast<double>(samples.size() - begin));
+}
+
+} // namespace
+
+TEST_CASE("Resampler Configuration", "[resampler]")
+{
+  Resampler resampler;
+  CHECK_FALSE(resampler.isActive());
+  CHECK(resampler.nextOutputOffset() == 0.0);
+
+  CHECK(resampler.configure(48000, 48000));
+  CHECK_FALSE(resampler.isActive());
+  CHECK(resampler.outputRate() == 48000);
+  CHECK(resampler.skip(100) == 100);
+
+  CHECK(resampler.configure(96000, 48000));
+  CHECK(resampler.isActive());
+  CHECK(resampler.inputRate() == 96000);
+  CHECK(resampler.outputRate() == 48000);
+  CHECK(resampler.nextOutputOffset() == -16.0);
+
+  // Upsampling
+  CHECK_FALSE(resampler.configure(44100, 48000));
+  CHECK_FALSE(resampler.isActive());
+  CHECK(resampler.outputRate() == 44100);
+
+  // 47999 phases
+  CHECK_FALSE(resampler.configure(48000, 47999));
+  CHECK_FALSE(resampler.isActive());
+
+  CHECK_FALSE(resampler.configure(0, 48000));
+  CHECK_FALSE(resampler.configure(48000, 0));
+}
+
+TEST_CASE("Resampler Processing", "[resampler]")
+{
+  for (const auto& rates : {std::pair<uint32_t, uint32_t>{96000, 48000},
+                            {48000, 44100},
+                            {88200, 48000},
+                            {192000, 32000}})
+  {
+    const auto inputRate = rates.first;
+    const auto outputRate = rates.second;
+    Resampler resampler;
+    REQUIRE(resampler.configure(inputRate, outputRate));
+
+    SECTION("Output frame count follows the ratio", "[resampler]")
+    {
+      const auto output = resample(resampler, std::vector<float>(inputRate), kBlockSize);
+      CHECK(output.size() == outputRate);
+    }
+
+    SECTION("Unity gain at DC", "[resampler]")
+    {
+      const auto output =
+        resample(resampler, std::vector<float>(inputRate / 10, 0.5f), kBlockSize);
+      for (size_t i = Resampler::kNumTaps; i < output.size(); ++i)
+      {
+        CHECK(output[i] == Approx(0.5f).margin(1e-5));
+      }
+    }
+
+    SECTION("Block size doesn't change the output", "[resampler]")
+    {
+      const auto input = sine(997.0, inputRate, 4099);
+      const auto expected = resample(resampler, input, kBlockSize);
+      for (const uint32_t blockSize : {1u, 7u, 31u, 63u})
+      {
+        Resampler other;
+        other.configure(inputRate, outputRate);
+        CHECK(resample(other, input, blockSize) == expected);
+      }
+    }
+
+    SECTION("Output frames are located at the reported offsets", "[resampler]")
+    {
+      // A tone well inside the passband must come out at the times the
+      // resampler reports, this is what keeps committed beats exact
+      const double frequency = 1000.0;
+      const auto input = sine(frequency, inputRate, inputRate / 10);
+      std::array<float, kBlockSize> block;
+      double maxError = 0.0;
+      for (size_t begin = 0; begin < input.size(); begin += kBlockSize)
+      {
+        const auto size =
+          static_cast<uint32_t>(std::min<size_t>(kBlockSize, input.size() - begin));
+        const auto offset = resampler.nextOutputOffset();
+        const auto numOutput =
+          resampler.process(1, size, input.data() + begin, nullptr, block.data(), nullptr);
+        if (begin < Resampler::kNumTaps)
+        {
+          continue;
+        }
+        for (uint32_t i = 0; i < numOutput; ++i)
+        {
+          const auto time =
+            static_cast<double>(begin) + offset + static_cast<double>(i) * inputRate / outputRate;
+          const auto expected = std::sin(2.0 * kPi * frequency * time / inputRate);
+          maxError = std::max(maxError, std::abs(block[i] - expected));
+        }
+      }
+      CHECK(maxError < 2e-3);
+    }
+
+    SECTION("Skipping blocks matches resampling silence", "[resampler]")
+    {
+      const auto input = sine(997.0, inputRate, kBlockSize);
+      const std::vector<float> silence(kBlockSize, 0.0f);
+      Resampler other;
+      other.configure(inputRate, outputRate);
+      std::array<float, kBlockSize> block;
+      for (const uint32_t blockSize : {kBlockSize, 1u, 7u, 63u, kBlockSize})
+      {
+        resampler.process(1, kBlockSize, input.data(), nullptr, block.data(), nullptr);
+        other.process(1, kBlockSize, input.data(), nullptr, block.data(), nullptr);
+        const auto numOutput =
+          resampler.process(1, blockSize, silence.data(), nullptr, block.data(), nullptr);
+        CHECK(other.skip(blockSize) == numOutput);
+        CHECK(other.nextOutputOffset() == resampler.nextOutputOffset());
+      }
+
+      // Once the filter has seen a full block of silence, the history matches
+      const auto expected = resample(resampler, input, kBlockSize);
+      CHECK(resample(other, input, kBlockSize) == expected);
+    }
+
+    SECTION("Content above the output Nyquist frequency is removed", "[resampler]")
+    {
+      const auto input = sine(0.75 * inputRate / 2.0 + 0.25 * outputRate, inputRate, 16384);
+      const auto output = resample(resampler, input, kBlockSize);
+      CHECK(rms(output, Resampler::kNumTaps) < 0.01);
+    }
+  }
+}
+
+TEST_CASE("Mapped Buffer Copy With Resampling", "[resampler][channelmap]")
+{
+  constexpr uint32_t kNumFrames = 1000;
+  std::vector<float> input(2 * kNumFrames);
+  for (uint32_t frame = 0; frame < kNumFrames; ++frame)
+  {
+    input[2 * frame] = 0.5f;
+    input[2 * frame + 1] = -0.25f;
+  }
+  InputChannels<float> channels;
+  channels.data[0] = input.data();
+  channels.data[1] = input.data() + 1;
+  channels.strides.fill(2 * sizeof(float));
+
+  Resampler resampler;
+  resampler.configure(96000, 48000);
+  Quantizer quantizer;
+  GainRamp gain;
+  std::vector<int16_t> output(2 * kNumFrames, 1);
+  const auto numOutput = CopyBufferMapped(
+    DefaultChannelMap(2), kNumFrames, channels, output.data(), quantizer, gain, resampler);
+  CHECK(numOutput == kNumFrames / 2);
+  for (uint32_t frame = Resampler::kNumTaps; frame < numOutput; ++frame)
+  {
+    CHECK(std::abs(output[2 * frame] - 16384) <= 1);
+    CHECK(std::abs(output[2 * frame + 1] + 8192) <= 1);
+  }
+  // Nothing is written past the resampled frames
+  CHECK(output[2 * numOutput] == 1);
+}
+
+} // namespace ableton::link_kit
@@ -0,0 +1,346 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#include "KernelTable.hpp"
+#include "tst_Fixtures.hpp"
+#include <ableton/test/CatchWrapper.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ableton::link_kit
+{
+
+namespace
+{
+
+constexpr uint32_t kNumFrames = 333;
+
+// Quiet samples for float types, random bits otherwise
+template <typename T>
+std::vector<T> randomSamples(const size_t size)
+{
+  std::mt19937 rng(13);
+  std::uniform_real_distribution<float> values(-0.01f, 0.01f);
+  std::vector<T> samples(size);
+  for (auto& sample : samples)
+  {
+    if constexpr (std::is_same_v<T, BigEndian<float>>)
+    {
+      sample = {FromBigEndian(BigEndian<float>{values(rng)})};
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+      sample = values(rng);
+    }
+    else
+    {
+      uint8_t bytes[sizeof(T)];
+      for (auto& byte : bytes)
+      {
+        byte = static_cast<uint8_t>(rng());
+      }
+      std::memcpy(&sample, bytes, sizeof(T));
+    }
+  }
+  return samples;
+}
+
+// Every prefix up to a few vectors is checked right at and just below its
+// largest magnitude, so the vector loops must agree on the boundary, the tail
+// and the position of the first loud sample
+template <typename T>
+void checkIsSilentMatchesScalar()
+{
+  const auto samples = randomSamples<T>(70);
+  for (uint32_t length = 1; length <= samples.size(); ++length)
+  {
+    int32_t magnitude = 0;
+    for (uint32_t i = 0; i < length; ++i)
+    {
+      const int32_t sample = Convert<T>(samples[i]);
+      magnitude = std::max(magnitude, std::abs(sample));
+    }
+    const auto threshold = static_cast<int16_t>(std::min(magnitude, 32767));
+    const auto below = static_cast<int16_t>(std::max(threshold - 1, 0));
+    const auto isSilent = isa::Scalar::isSilent(length, samples.data(), threshold);
+    const auto isSilentBelow = isa::Scalar::isSilent(length, samples.data(), below);
+    CHECK(isSilent == (magnitude <= 32767));
+    CHECK(isSilentBelow == (magnitude == 0));
+
+    for (const auto instructionSet :
+         {InstructionSet::Sse2, InstructionSet::Avx2, InstructionSet::Neon})
+    {
+      if (IsSupported(instructionSet))
+      {
+        WithInstructionSet(instructionSet, [&](auto tag) {
+          using Isa = decltype(tag);
+          CHECK(Isa::isSilent(length, samples.data(), threshold) == isSilent);
+          CHECK(Isa::isSilent(length, samples.data(), below) == isSilentBelow);
+        });
+      }
+    }
+  }
+}
+
+template <size_t... Indices>
+void checkAllSampleTypes(std::index_sequence<Indices...>)
+{
+  (checkIsSilentMatchesScalar<SampleTypeAt<Indices>>(), ...);
+}
+
+} // namespace
+
+TEST_CASE("Silence Gate", "[gate]")
+{
+  SECTION("Off by default", "[gate]")
+  {
+    SilenceGate gate;
+    CHECK(gate.mode() == SilenceGateMode::Off);
+    CHECK(gate.threshold() == 0);
+  }
+
+  SECTION("Parameters", "[gate]")
+  {
+    SilenceGate gate;
+    gate.setParameters(0.001f, 4800, SilenceGateMode::SendSilence);
+    CHECK(gate.mode() == SilenceGateMode::SendSilence);
+    CHECK(gate.threshold() == 32);
+
+    gate.setParameters(2.0f, 0, SilenceGateMode::Suppress);
+    CHECK(gate.mode() == SilenceGateMode::Suppress);
+    CHECK(gate.threshold() == 32767);
+
+    gate.setParameters(-1.0f, 0, SilenceGateMode::Suppress);
+    CHECK(gate.threshold() == 0);
+  }
+
+  SECTION("Buffers are gated after the hold time", "[gate]")
+  {
+    SilenceGate gate;
+    gate.setParameters(0.0f, 256, SilenceGateMode::Suppress);
+    CHECK_FALSE(gate.process(true, 128));
+    CHECK_FALSE(gate.process(true, 128));
+    CHECK(gate.process(true, 128));
+    CHECK(gate.process(true, 128));
+    // Sound reopens the gate and restarts the hold time
+    CHECK_FALSE(gate.process(false, 128));
+    CHECK_FALSE(gate.process(true, 128));
+    CHECK_FALSE(gate.process(true, 128));
+    CHECK(gate.process(true, 128));
+  }
+
+  SECTION("Without hold time the first silent buffer is gated", "[gate]")
+  {
+    SilenceGate gate;
+    gate.setParameters(0.0f, 0, SilenceGateMode::SendSilence);
+    CHECK(gate.process(true, 64));
+    CHECK_FALSE(gate.process(false, 64));
+  }
+}
+
+TEST_CASE("Silence Checks", "[gate]")
+{
+  SECTION("Vector loops match the scalar loop", "[gate]")
+  {
+    checkAllSampleTypes(std::make_index_sequence<kNumSampleTypes>{});
+  }
+
+  SECTION("Silence of unsigned and float types", "[gate]")
+  {
+    const std::vector<uint16_t> unsigned16(100, 0x8000);
+    const std::vector<uint32_t> unsigned32(100, 0x80000000);
+    const std::vector<float> negativeZero(100, -0.0f);
+    const std::vector<int16_t> zero(100, 0);
+    for (const auto instructionSet : {InstructionSet::Scalar,
+                                      InstructionSet::Sse2,
+                                      InstructionSet::Avx2,
+                                      InstructionSet::Neon})
+    {
+      if (IsSupported(instructionSet))
+      {
+        WithInstructionSet(instructionSet, [&](auto tag) {
+          using Isa = decltype(tag);
+          CHECK(Isa::isSilent(100, unsigned16.data(), 0));
+          CHECK(Isa::isSilent(100, unsigned32.data(), 0));
+          CHECK(Isa::isSilent(100, negativeZero.data(), 0));
+          CHECK(Isa::isSilent(100, zero.data(), 0));
+          CHECK(Isa::isSilent(0, zero.data(), 0));
+        });
+      }
+    }
+  }
+}
+
+TEST_CASE("Float Silence Checks At The Limits", "[gate]")
+{
+  // Long enough for the vector loops
+  const auto check = [](const float value, const int16_t threshold) {
+    const std::vector<float> samples(64, value);
+    const auto expected = isa::Scalar::isSilent(64, samples.data(), threshold);
+    for (const auto instructionSet :
+         {InstructionSet::Sse2, InstructionSet::Avx2, InstructionSet::Neon})
+    {
+      if (IsSupported(instructionSet))
+      {
+        WithInstructionSet(instructionSet, [&](auto tag) {
+          CHECK(decltype(tag)::isSilent(64, samples.data(), threshold) == expected);
+        });
+      }
+    }
+    return expected;
+  };
+
+  // Positive samples saturate to the largest threshold
+  CHECK(check(1.0f, 32767));
+  CHECK(check(2.0f, 32767));
+  CHECK_FALSE(check(-1.0f, 32767));
+  CHECK_FALSE(check(std::nanf(""), 100));
+  CHECK(check(100.99f / 32767.0f, 100));
+  CHECK_FALSE(check(101.0f / 32767.0f, 100));
+  CHECK(check(-100.99f / 32768.0f, 100));
+  CHECK_FALSE(check(-101.0f / 32768.0f, 100));
+}
+
+TEST_CASE("Silence Check Kernels", "[gate][kernels]")
+{
+  SECTION("Channels the map doesn't read are ignored", "[gate][kernels]")
+  {
+    // Four mono buffers, only the first is loud
+    std::vector<std::vector<float>> channels(4, std::vector<float>(kNumFrames, 0.0f));
+    channels[0][kNumFrames - 1] = 0.5f;
+    InputBuffers input;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+      input.buffers[i] = {channels[i].data(), 1};
+    }
+    input.numBuffers = 4;
+
+    ConversionState state;
+    state.format = makeFormat(LayoutOf<float>(), 4, false);
+    const uint32_t quiet[] = {1, 3};
+    state.requestedMap = MakeChannelSelection(quiet, 2);
+    ConfigureConversion(state, InstructionSet::Scalar);
+    const auto isSilent = SelectSilenceCheck(state, BestInstructionSet());
+    REQUIRE(isSilent != nullptr);
+    CHECK(isSilent(state, kNumFrames, input));
+
+    const uint32_t loud[] = {3, 0};
+    state.requestedMap = MakeChannelSelection(loud, 2);
+    ConfigureConversion(state, InstructionSet::Scalar);
+    CHECK_FALSE(isSilent(state, kNumFrames, input));
+  }
+
+  SECTION("Unread channels of interleaved input are ignored", "[gate][kernels]")
+  {
+    // Eight interleaved channels, only channel 5 is loud
+    std::vector<float> samples(8 * kNumFrames, 0.0f);
+    samples[8 * (kNumFrames - 1) + 5] = 0.5f;
+    InputBuffers input;
+    input.buffers[0] = {samples.data(), 8};
+    input.numBuffers = 1;
+
+    ConversionState state;
+    state.format = makeFormat(LayoutOf<float>(), 8, true);
+    ConfigureConversion(state, InstructionSet::Scalar);
+    const auto isSilent = SelectSilenceCheck(state, BestInstructionSet());
+    REQUIRE(isSilent != nullptr);
+    // The default map reads channels 0 and 1
+    CHECK(isSilent(state, kNumFrames, input));
+
+    const uint32_t quiet[] = {0, 1};
+    state.requestedMap = MakeChannelSelection(quiet, 2);
+    ConfigureConversion(state, InstructionSet::Scalar);
+    CHECK(isSilent(state, kNumFrames, input));
+
+    const uint32_t loud[] = {0, 5};
+    state.requestedMap = MakeChannelSelection(loud, 2);
+    ConfigureConversion(state, InstructionSet::Scalar);
+    CHECK_FALSE(isSilent(state, kNumFrames, input));
+  }
+
+  SECTION("Samples padded to a wider container", "[gate][kernels]")
+  {
+    for (const auto alignment : {SampleAlignment::High, SampleAlignment::Low})
+    {
+      ConversionState state;
+      state.format = makeFormat({16, 4, 0, SampleEncoding::SignedInteger,
+                                 ByteOrder::LittleEndian, alignment},
+                                2, true);
+      ConfigureConversion(state, InstructionSet::Scalar);
+      const auto isSilent = SelectSilenceCheck(state, BestInstructionSet());
+      REQUIRE(isSilent != nullptr);
+
+      // Only the padding is non-zero
+      std::vector<uint8_t> bytes(2 * kNumFrames * 4, 0xAB);
+      for (uint32_t sample = 0; sample < 2 * kNumFrames; ++sample)
+      {
+        bytes[sample * 4 + state.sampleOffset] = 0;
+        bytes[sample * 4 + state.sampleOffset + 1] = 0;
+      }
+      InputBuffers input;
+      input.buffers[0] = {bytes.data(), 2};
+      input.numBuffers = 1;
+      CHECK(isSilent(state, kNumFrames, input));
+
+      bytes[(2 * kNumFrames - 1) * 4 + state.sampleOffset + 1] = 1;
+      CHECK_FALSE(isSilent(state, kNumFrames, input));
+    }
+  }
+
+  SECTION("Unsupported formats have no check", "[gate][kernels]")
+  {
+    ConversionState state;
+    state.format =
+      makeFormat({12, 2, 0, SampleEncoding::SignedInteger, ByteOrder::LittleEndian}, 2, true);
+    CHECK(SelectSilenceCheck(state, InstructionSet::Scalar) == nullptr);
+  }
+}
+
+TEST_CASE("Gating Skips The Resampler", "[gate][kernels]")
+{
+  ConversionState state;
+  state.format = makeFormat(LayoutOf<float>(), 2, true);
+  state.targetSampleRate = 32000;
+  const auto kernel = ConfigureConversion(state, InstructionSet::Scalar);
+  const auto isSilent = SelectSilenceCheck(state, InstructionSet::Scalar);
+  REQUIRE(state.resampler.isActive());
+
+  const std::vector<float> silence(2 * kNumFrames, 0.0f);
+  InputBuffers input;
+  input.buffers[0] = {silence.data(), 2};
+  input.numBuffers = 1;
+
+  // Off gates nothing
+  CHECK_FALSE(GateSilence(state, isSilent, kNumFrames, input));
+
+  state.gate.setParameters(0.0f, kNumFrames, SilenceGateMode::Suppress);
+  ConversionState reference;
+  reference.format = state.format;
+  reference.targetSampleRate = 32000;
+  ConfigureConversion(reference, InstructionSet::Scalar);
+
+  std::vector<int16_t> output(2 * kNumFrames);
+  for (uint32_t i = 0; i < 4; ++i)
+  {
+    const auto numGatedFrames = GateSilence(state, isSilent, kNumFrames, input);
+    const auto numOutputFrames = kernel(reference, kNumFrames, input, output.data());
+    if (i == 0)
+    {
+      // Still within the hold time
+      REQUIRE_FALSE(numGatedFrames);
+      kernel(state, kNumFrames, input, output.data());
+    }
+    else
+    {
+      REQUIRE(numGatedFrames);
+      CHECK(*numGatedFrames == numOutputFrames);
+    }
+    CHECK(state.resampler.nextOutputOffset() == reference.resampler.nextOutputOffset());
+  }
+}
+
+} // namespace ableton::link_kit
@@ -0,0 +1,50 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#include "SingleWriterCounter.hpp"
+#include <ableton/test/CatchWrapper.hpp>
+#include <atomic>
+#include <thread>
+
+namespace ableton::link_kit
+{
+
+TEST_CASE("Single Writer Counter", "[counter]")
+{
+  SECTION("Adds up", "[counter]")
+  {
+    SingleWriterCounter<> counter;
+    CHECK(counter.load() == 0);
+    counter.add(1);
+    counter.add(41);
+    CHECK(counter.load() == 42);
+  }
+
+  SECTION("Readers never see the total go back", "[counter]")
+  {
+    constexpr uint64_t kNumAdds = 100000;
+    SingleWriterCounter<> counter;
+    std::atomic<uint64_t> payload{0};
+
+    std::thread writer([&] {
+      for (uint64_t i = 1; i <= kNumAdds; ++i)
+      {
+        payload.store(i, std::memory_order_relaxed);
+        counter.add(1, std::memory_order_release);
+      }
+    });
+
+    uint64_t last = 0;
+    uint32_t numErrors = 0;
+    while (last < kNumAdds)
+    {
+      const auto total = counter.load(std::memory_order_acquire);
+      // A release add publishes the payload written before it
+      numErrors += total < last || payload.load(std::memory_order_relaxed) < total;
+      last = total;
+    }
+    writer.join();
+    CHECK(numErrors == 0);
+  }
+}
+
+} // namespace ableton::link_kit
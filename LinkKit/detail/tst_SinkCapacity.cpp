@@ -0,0 +1,94 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#include "SinkCapacity.hpp"
+#include "tst_Fixtures.hpp"
+#include <ableton/test/CatchWrapper.hpp>
+#include <vector>
+
+namespace ableton::link_kit
+{
+
+namespace
+{
+
+ConversionKernel configure(ConversionState& state,
+                           const uint32_t numChannels,
+                           const uint32_t targetSampleRate = 0)
+{
+  state.format = makeFormat(LayoutOf<float>(), numChannels, true);
+  state.targetSampleRate = targetSampleRate;
+  return ConfigureConversion(state, BestInstructionSet());
+}
+
+} // namespace
+
+TEST_CASE("Sink Capacity", "[capacity]")
+{
+  ConversionState state;
+
+  SECTION("Sized for the converted channels", "[capacity]")
+  {
+    configure(state, 2);
+    CHECK(MaxNumOutputSamples(state, 512) == 1024);
+    CHECK(SinkCapacity(state, 512) == 1024 * kSinkCapacityHeadroom);
+
+    configure(state, 1);
+    CHECK(MaxNumOutputSamples(state, 512) == 512);
+
+    // Only the first two of many input channels are sent
+    configure(state, 8);
+    CHECK(MaxNumOutputSamples(state, 512) == 1024);
+  }
+
+  SECTION("Sized for the resampled frames", "[capacity]")
+  {
+    configure(state, 2, 24000);
+    REQUIRE(state.resampler.isActive());
+    CHECK(MaxNumOutputSamples(state, 512) >= 512);
+    CHECK(MaxNumOutputSamples(state, 512) <= 2 * 257);
+  }
+
+  // Buffers that fit used to be rejected and larger ones accepted
+  SECTION("Buffers fit up to the capacity", "[capacity]")
+  {
+    configure(state, 2);
+    CHECK(FitsSink(state, 512, 1024));
+    CHECK(FitsSink(state, 256, 1024));
+    CHECK_FALSE(FitsSink(state, 513, 1024));
+    CHECK(FitsSink(state, 4096, SinkCapacity(state, kDefaultMaxNumFrames)));
+    CHECK(FitsSink(state, 8192, SinkCapacity(state, kDefaultMaxNumFrames)));
+    CHECK_FALSE(FitsSink(state, 8193, SinkCapacity(state, kDefaultMaxNumFrames)));
+  }
+
+  SECTION("Capacity saturates", "[capacity]")
+  {
+    configure(state, 2);
+    CHECK(SinkCapacity(state, 0xFFFFFFFF) == 0xFFFFFFFF);
+  }
+
+  SECTION("Conversion stays within the bound", "[capacity]")
+  {
+    constexpr uint32_t kNumFrames = 333;
+    constexpr int16_t kSentinel = 0x5A5A;
+    for (const auto targetSampleRate : {0u, 44100u, 32000u, 24000u})
+    {
+      const auto kernel = configure(state, 2, targetSampleRate);
+      REQUIRE(kernel != nullptr);
+      std::vector<float> input(2 * kNumFrames, 0.5f);
+      InputBuffers buffers;
+      buffers.buffers[0] = {input.data(), 2};
+      buffers.numBuffers = 1;
+
+      const auto numSamples = MaxNumOutputSamples(state, kNumFrames);
+      for (uint32_t i = 0; i < 4; ++i)
+      {
+        std::vector<int16_t> output(numSamples + 16, kSentinel);
+        const auto numOutputFrames = kernel(state, kNumFrames, buffers, output.data());
+        CHECK(2 * numOutputFrames <= numSamples);
+        CHECK(output[numSamples] == kSentinel);
+      }
+    }
+  }
+}
+
+} // namespace ableton::link_kit
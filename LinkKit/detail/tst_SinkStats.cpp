@@ -0,0 +1,98 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#include "SinkCapacity.hpp"
+#include "SinkStats.hpp"
+#include "tst_Fixtures.hpp"
+#include <ableton/test/CatchWrapper.hpp>
+#include <thread>
+#include <vector>
+
+namespace ableton::link_kit
+{
+
+TEST_CASE("Sink Stats", "[stats]")
+{
+  SinkStats stats;
+
+  SECTION("Starts at zero", "[stats]")
+  {
+    for (const auto total : stats.totals())
+    {
+      CHECK(total == 0);
+    }
+  }
+
+  SECTION("Commits count buffers, frames and bytes", "[stats]")
+  {
+    stats.addCommit(true, 256, 2);
+    stats.addCommit(true, 128, 1);
+    stats.addCommit(false, 256, 2);
+    stats.add(SinkStats::kNoBuffer);
+    stats.add(SinkStats::kOversized, 3);
+
+    const auto totals = stats.totals();
+    CHECK(totals[SinkStats::kCommittedBuffers] == 2);
+    CHECK(totals[SinkStats::kFramesSent] == 384);
+    CHECK(totals[SinkStats::kBytesSent] == 1280);
+    CHECK(totals[SinkStats::kFailedCommits] == 1);
+    CHECK(totals[SinkStats::kNoBuffer] == 1);
+    CHECK(totals[SinkStats::kOversized] == 3);
+    CHECK(totals[SinkStats::kUnsupportedFormat] == 0);
+    CHECK(totals[SinkStats::kGated] == 0);
+    CHECK(totals[SinkStats::kNoOutput] == 0);
+  }
+
+  SECTION("Buffers too short for a frame after resampling", "[stats]")
+  {
+    ConversionState state;
+    state.format = makeFormat(LayoutOf<float>(), 2, true);
+    state.targetSampleRate = 24000;
+    const auto kernel = ConfigureConversion(state, BestInstructionSet());
+    REQUIRE(kernel != nullptr);
+    std::vector<float> samples(2, 0.5f);
+    InputBuffers input;
+    input.buffers[0] = {samples.data(), 2};
+    input.numBuffers = 1;
+
+    // Halving the rate yields a frame for every other single frame buffer
+    std::vector<int16_t> output(MaxNumOutputSamples(state, 1));
+    uint32_t numCommitted = 0;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+      numCommitted += stats.addConversion(kernel(state, 1, input, output.data()));
+    }
+    CHECK(numCommitted == 2);
+    CHECK(stats.totals()[SinkStats::kNoOutput] == 2);
+  }
+
+  SECTION("Reading while counting", "[stats]")
+  {
+    constexpr uint64_t kNumBuffers = 100000;
+    std::thread audioThread([&] {
+      for (uint64_t i = 1; i <= kNumBuffers; ++i)
+      {
+        stats.addCommit(true, 64, 2);
+        if (i % 256 == 0)
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    // Totals only grow
+    uint64_t numBuffers = 0;
+    uint32_t numShrunk = 0;
+    while (numBuffers < kNumBuffers)
+    {
+      const auto totals = stats.totals();
+      numShrunk += totals[SinkStats::kCommittedBuffers] < numBuffers;
+      numBuffers = totals[SinkStats::kCommittedBuffers];
+      std::this_thread::yield();
+    }
+    audioThread.join();
+    CHECK(numShrunk == 0);
+    CHECK(stats.totals()[SinkStats::kBytesSent] == kNumBuffers * 256);
+  }
+}
+
+} // namespace ableton::link_kit
@@ -0,0 +1,79 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#include "SpscIndices.hpp"
+#include <ableton/test/CatchWrapper.hpp>
+#include <thread>
+#include <vector>
+
+namespace ableton::link_kit
+{
+
+TEST_CASE("SPSC Indices", "[spsc]")
+{
+  SECTION("Slots are filled and read in order", "[spsc]")
+  {
+    SpscIndices indices(3);
+    CHECK(indices.readSlot() == 3);
+
+    for (uint32_t round = 0; round < 4; ++round)
+    {
+      // Each round starts one slot further
+      const auto first = round % 3;
+      CHECK(indices.writeSlot() == first);
+      indices.commitWrite();
+      CHECK(indices.writeSlot() == (first + 1) % 3);
+      CHECK(indices.readSlot() == first);
+      indices.commitRead();
+      CHECK(indices.readSlot() == 3);
+    }
+  }
+
+  SECTION("Full until a slot is read", "[spsc]")
+  {
+    SpscIndices indices(2);
+    indices.commitWrite();
+    indices.commitWrite();
+    CHECK(indices.writeSlot() == 2);
+    CHECK(indices.readSlot() == 0);
+    indices.commitRead();
+    CHECK(indices.writeSlot() == 0);
+  }
+
+  SECTION("Slot contents are published across threads", "[spsc]")
+  {
+    constexpr uint32_t kNumValues = 100000;
+    SpscIndices indices(4);
+    std::vector<uint32_t> slots(4);
+
+    std::thread producer([&] {
+      for (uint32_t value = 0; value < kNumValues;)
+      {
+        const auto index = indices.writeSlot();
+        if (index == indices.capacity())
+        {
+          std::this_thread::yield();
+          continue;
+        }
+        slots[index] = value++;
+        indices.commitWrite();
+      }
+    });
+
+    uint32_t numOutOfOrder = 0;
+    for (uint32_t expected = 0; expected < kNumValues;)
+    {
+      const auto index = indices.readSlot();
+      if (index == indices.capacity())
+      {
+        std::this_thread::yield();
+        continue;
+      }
+      numOutOfOrder += slots[index] != expected++;
+      indices.commitRead();
+    }
+    producer.join();
+    CHECK(numOutOfOrder == 0);
+  }
+}
+
+} // namespace ableton::link_kit
@@ -0,0 +1,120 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#include "TimingHistogram.hpp"
+#include <ableton/test/CatchWrapper.hpp>
+#include <thread>
+
+namespace ableton::link_kit
+{
+
+TEST_CASE("Timing Histogram", "[timing]")
+{
+  TimingHistogram histogram;
+
+  SECTION("Buckets double in width", "[timing]")
+  {
+    CHECK(TimingHistogram::BucketOf(0) == 0);
+    CHECK(TimingHistogram::BucketOf(1) == 1);
+    CHECK(TimingHistogram::BucketOf(2) == 2);
+    CHECK(TimingHistogram::BucketOf(3) == 2);
+    CHECK(TimingHistogram::BucketOf(1023) == 10);
+    CHECK(TimingHistogram::BucketOf(1024) == 11);
+    CHECK(TimingHistogram::BucketOf(uint64_t{1} << 40) == TimingHistogram::kNumBuckets - 1);
+
+    for (uint32_t i = 0; i + 1 < TimingHistogram::kNumBuckets; ++i)
+    {
+      const auto end = TimingHistogram::BucketEnd(i);
+      CHECK(TimingHistogram::BucketOf(end - 1) == i);
+      CHECK(TimingHistogram::BucketOf(end) == i + 1);
+    }
+  }
+
+  SECTION("Snapshots hold the running totals", "[timing]")
+  {
+    histogram.record(100);
+    histogram.record(120);
+    histogram.record(5000);
+
+    const auto snapshot = histogram.snapshot();
+    CHECK(snapshot.count == 3);
+    CHECK(snapshot.counts[TimingHistogram::BucketOf(100)] == 2);
+    CHECK(snapshot.counts[TimingHistogram::BucketOf(5000)] == 1);
+    CHECK(snapshot.totalNanoseconds == 5220);
+    CHECK(snapshot.maxNanoseconds == 5000);
+
+    histogram.record(10);
+    CHECK(histogram.snapshot().count == 4);
+    CHECK(histogram.snapshot().maxNanoseconds == 5000);
+  }
+
+  SECTION("Quantiles", "[timing]")
+  {
+    CHECK(TimingQuantile(histogram.snapshot(), 0.99) == 0);
+
+    // 990 fast calls and 10 slow outliers
+    for (uint32_t i = 0; i < 990; ++i)
+    {
+      histogram.record(300);
+    }
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+      histogram.record(40000);
+    }
+
+    const auto snapshot = histogram.snapshot();
+    CHECK(TimingQuantile(snapshot, 0.5) == 512);
+    CHECK(TimingQuantile(snapshot, 0.99) == 512);
+    // Clamped to the longest duration rather than the end of its bucket
+    CHECK(TimingQuantile(snapshot, 0.999) == 40000);
+    CHECK(TimingQuantile(snapshot, 1.0) == 40000);
+    CHECK(TimingQuantile(snapshot, 0.0) == 512);
+  }
+
+  SECTION("Scoped timing only records while enabled", "[timing]")
+  {
+    {
+      ScopedTiming timing(histogram);
+    }
+    CHECK(histogram.snapshot().count == 0);
+
+    histogram.setEnabled(true);
+    {
+      ScopedTiming timing(histogram);
+      std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    const auto snapshot = histogram.snapshot();
+    CHECK(snapshot.count == 1);
+    CHECK(snapshot.maxNanoseconds >= 1000000);
+  }
+
+  SECTION("Snapshots while recording", "[timing]")
+  {
+    constexpr uint64_t kNumRecords = 200000;
+    std::thread recorder([&] {
+      for (uint64_t i = 1; i <= kNumRecords; ++i)
+      {
+        histogram.record(i % 4096);
+        if (i % 256 == 0)
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    // Totals only grow
+    uint64_t count = 0;
+    uint32_t numShrunk = 0;
+    while (count < kNumRecords)
+    {
+      const auto snapshot = histogram.snapshot();
+      numShrunk += snapshot.count < count;
+      count = snapshot.count;
+      std::this_thread::yield();
+    }
+    recorder.join();
+    CHECK(numShrunk == 0);
+    CHECK(histogram.snapshot().maxNanoseconds == 4095);
+  }
+}
+
+} // namespace ableton::link_kit
@@ -0,0 +1,104 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#include "TripleBuffer.hpp"
+#include <ableton/test/CatchWrapper.hpp>
+#include <array>
+#include <thread>
+
+namespace ableton::link_kit
+{
+
+namespace
+{
+
+// Every field follows from the version, so a torn read shows
+struct State
+{
+  uint64_t version;
+  std::array<uint64_t, 15> fields;
+};
+
+State makeState(const uint64_t version)
+{
+  State state{version, {}};
+  for (size_t i = 0; i < state.fields.size(); ++i)
+  {
+    state.fields[i] = version * (i + 2);
+  }
+  return state;
+}
+
+bool isConsistent(const State& state)
+{
+  return state.fields == makeState(state.version).fields;
+}
+
+} // namespace
+
+TEST_CASE("Triple Buffer", "[triplebuffer]")
+{
+  SECTION("Reads the latest state", "[triplebuffer]")
+  {
+    TripleBuffer buffer(sizeof(State));
+    State state = makeState(5);
+    CHECK_FALSE(buffer.read(&state));
+    CHECK(state.version == 0);
+
+    for (uint64_t version = 1; version <= 3; ++version)
+    {
+      const auto written = makeState(version);
+      buffer.write(&written);
+    }
+    CHECK(buffer.read(&state));
+    CHECK(state.version == 3);
+    CHECK(isConsistent(state));
+
+    // The state stays readable without being new
+    state = makeState(0);
+    CHECK_FALSE(buffer.read(&state));
+    CHECK(state.version == 3);
+
+    const auto written = makeState(4);
+    buffer.write(&written);
+    CHECK(buffer.read(&state));
+    CHECK(state.version == 4);
+  }
+
+  SECTION("Concurrent writes and reads", "[triplebuffer]")
+  {
+    constexpr uint64_t kNumVersions = 100000;
+    TripleBuffer buffer(sizeof(State));
+    std::thread writer([&] {
+      for (uint64_t version = 1; version <= kNumVersions; ++version)
+      {
+        const auto state = makeState(version);
+        buffer.write(&state);
+        if (version % 64 == 0)
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    uint32_t numTorn = 0;
+    uint32_t numOutOfOrder = 0;
+    uint64_t version = 0;
+    while (version < kNumVersions)
+    {
+      State state{};
+      const auto isNew = buffer.read(&state);
+      numTorn += !isConsistent(state);
+      numOutOfOrder += isNew ? state.version <= version : state.version != version;
+      version = state.version;
+      if (!isNew)
+      {
+        std::this_thread::yield();
+      }
+    }
+    writer.join();
+    CHECK(numTorn == 0);
+    CHECK(numOutOfOrder == 0);
+  }
+}
+
+} // namespace ableton::link_kit
@@ -0,0 +1,270 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#pragma once
+
+#include <detail/InstructionSet.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ableton::link_kit::benchmark
+{
+
+// Make the compiler assume the memory behind pointer is read, so that stores
+// of measured code aren't optimized away
+inline void KeepAlive(const void* pointer)
+{
+  asm volatile("" : : "r"(pointer) : "memory");
+}
+
+// Hot runs repeat the measured call on the same buffers, so they stay in cache.
+// Cold runs move each call to a random location in arenas much larger than the
+// last level cache.
+enum class Cache
+{
+  Hot,
+  Cold,
+};
+
+inline const char* ToString(const Cache cache)
+{
+  return cache == Cache::Hot ? "hot" : "cold";
+}
+
+inline const char* ToString(const InstructionSet instructionSet)
+{
+  switch (instructionSet)
+  {
+  case InstructionSet::Sse2:
+    return "sse2";
+  case InstructionSet::Avx2:
+    return "avx2";
+  case InstructionSet::Neon:
+    return "neon";
+  default:
+    return "scalar";
+  }
+}
+
+// Describes a measurement: ordered key/value pairs, written to the JSON output
+// as they are and joined to the name of the benchmark
+using Parameters = std::vector<std::pair<std::string, std::string>>;
+
+struct Result
+{
+  std::string name;
+  Parameters parameters;
+  uint32_t numFrames = 0;
+  // Bytes read and written per frame
+  double bytesPerFrame = 0.0;
+  double nsPerFrame = 0.0;
+
+  double gigabytesPerSecond() const
+  {
+    return bytesPerFrame / nsPerFrame;
+  }
+};
+
+struct Options
+{
+  // Only run benchmarks whose name contains this string
+  std::string filter;
+  // Minimum duration of the timed calls of each measurement
+  std::chrono::nanoseconds minDuration = std::chrono::milliseconds{2};
+};
+
+// Runs measurements and collects their results. Calls are timed in batches
+// long enough for the clock resolution, the reported time is the median over
+// all batches, which is robust against interrupts and frequency changes during
+// a run.
+class Suite
+{
+public:
+  // Larger than the last level cache of the machines we care about
+  static constexpr size_t kArenaSize = size_t{128} << 20;
+  static constexpr size_t kAlignment = 64;
+
+  explicit Suite(Options options)
+    : mOptions(std::move(options))
+    , mInput(kArenaSize + kAlignment)
+    , mOutput(kArenaSize + kAlignment)
+  {
+  }
+
+  // Memory the measured calls read from. Benchmarks fill it with valid input
+  // before running, all of it is used by cold runs.
+  uint8_t* input()
+  {
+    return align(mInput.data());
+  }
+
+  // Measure fn(const uint8_t* input, uint8_t* output), which processes numFrames
+  // frames reading inputSize and writing outputSize bytes per call
+  template <typename Fn>
+  void run(const Parameters& parameters,
+           const uint32_t numFrames,
+           const size_t inputSize,
+           const size_t outputSize,
+           const Cache cache,
+           Fn&& fn)
+  {
+    auto name = Name(parameters);
+    name += '/' + std::to_string(numFrames) + '/' + ToString(cache);
+    if (name.find(mOptions.filter) == std::string::npos)
+    {
+      return;
+    }
+
+    const auto slotSize =
+      (std::max(inputSize, outputSize) + kAlignment - 1) / kAlignment * kAlignment;
+    const auto numSlots = cache == Cache::Hot ? size_t{1} : kArenaSize / slotSize;
+    const auto* input = this->input();
+    auto* output = align(mOutput.data());
+    auto call = [&] {
+      const auto offset = numSlots == 1 ? 0 : slotSize * (mRng() % numSlots);
+      fn(input + offset, output + offset);
+      KeepAlive(output + offset);
+    };
+
+    // Warm up and find a batch size long enough for the clock resolution
+    call();
+    uint32_t batchSize = 1;
+    while (time([&] { repeat(batchSize, call); }) < std::chrono::microseconds{20})
+    {
+      batchSize *= 2;
+    }
+
+    std::vector<double> samples;
+    std::chrono::nanoseconds total{0};
+    while (total < mOptions.minDuration || samples.size() < 5)
+    {
+      const auto duration = time([&] { repeat(batchSize, call); });
+      total += duration;
+      samples.push_back(static_cast<double>(duration.count()) / batchSize);
+    }
+
+    std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+    Result result;
+    result.name = std::move(name);
+    result.parameters = parameters;
+    result.parameters.emplace_back("cache", ToString(cache));
+    result.numFrames = numFrames;
+    result.bytesPerFrame = static_cast<double>(inputSize + outputSize) / numFrames;
+    result.nsPerFrame = samples[samples.size() / 2] / numFrames;
+    std::printf("%-64s %10.3f ns/frame %8.2f GB/s\n",
+                result.name.c_str(),
+                result.nsPerFrame,
+                result.gigabytesPerSecond());
+    std::fflush(stdout);
+    mResults.push_back(std::move(result));
+  }
+
+  const std::vector<Result>& results() const
+  {
+    return mResults;
+  }
+
+  static std::string Name(const Parameters& parameters)
+  {
+    std::string name;
+    for (const auto& parameter : parameters)
+    {
+      name += (name.empty() ? "" : "/") + parameter.second;
+    }
+    return name;
+  }
+
+private:
+  static uint8_t* align(uint8_t* pointer)
+  {
+    const auto address = reinterpret_cast<uintptr_t>(pointer);
+    return pointer + (kAlignment - address % kAlignment) % kAlignment;
+  }
+
+  template <typename Fn>
+  static std::chrono::nanoseconds time(Fn&& fn)
+  {
+    const auto begin = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::steady_clock::now() - begin;
+  }
+
+  template <typename Fn>
+  static void repeat(const uint32_t count, Fn& fn)
+  {
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      fn();
+    }
+  }
+
+  Options mOptions;
+  std::vector<Result> mResults;
+  std::vector<uint8_t> mInput;
+  std::vector<uint8_t> mOutput;
+  std::minstd_rand mRng;
+};
+
+// Write one result per line in a stable order, so outputs of two commits can be
+// compared with diff
+inline void WriteJson(std::ostream& out,
+                      const Parameters& context,
+                      const std::vector<Result>& results)
+{
+  out << "{\n  \"context\": {";
+  for (size_t i = 0; i < context.size(); ++i)
+  {
+    out << (i == 0 ? "" : ", ") << '"' << context[i].first << "\": \""
+        << context[i].second << '"';
+  }
+  out << "},\n  \"benchmarks\": [\n";
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    const auto& result = results[i];
+    out << "    {\"name\": \"" << result.name << '"';
+    for (const auto& parameter : result.parameters)
+    {
+      out << ", \"" << parameter.first << "\": \"" << parameter.second << '"';
+    }
+    out << ", \"frames\": " << result.numFrames
+        << ", \"ns_per_frame\": " << result.nsPerFrame
+        << ", \"gb_per_s\": " << result.gigabytesPerSecond() << '}'
+        << (i + 1 == results.size() ? "" : ",") << '\n';
+  }
+  out << "  ]\n}\n";
+}
+
+// Read the ns/frame of each benchmark from a file written by WriteJson
+inline std::map<std::string, double> ReadJson(std::istream& in)
+{
+  std::map<std::string, double> nsPerFrame;
+  const std::string nameKey = "{\"name\": \"";
+  const std::string timeKey = "\"ns_per_frame\": ";
+  std::string line;
+  while (std::getline(in, line))
+  {
+    const auto nameBegin = line.find(nameKey);
+    const auto timeBegin = line.find(timeKey);
+    if (nameBegin == std::string::npos || timeBegin == std::string::npos)
+    {
+      continue;
+    }
+    const auto nameEnd = line.find('"', nameBegin + nameKey.size());
+    std::istringstream time(line.substr(timeBegin + timeKey.size()));
+    double value = 0.0;
+    time >> value;
+    nsPerFrame[line.substr(nameBegin + nameKey.size(), nameEnd - nameBegin - nameKey.size())] =
+      value;
+  }
+  return nsPerFrame;
+}
+
+} // namespace ableton::link_kit::benchmark
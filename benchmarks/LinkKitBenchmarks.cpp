@@ -0,0 +1,128 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+// Usage: LinkKitBenchmarks [--filter <substring>] [--min-time <ms>]
+//                          [--json <file>] [--baseline <file>] [--threshold <ratio>]
+//
+// Writes the results to <file> with --json. With --baseline, compares against
+// the output of an earlier run and fails if any benchmark got slower than the
+// threshold ratio (1.25 by default).
+
+#include "Benchmark.hpp"
+#include <detail/InstructionSet.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace ableton::link_kit::benchmark
+{
+
+void BenchmarkBufferConversion(Suite& suite);
+void BenchmarkMetronome(Suite& suite);
+
+namespace
+{
+
+int Compare(const std::string& baselinePath,
+            const std::vector<Result>& results,
+            const double threshold)
+{
+  std::ifstream file(baselinePath);
+  if (!file)
+  {
+    std::cerr << "Can't read " << baselinePath << "\n";
+    return EXIT_FAILURE;
+  }
+
+  const auto baseline = ReadJson(file);
+  int numRegressions = 0;
+  for (const auto& result : results)
+  {
+    const auto it = baseline.find(result.name);
+    if (it == baseline.end())
+    {
+      continue;
+    }
+    const auto ratio = result.nsPerFrame / it->second;
+    if (ratio > threshold)
+    {
+      std::printf("REGRESSION %-53s %10.3f -> %.3f ns/frame (x%.2f)\n",
+                  result.name.c_str(),
+                  it->second,
+                  result.nsPerFrame,
+                  ratio);
+      ++numRegressions;
+    }
+  }
+  std::printf("%d regressions above x%.2f\n", numRegressions, threshold);
+  return numRegressions == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+} // namespace
+
+} // namespace ableton::link_kit::benchmark
+
+int main(int argc, char** argv)
+{
+  using namespace ableton::link_kit;
+  using namespace ableton::link_kit::benchmark;
+
+  Options options;
+  std::string jsonPath;
+  std::string baselinePath;
+  double threshold = 1.25;
+  for (int i = 1; i + 1 < argc; i += 2)
+  {
+    const std::string value = argv[i + 1];
+    if (std::strcmp(argv[i], "--filter") == 0)
+    {
+      options.filter = value;
+    }
+    else if (std::strcmp(argv[i], "--min-time") == 0)
+    {
+      options.minDuration = std::chrono::milliseconds{std::stoi(value)};
+    }
+    else if (std::strcmp(argv[i], "--json") == 0)
+    {
+      jsonPath = value;
+    }
+    else if (std::strcmp(argv[i], "--baseline") == 0)
+    {
+      baselinePath = value;
+    }
+    else if (std::strcmp(argv[i], "--threshold") == 0)
+    {
+      threshold = std::stod(value);
+    }
+    else
+    {
+      std::cerr << "Unknown option " << argv[i] << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+#if !defined(NDEBUG)
+  std::cerr << "Warning: benchmarks built without NDEBUG\n";
+#endif
+
+  Suite suite(options);
+  BenchmarkBufferConversion(suite);
+  BenchmarkMetronome(suite);
+
+  if (!jsonPath.empty())
+  {
+    std::ofstream file(jsonPath);
+    WriteJson(file,
+              {{"best_isa", ToString(BestInstructionSet())},
+               {"compiler", __VERSION__},
+               {"min_time_ms",
+                std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                 options.minDuration)
+                                 .count())}},
+              suite.results());
+  }
+
+  return baselinePath.empty() ? EXIT_SUCCESS
+                              : Compare(baselinePath, suite.results(), threshold);
+}
@@ -0,0 +1,352 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#include "Benchmark.hpp"
+#include <detail/ExpansionTable.hpp>
+#include <detail/KernelTable.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <random>
+#include <string>
+#include <utility>
+
+namespace ableton::link_kit::benchmark
+{
+
+namespace
+{
+
+// In the order of SampleTypes
+constexpr std::array<const char*, kNumSampleTypes> kSampleTypeNames = {
+  "int16",
+  "uint16",
+  "int16be",
+  "int24packed",
+  "int24low",
+  "int32",
+  "uint32",
+  "fixed8.24",
+  "int32be",
+  "float32",
+  "float32be",
+  "float64",
+};
+
+// Channel layouts as a sink sees them, each picking a different kernel
+struct Layout
+{
+  const char* name;
+  uint32_t numChannels;
+  bool isInterleaved;
+  // Mix all channels to stereo instead of sending the first one or two
+  bool isDownmix;
+  bool isMetered;
+};
+
+constexpr std::array<Layout, 6> kLayouts = {{
+  {"mono", 1, false, false, false},
+  {"stereo-planar", 2, false, false, false},
+  {"stereo-interleaved", 2, true, false, false},
+  {"stereo-metered", 2, true, false, true},
+  {"6ch-interleaved", 6, true, false, false},
+  {"6ch-downmix", 6, true, true, false},
+}};
+
+// ITU 5.1 downmix without LFE, channel order L R C LFE Ls Rs. Row-major,
+// left gains first.
+constexpr std::array<float, 12> kDownmixGains = {1.0f, 0.0f, 0.707f, 0.0f, 0.707f, 0.0f,
+                                                 0.0f, 1.0f, 0.707f, 0.0f, 0.0f,   0.707f};
+
+// Fill the input arena with samples in the audio range
+template <typename T>
+void FillInput(uint8_t* input, const size_t size)
+{
+  std::minstd_rand rng;
+  std::uniform_real_distribution<float> values(-1.0f, 1.0f);
+  const auto numSamples = size / sizeof(T);
+  for (size_t i = 0; i < numSamples; ++i)
+  {
+    T sample;
+    const auto value = values(rng);
+    if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+    {
+      sample = static_cast<T>(value);
+    }
+    else if constexpr (std::is_same_v<T, BigEndian<float>>)
+    {
+      sample = {FromBigEndian(BigEndian<float>{value})};
+    }
+    else
+    {
+      // Random bits cover the whole range of integer formats
+      const auto bits = static_cast<uint64_t>(rng()) << 32 | rng();
+      std::memcpy(&sample, &bits, sizeof(T));
+    }
+    std::memcpy(input + i * sizeof(T), &sample, sizeof(T));
+  }
+}
+
+template <typename T>
+void Run(Suite& suite, const size_t typeIndex)
+{
+  FillInput<T>(suite.input(), Suite::kArenaSize);
+
+  for (const auto instructionSet : {InstructionSet::Scalar,
+                                    InstructionSet::Sse2,
+                                    InstructionSet::Avx2,
+                                    InstructionSet::Neon})
+  {
+    if (!IsSupported(instructionSet))
+    {
+      continue;
+    }
+
+    for (const auto& layout : kLayouts)
+    {
+      ConversionState state;
+      state.format.sample = LayoutOf<T>();
+      state.format.numChannels = layout.numChannels;
+      state.format.isInterleaved = layout.isInterleaved;
+      state.format.sampleRate = 48000.0;
+      if (layout.isDownmix)
+      {
+        state.requestedMap = MakeChannelMatrix(kDownmixGains.data(), 6, 2);
+      }
+      state.meter.setEnabled(layout.isMetered);
+      const auto kernel = ConfigureConversion(state, instructionSet);
+      const auto numOutputChannels = state.map.numOutputChannels;
+      InputBuffers input;
+      input.numBuffers = layout.isInterleaved ? 1 : layout.numChannels;
+
+      for (uint32_t numFrames = 16; numFrames <= 8192; numFrames *= 2)
+      {
+        const auto channelSize = numFrames * sizeof(T);
+        for (const auto cache : {Cache::Hot, Cache::Cold})
+        {
+          suite.run({{"group", "convert"},
+                     {"type", kSampleTypeNames[typeIndex]},
+                     {"layout", layout.name},
+                     {"isa", ToString(instructionSet)}},
+                    numFrames,
+                    layout.numChannels * channelSize,
+                    numOutputChannels * numFrames * sizeof(int16_t),
+                    cache,
+                    [&](const uint8_t* data, uint8_t* output) {
+                      if (layout.isInterleaved)
+                      {
+                        input.buffers[0] = {data, layout.numChannels};
+                      }
+                      else
+                      {
+                        for (uint32_t channel = 0; channel < layout.numChannels; ++channel)
+                        {
+                          input.buffers[channel] = {data + channel * channelSize, 1};
+                        }
+                      }
+                      kernel(state, numFrames, input, reinterpret_cast<int16_t*>(output));
+                    });
+        }
+      }
+    }
+  }
+}
+
+// Fill the input arena with digital silence, the worst case for the silence
+// check since it has to read every sample
+template <typename T>
+void FillSilence(uint8_t* input, const size_t size)
+{
+  T sample{};
+  if constexpr (std::is_same_v<T, uint16_t>)
+  {
+    sample = 0x8000;
+  }
+  else if constexpr (std::is_same_v<T, uint32_t>)
+  {
+    sample = 0x80000000;
+  }
+  const auto numSamples = size / sizeof(T);
+  for (size_t i = 0; i < numSamples; ++i)
+  {
+    std::memcpy(input + i * sizeof(T), &sample, sizeof(T));
+  }
+}
+
+template <typename T>
+void RunSilenceCheck(Suite& suite, const size_t typeIndex)
+{
+  FillSilence<T>(suite.input(), Suite::kArenaSize);
+
+  for (const auto instructionSet : {InstructionSet::Scalar,
+                                    InstructionSet::Sse2,
+                                    InstructionSet::Avx2,
+                                    InstructionSet::Neon})
+  {
+    if (!IsSupported(instructionSet))
+    {
+      continue;
+    }
+
+    ConversionState state;
+    state.format.sample = LayoutOf<T>();
+    state.format.numChannels = 2;
+    state.format.isInterleaved = true;
+    state.format.sampleRate = 48000.0;
+    ConfigureConversion(state, instructionSet);
+    const auto isSilent = SelectSilenceCheck(state, instructionSet);
+    InputBuffers input;
+    input.numBuffers = 1;
+
+    for (uint32_t numFrames = 16; numFrames <= 8192; numFrames *= 2)
+    {
+      for (const auto cache : {Cache::Hot, Cache::Cold})
+      {
+        suite.run({{"group", "gate"},
+                   {"type", kSampleTypeNames[typeIndex]},
+                   {"layout", "stereo-interleaved"},
+                   {"isa", ToString(instructionSet)}},
+                  numFrames,
+                  2 * numFrames * sizeof(T),
+                  0,
+                  cache,
+                  [&](const uint8_t* data, uint8_t* output) {
+                    input.buffers[0] = {data, 2};
+                    *output = isSilent(state, numFrames, input);
+                  });
+      }
+    }
+  }
+}
+
+// Received audio expanded into the output layouts an app plays back from
+template <typename U>
+void RunExpansion(Suite& suite, const char* typeName)
+{
+  FillInput<int16_t>(suite.input(), Suite::kArenaSize);
+
+  for (const auto instructionSet : {InstructionSet::Scalar,
+                                    InstructionSet::Sse2,
+                                    InstructionSet::Avx2,
+                                    InstructionSet::Neon})
+  {
+    if (!IsSupported(instructionSet))
+    {
+      continue;
+    }
+
+    for (const auto& layout : kLayouts)
+    {
+      if (layout.numChannels > 2 || layout.isMetered)
+      {
+        continue;
+      }
+
+      FormatDescriptor format;
+      format.sample = LayoutOf<U>();
+      format.numChannels = layout.numChannels;
+      format.isInterleaved = layout.isInterleaved;
+      format.sampleRate = 48000.0;
+      const auto kernel = SelectExpansionKernel(format, layout.numChannels, instructionSet);
+      OutputBuffers output;
+      output.numBuffers = layout.isInterleaved ? 1 : layout.numChannels;
+
+      for (uint32_t numFrames = 16; numFrames <= 8192; numFrames *= 2)
+      {
+        const auto channelSize = numFrames * sizeof(U);
+        for (const auto cache : {Cache::Hot, Cache::Cold})
+        {
+          suite.run({{"group", "expand"},
+                     {"type", typeName},
+                     {"layout", layout.name},
+                     {"isa", ToString(instructionSet)}},
+                    numFrames,
+                    layout.numChannels * numFrames * sizeof(int16_t),
+                    layout.numChannels * channelSize,
+                    cache,
+                    [&](const uint8_t* data, uint8_t* samples) {
+                      for (uint32_t channel = 0; channel < output.numBuffers; ++channel)
+                      {
+                        output.buffers[channel] = samples + channel * channelSize;
+                      }
+                      kernel(numFrames, reinterpret_cast<const int16_t*>(data), output, 1.0f);
+                    });
+        }
+      }
+    }
+  }
+}
+
+// The multiply-add of the 5.1 downmix alone, on input already gathered into
+// float channels
+void RunDownmix(Suite& suite)
+{
+  FillInput<float>(suite.input(), Suite::kArenaSize);
+
+  for (const auto instructionSet : {InstructionSet::Scalar,
+                                    InstructionSet::Sse2,
+                                    InstructionSet::Avx2,
+                                    InstructionSet::Neon})
+  {
+    if (!IsSupported(instructionSet))
+    {
+      continue;
+    }
+
+    WithInstructionSet(instructionSet, [&](auto tag) {
+      using Isa = decltype(tag);
+      for (uint32_t numFrames = 16; numFrames <= 8192; numFrames *= 2)
+      {
+        const auto channelSize = numFrames * sizeof(float);
+        for (const auto cache : {Cache::Hot, Cache::Cold})
+        {
+          suite.run({{"group", "mix"},
+                     {"type", "float32"},
+                     {"layout", "6ch-downmix"},
+                     {"isa", ToString(instructionSet)}},
+                    numFrames,
+                    6 * channelSize,
+                    2 * channelSize,
+                    cache,
+                    [&](const uint8_t* data, uint8_t* output) {
+                      auto* left = reinterpret_cast<float*>(output);
+                      auto* right = left + numFrames;
+                      std::fill_n(left, 2 * numFrames, 0.0f);
+                      const auto* input = reinterpret_cast<const float*>(data);
+                      for (uint32_t channel = 0; channel < 6; ++channel)
+                      {
+                        Isa::accumulate(2,
+                                        numFrames,
+                                        input + channel * numFrames,
+                                        kDownmixGains[channel],
+                                        kDownmixGains[6 + channel],
+                                        left,
+                                        right);
+                      }
+                    });
+        }
+      }
+    });
+  }
+}
+
+template <size_t... Indices>
+void RunAll(Suite& suite, std::index_sequence<Indices...>)
+{
+  (Run<SampleTypeAt<Indices>>(suite, Indices), ...);
+  (RunSilenceCheck<SampleTypeAt<Indices>>(suite, Indices), ...);
+  RunExpansion<float>(suite, "float32");
+  RunExpansion<int32_t>(suite, "int32");
+  RunDownmix(suite);
+}
+
+} // namespace
+
+// Every sample type through every kernel a sink can select, and through the
+// silence check, plus received audio through the expansion kernels and the
+// downmix multiply-add, for each instruction set supported by the CPU
+void BenchmarkBufferConversion(Suite& suite)
+{
+  RunAll(suite, std::make_index_sequence<kNumSampleTypes>{});
+}
+
+} // namespace ableton::link_kit::benchmark
@@ -0,0 +1,137 @@
+// Copyright: 2026, Ableton AG, Berlin. All rights reserved.
+
+#include "Benchmark.hpp"
+#include <detail/Metronome.hpp>
+#include <cmath>
+#include <cstdint>
+
+namespace ableton::link_kit::benchmark
+{
+
+namespace
+{
+
+constexpr double kSampleRate = 48000.0;
+constexpr double kTempo = 120.0;
+constexpr double kQuantum = 4.0;
+// Host clock of recent iOS devices
+constexpr double kTicksPerSecond = 24e6;
+
+// Stands in for a captured session state behind the C API: every query
+// converts host ticks to microseconds and evaluates the timeline, out of line
+// like a call into the library
+struct SessionState
+{
+  double beatsAtOrigin = 0.0;
+  uint64_t originTicks = 0;
+};
+
+// The timeline starts at beat zero, so the quantum doesn't shift the beats
+[[gnu::noinline]] double BeatAtTime(const SessionState& state,
+                                    const uint64_t hostTime,
+                                    [[maybe_unused]] const double quantum)
+{
+  const auto micros = std::llround(
+    static_cast<double>(static_cast<int64_t>(hostTime - state.originTicks)) * 1e6
+    / kTicksPerSecond);
+  return state.beatsAtOrigin + static_cast<double>(micros) * kTempo / 60e6;
+}
+
+[[gnu::noinline]] double PhaseAtTime(const SessionState& state,
+                                     const uint64_t hostTime,
+                                     const double quantum)
+{
+  return PhaseOf(BeatAtTime(state, hostTime, quantum), quantum);
+}
+
+// renderMetronomeIntoBuffer of LinkHut's AudioEngine.m, writing floats
+void RenderPerSample(const SessionState& state,
+                     const uint64_t beginHostTime,
+                     const uint32_t numFrames,
+                     uint64_t& timeAtLastClick,
+                     float* buffer)
+{
+  const auto hostTicksPerSample = kTicksPerSecond / kSampleRate;
+  for (uint32_t i = 0; i < numFrames; ++i)
+  {
+    double amplitude = 0.0;
+    const uint64_t hostTime = beginHostTime + std::llround(i * hostTicksPerSample);
+    const uint64_t lastSampleHostTime = hostTime - std::llround(hostTicksPerSample);
+    if (BeatAtTime(state, hostTime, kQuantum) >= 0.0)
+    {
+      if (PhaseAtTime(state, hostTime, 1) < PhaseAtTime(state, lastSampleHostTime, 1))
+      {
+        timeAtLastClick = hostTime;
+      }
+      const double secondsAfterClick = (hostTime - timeAtLastClick) / kTicksPerSecond;
+      if (secondsAfterClick < Metronome::kClickDuration)
+      {
+        const double freq = std::floor(PhaseAtTime(state, hostTime, kQuantum)) == 0
+                              ? Metronome::kHighTone
+                              : Metronome::kLowTone;
+        amplitude = std::cos(2 * M_PI * secondsAfterClick * freq)
+                    * (1 - std::sin(5 * M_PI * secondsAfterClick));
+      }
+    }
+    buffer[i] = static_cast<float>(amplitude);
+  }
+}
+
+} // namespace
+
+// The LinkHut metronome evaluating the timeline for every sample, against
+// wavetable clicks at the beats found per buffer. Each call renders the next
+// buffer of a running transport, so the average covers clicks and the silence
+// between them.
+void BenchmarkMetronome(Suite& suite)
+{
+  const auto ticksPerFrame = kTicksPerSecond / kSampleRate;
+  for (uint32_t numFrames = 64; numFrames <= 4096; numFrames *= 4)
+  {
+    {
+      SessionState state;
+      uint64_t timeAtLastClick = 0;
+      uint64_t frame = 0;
+      suite.run({{"group", "metronome"}, {"renderer", "per-sample"}},
+                numFrames,
+                0,
+                numFrames * sizeof(float),
+                Cache::Hot,
+                [&](const uint8_t*, uint8_t* output) {
+                  RenderPerSample(state,
+                                  std::llround(frame * ticksPerFrame),
+                                  numFrames,
+                                  timeAtLastClick,
+                                  reinterpret_cast<float*>(output));
+                  frame += numFrames;
+                });
+    }
+
+    {
+      SessionState state;
+      Metronome metronome(kSampleRate);
+      uint64_t frame = 0;
+      suite.run({{"group", "metronome"}, {"renderer", "wavetable"}},
+                numFrames,
+                0,
+                numFrames * sizeof(float),
+                Cache::Hot,
+                [&](const uint8_t*, uint8_t* output) {
+                  // Like a callback building its timeline from the session state
+                  const auto hostTime = static_cast<uint64_t>(std::llround(frame * ticksPerFrame));
+                  const auto timeline = MakeBufferTimeline(BeatAtTime(state, hostTime, kQuantum),
+                                                           kTempo,
+                                                           hostTime,
+                                                           kTicksPerSecond,
+                                                           kSampleRate,
+                                                           kQuantum);
+                  auto* samples = reinterpret_cast<float*>(output);
+                  std::fill_n(samples, numFrames, 0.0f);
+                  metronome.mix(timeline, numFrames, samples);
+                  frame += numFrames;
+                });
+    }
+  }
+}
+
+} // namespace ableton::link_kit::benchmark
@@ -5,17 +5,29 @@
 #include <libkern/OSAtomic.h>
 #include <mach/mach_time.h>
 #include "AudioEngine.h"
-#include <os/lock.h>
 #include "ABLLinkUtils.h"
 
 #define INVALID_BEAT_TIME DBL_MIN
 #define INVALID_BPM DBL_MIN
 
-static struct os_unfair_lock_s lock;
+/*
+ * Commands sent from the main thread to the audio thread.
+ */
+typedef enum {
+    ProposeTempoCommand,
+    SetQuantumCommand,
+    RequestStartCommand,
+    RequestStopCommand
+} CommandType;
+
+typedef struct {
+    CommandType type;
+    Float64 value;
+} Command;
 
 /*
- * Structure that stores engine-related data that can be changed from
- * the main thread.
+ * Structure that stores engine-related data, updated by the audio thread
+ * from the commands and state sent by other threads.
  */
 typedef struct {
     UInt64 outputLatency; // Hardware output latency in HostTime
@@ -36,10 +48,12 @@ typedef struct {
     Float64 sampleRate;
     // Shared between threads. Only write when engine not running.
     Float64 secondsToHostTime;
-    // Shared between threads. Written by the main thread and only
-    // read by the audio thread when doing so will not block.
-    EngineData sharedEngineData;
-    // Copy of sharedEngineData owned by audio thread.
+    // Commands pushed by the main thread and popped by the audio thread.
+    ABLLinkCommandQueueRef commands;
+    // Hardware output latency in HostTime. Written when the audio route
+    // changes and read by the audio thread.
+    ABLLinkStateSlotRef outputLatency;
+    // Engine data owned by audio thread.
     EngineData localEngineData;
     // Owned by audio thread
     UInt64 timeAtLastClick;
@@ -48,8 +62,9 @@ typedef struct {
 } LinkData;
 
 /*
- * Pull data from the main thread to the audio thread if lock can be
- * obtained. Otherwise, just use the local copy of the data.
+ * Pull data from the main thread to the audio thread. Neither the
+ * queue nor the slot block, so every change sent before this buffer
+ * is applied to it.
  */
 static void pullEngineData(LinkData* linkData) {
     // Always reset the signaling members to their default state
@@ -58,29 +73,25 @@ static void pullEngineData(LinkData* linkData) {
     linkData->localEngineData.requestStart = NO;
     linkData->localEngineData.requestStop = NO;
 
-    // Attempt to grab the lock guarding the shared engine data but
-    // don't block if we can't get it.
-    if (os_unfair_lock_trylock(&lock)) {
-        // Copy non-signaling members to the local thread cache
-        linkData->localEngineData.outputLatency =
-          linkData->sharedEngineData.outputLatency;
-        linkData->localEngineData.quantum = linkData->sharedEngineData.quantum;
-
-        // Copy signaling members directly to the output and reset
-        linkData->localEngineData.resetToBeatTime = linkData->sharedEngineData.resetToBeatTime;
-        linkData->sharedEngineData.resetToBeatTime = INVALID_BEAT_TIME;
-
-        linkData->localEngineData.requestStart = linkData->sharedEngineData.requestStart;
-        linkData->sharedEngineData.requestStart = NO;
-
-        linkData->localEngineData.requestStop = linkData->sharedEngineData.requestStop;
-        linkData->sharedEngineData.requestStop = NO;
-
-        linkData->localEngineData.proposeBpm = linkData->sharedEngineData.proposeBpm;
-        linkData->sharedEngineData.proposeBpm = INVALID_BPM;
-        os_unfair_lock_unlock(&lock);
+    ABLLinkStateSlotRead(linkData->outputLatency, &linkData->localEngineData.outputLatency);
+
+    Command command;
+    while (ABLLinkCommandQueuePop(linkData->commands, &command)) {
+        switch (command.type) {
+            case ProposeTempoCommand:
+                linkData->localEngineData.proposeBpm = command.value;
+                break;
+            case SetQuantumCommand:
+                linkData->localEngineData.quantum = command.value;
+                break;
+            case RequestStartCommand:
+                linkData->localEngineData.requestStart = YES;
+                break;
+            case RequestStopCommand:
+                linkData->localEngineData.requestStop = YES;
+                break;
+        }
     }
-
 }
 /*
  * Render a metronome sound into the given buffer according to the
@@ -245,31 +256,30 @@ static OSStatus audioCallback(
 @implementation AudioEngine
 
 # pragma mark - Transport
-// Update _linkData.sharedEngineData so that the audio thread can receive the new values
-// when calling pullEngineData
+// Send commands to the audio thread, which applies them when calling
+// pullEngineData
+
+- (void)sendCommand:(CommandType)type value:(Float64)value {
+    const Command command = {type, value};
+    if (!ABLLinkCommandQueuePush(_linkData.commands, &command)) {
+        NSLog(@"Audio thread isn't keeping up, dropped command %d", (int)type);
+    }
+}
 
 - (void)proposeTempo:(Float64)bpm {
-    os_unfair_lock_lock(&lock);
-    _linkData.sharedEngineData.proposeBpm = bpm;
-    os_unfair_lock_unlock(&lock);
+    [self sendCommand:ProposeTempoCommand value:bpm];
 }
 
 - (void)setQuantum:(Float64)quantum {
-    os_unfair_lock_lock(&lock);
-    _linkData.sharedEngineData.quantum = quantum;
-    os_unfair_lock_unlock(&lock);
+    [self sendCommand:SetQuantumCommand value:quantum];
 }
 
 - (void)requestTransportStart {
-    os_unfair_lock_lock(&lock);
-    _linkData.sharedEngineData.requestStart = YES;
-    os_unfair_lock_unlock(&lock);
+    [self sendCommand:RequestStartCommand value:0];
 }
 
 - (void)requestTransportStop {
-    os_unfair_lock_lock(&lock);
-    _linkData.sharedEngineData.requestStop = YES;
-    os_unfair_lock_unlock(&lock);
+    [self sendCommand:RequestStopCommand value:0];
 }
 
 - (ABLLinkRef)linkRef {
@@ -281,6 +291,12 @@ static OSStatus audioCallback(
     UInt32 dataSize = sizeof(asbd);
     AudioUnitGetProperty(_ioUnit, kAudioUnitProperty_StreamFormat, kAudioUnitScope_Input, 0, &asbd, &dataSize);
     ABLLinkSetPropertiesFromASBD(_linkData.ablLinkAudioSink, &asbd);
+
+    UInt32 maxFramesPerSlice = 0;
+    dataSize = sizeof(maxFramesPerSlice);
+    if (AudioUnitGetProperty(_ioUnit, kAudioUnitProperty_MaximumFramesPerSlice, kAudioUnitScope_Global, 0, &maxFramesPerSlice, &dataSize) == noErr) {
+        ABLLinkAudioSinkSetMaxNumFrames(_linkData.ablLinkAudioSink, maxFramesPerSlice);
+    }
 }
 
 # pragma mark - Handle AVAudioSession changes
@@ -288,9 +304,7 @@ static OSStatus audioCallback(
 #pragma unused(notification)
     const UInt64 outputLatency =
         _linkData.secondsToHostTime * [AVAudioSession sharedInstance].outputLatency;
-    os_unfair_lock_lock(&lock);
-    _linkData.sharedEngineData.outputLatency = outputLatency;
-    os_unfair_lock_unlock(&lock);
+    ABLLinkStateSlotWrite(_linkData.outputLatency, &outputLatency);
 }
 
 static void StreamFormatCallback(
@@ -363,6 +377,8 @@ _Pragma("clang diagnostic pop")
                                                   object:[AVAudioSession sharedInstance]];
     ABLLinkAudioSinkDelete(_linkData.ablLinkAudioSink);
     ABLLinkDelete(_linkData.ablLink);
+    ABLLinkCommandQueueDelete(_linkData.commands);
+    ABLLinkStateSlotDelete(_linkData.outputLatency);
 }
 
 # pragma mark - start and stop engine
@@ -402,14 +418,16 @@ _Pragma("clang diagnostic pop")
     _linkData.ablLinkAudioSink = ABLLinkAudioSinkNew(_linkData.ablLink, "metro", 8192);
     _linkData.sampleRate = [AVAudioSession sharedInstance].sampleRate;
     _linkData.secondsToHostTime = (1.0e9 * timeInfo.denom) / (Float64)timeInfo.numer;
-    _linkData.sharedEngineData.outputLatency =
+    _linkData.commands = ABLLinkCommandQueueNew(sizeof(Command), 64);
+    _linkData.outputLatency = ABLLinkStateSlotNew(sizeof(UInt64));
+    _linkData.localEngineData.outputLatency =
         _linkData.secondsToHostTime * [AVAudioSession sharedInstance].outputLatency;
-    _linkData.sharedEngineData.resetToBeatTime = INVALID_BEAT_TIME;
-    _linkData.sharedEngineData.proposeBpm = INVALID_BPM;
-    _linkData.sharedEngineData.requestStart = NO;
-    _linkData.sharedEngineData.requestStop = NO;
-    _linkData.sharedEngineData.quantum = 4; // quantize to 4 beats
-    _linkData.localEngineData = _linkData.sharedEngineData;
+    ABLLinkStateSlotWrite(_linkData.outputLatency, &_linkData.localEngineData.outputLatency);
+    _linkData.localEngineData.resetToBeatTime = INVALID_BEAT_TIME;
+    _linkData.localEngineData.proposeBpm = INVALID_BPM;
+    _linkData.localEngineData.requestStart = NO;
+    _linkData.localEngineData.requestStop = NO;
+    _linkData.localEngineData.quantum = 4; // quantize to 4 beats
     _linkData.timeAtLastClick = 0;
 }
 